@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""
+Converts a PBM or PNG image into a C array for ssd1306_draw_bitmap() or ssd1306_draw_bitmap_rle().
+
+    ./bitmap2c.py logo.png                  # PackBits-compressed, array named after the file
+    ./bitmap2c.py -r -n icon icon.pbm       # raw page-ordered bytes
+    ./bitmap2c.py -t 100 -i photo.png       # custom threshold, inverted
+
+Dark pixels become lit pixels (set bits), so artwork drawn black on white shows up as drawn;
+use -i for images that are already light on dark. Transparent PNG pixels are never lit.
+
+Only the standard library is used: PBM (P1/P4) and PNG (non-interlaced, any color type,
+bit depths 1-8, and 16) are decoded here.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+
+def read_pbm(data):
+    """Returns (width, height, rows of booleans, True = ink) for P1 and P4 files."""
+    tokens = []
+    pos = 0
+    magic = data[:2]
+    pos = 2
+    while len(tokens) < 2:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            while data[pos:pos + 1] not in (b"\n", b""):
+                pos += 1
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(int(data[start:pos]))
+    width, height = tokens
+
+    if magic == b"P4":
+        pos += 1
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            line = data[pos + y * stride:pos + (y + 1) * stride]
+            rows.append([bool(line[x // 8] & (0x80 >> (x % 8))) for x in range(width)])
+        return width, height, rows
+
+    if magic == b"P1":
+        bits = [c == ord("1") for c in re.sub(rb"#[^\n]*", b"", data[pos:]) if c in b"01"]
+        return width, height, [bits[y * width:(y + 1) * width] for y in range(height)]
+
+    raise ValueError("not a PBM file")
+
+
+def read_png(data, threshold):
+    """Returns (width, height, rows of booleans, True = dark and opaque)."""
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG file")
+
+    pos = 8
+    idat = b""
+    palette = []
+    trns = b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    if interlace:
+        raise ValueError("interlaced PNG files are not supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    bits_per_pixel = channels * depth
+    stride = (width * bits_per_pixel + 7) // 8
+    bpp = max(1, bits_per_pixel // 8)
+    raw = zlib.decompress(idat)
+
+    # Undo the per-line filters
+    lines = []
+    prev = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        lines.append(line)
+        prev = line
+
+    def samples(line):
+        if depth == 8:
+            return list(line)
+        if depth == 16:
+            return [line[i] for i in range(0, len(line), 2)]
+        per_byte = 8 // depth
+        mask = (1 << depth) - 1
+        return [(line[i // per_byte] >> (8 - depth * (i % per_byte + 1))) & mask
+                for i in range(len(line) * per_byte)]
+
+    scale = 255 // ((1 << depth) - 1) if depth < 8 else 1
+    rows = []
+    for line in lines:
+        s = samples(line)
+        row = []
+        for x in range(width):
+            px = s[x * channels:(x + 1) * channels]
+            alpha = 255
+            if color_type == 3:
+                r, g, b = palette[px[0]]
+                alpha = trns[px[0]] if px[0] < len(trns) else 255
+            elif color_type in (0, 4):
+                r = g = b = px[0] * scale
+                if color_type == 4:
+                    alpha = px[1]
+            else:
+                r, g, b = px[0], px[1], px[2]
+                if color_type == 6:
+                    alpha = px[3]
+            luma = (299 * r + 587 * g + 114 * b) // 1000
+            row.append(alpha >= 128 and luma < threshold)
+        rows.append(row)
+    return width, height, rows
+
+
+def to_pages(width, height, rows):
+    """Packs pixel rows into the display layout: pages of width bytes, bit 0 on top."""
+    out = bytearray(width * ((height + 7) // 8))
+    for y in range(height):
+        for x in range(width):
+            if rows[y][x]:
+                out[(y // 8) * width + x] |= 1 << (y % 8)
+    return out
+
+
+def packbits(data):
+    """PackBits as decoded by ssd1306_draw_bitmap_rle()."""
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+            del literal[:128]
+
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        # A run of two only pays off between other runs; inside literals it costs a header
+        if run >= 3 or (run == 2 and not literal):
+            flush_literal()
+            out.append(257 - run)
+            out.append(data[i])
+            i += run
+        else:
+            literal.extend(data[i:i + run])
+            i += run
+    flush_literal()
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a PBM or PNG image into a C array for the SSD1306 driver.")
+    parser.add_argument("image")
+    parser.add_argument("-n", "--name", help="array name (default: derived from the file name)")
+    parser.add_argument("-r", "--raw", action="store_true", help="emit raw bytes for ssd1306_draw_bitmap()")
+    parser.add_argument("-t", "--threshold", type=int, default=128, help="PNG luminance below which a pixel is lit (default 128)")
+    parser.add_argument("-i", "--invert", action="store_true", help="light pixels are lit instead of dark ones")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        data = f.read()
+    if data[:2] in (b"P1", b"P4"):
+        width, height, rows = read_pbm(data)
+    else:
+        width, height, rows = read_png(data, args.threshold)
+
+    if args.invert:
+        rows = [[not px for px in row] for row in rows]
+    if width > 128 or height > 64:
+        print(f"warning: {width}x{height} is larger than the panel", file=sys.stderr)
+
+    name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.image))[0]).lower()
+    pages = to_pages(width, height, rows)
+    body = pages if args.raw else packbits(pages)
+    macro = name.upper()
+
+    lines = [
+        f"// {os.path.basename(args.image)}: {width}x{height}, "
+        + (f"{len(body)} bytes raw" if args.raw else f"{len(pages)} bytes packed into {len(body)}"),
+        f"// Draw with " + (f"ssd1306_draw_bitmap(x, y, {name}, {macro}_WIDTH, {macro}_HEIGHT, COLOR_WHITE)" if args.raw else
+                            f"ssd1306_draw_bitmap_rle(x, y, {name}, {macro}_SIZE, {macro}_WIDTH, {macro}_HEIGHT, COLOR_WHITE)"),
+        f"#define {macro}_WIDTH  {width}",
+        f"#define {macro}_HEIGHT {height}",
+        f"#define {macro}_SIZE   {len(body)}",
+        "",
+        f"static const uint8_t {name}[{macro}_SIZE] = {{",
+    ]
+    for i in range(0, len(body), 16):
+        lines.append("    " + " ".join(f"0x{b:02X}," for b in body[i:i + 16]))
+    lines.append("};")
+
+    text = "\n".join(lines) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
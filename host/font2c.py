@@ -0,0 +1,414 @@
+#!/usr/bin/env python3
+"""
+Converts a BDF bitmap font or a TrueType outline font into an ssd1306_font_t.
+
+    ./font2c.py -n font_terminus12 ter-u12n.bdf          # bitmap font, as designed
+    ./font2c.py -n font_sans16 -s 16 DejaVuSans.ttf      # outlines rendered at 16 px per em
+    ./font2c.py -s 24 -r 32-58 DejaVuSans-Bold.ttf       # only ' ' to ':' (digits and punctuation)
+
+Glyph bitmaps are written in the display's page layout (like ssd1306_draw_bitmap()), cropped to
+their ink, so drawing a glyph is a byte blit. The output is a C file defining one const
+ssd1306_font_t; declare it with `extern const ssd1306_font_t name;` where it is used.
+
+TrueType outlines are rasterized here without hinting (4x4 samples per pixel, lit at half
+coverage), so only the standard library is needed. Sizes from about 12 px up look best.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+
+# --- BDF ---
+
+def read_bdf(path, first, last):
+    """Returns (ascent, descent, {code: (advance, x_offset, y_top, rows)}) where y_top is above the baseline."""
+    glyphs = {}
+    ascent = descent = None
+    with open(path, encoding="latin-1") as f:
+        lines = iter(f.read().splitlines())
+
+    for line in lines:
+        key, _, value = line.partition(" ")
+        if key == "FONT_ASCENT":
+            ascent = int(value)
+        elif key == "FONT_DESCENT":
+            descent = int(value)
+        elif key == "STARTCHAR":
+            code = advance = None
+            box = (0, 0, 0, 0)
+            for line in lines:
+                key, _, value = line.partition(" ")
+                if key == "ENCODING":
+                    code = int(value.split()[0])
+                elif key == "DWIDTH":
+                    advance = int(value.split()[0])
+                elif key == "BBX":
+                    box = tuple(int(v) for v in value.split())
+                elif key == "BITMAP":
+                    w, h, xo, yo = box
+                    rows = []
+                    for _ in range(h):
+                        bits = int(next(lines), 16)
+                        digits = (w + 7) // 8 * 8
+                        rows.append([bool(bits & (1 << (digits - 1 - x))) for x in range(w)])
+                    if code is not None and first <= code <= last:
+                        glyphs[code] = (advance if advance is not None else w, xo, yo + h, rows)
+                elif key == "ENDCHAR":
+                    break
+
+    if ascent is None or descent is None:
+        raise ValueError("BDF file without FONT_ASCENT/FONT_DESCENT")
+    return ascent, descent, glyphs
+
+
+# --- TrueType ---
+
+class TrueType:
+    def __init__(self, data):
+        self.data = data
+        num_tables = struct.unpack(">H", data[4:6])[0]
+        self.tables = {}
+        for i in range(num_tables):
+            tag, _, offset, length = struct.unpack(">4sIII", data[12 + 16 * i:28 + 16 * i])
+            self.tables[tag.decode("latin-1")] = (offset, length)
+
+        head = self.table("head")
+        self.units_per_em = struct.unpack(">H", head[18:20])[0]
+        self.long_loca = struct.unpack(">h", head[50:52])[0] == 1
+
+        hhea = self.table("hhea")
+        self.ascender, self.descender, self.line_gap = struct.unpack(">hhh", hhea[4:10])
+        self.num_hmetrics = struct.unpack(">H", hhea[34:36])[0]
+
+        self.hmtx = self.table("hmtx")
+        self.loca = self.table("loca")
+        self.glyf = self.table("glyf")
+        self.cmap = self.read_cmap()
+
+    def table(self, tag):
+        offset, length = self.tables[tag]
+        return self.data[offset:offset + length]
+
+    def read_cmap(self):
+        cmap = self.table("cmap")
+        count = struct.unpack(">H", cmap[2:4])[0]
+        for i in range(count):
+            platform, encoding, offset = struct.unpack(">HHI", cmap[4 + 8 * i:12 + 8 * i])
+            if (platform, encoding) in ((3, 1), (0, 3), (0, 4)) and struct.unpack(">H", cmap[offset:offset + 2])[0] == 4:
+                return self.read_cmap4(cmap, offset)
+        raise ValueError("no Unicode BMP cmap")
+
+    @staticmethod
+    def read_cmap4(cmap, base):
+        segs = struct.unpack(">H", cmap[base + 6:base + 8])[0] // 2
+        ends = struct.unpack(f">{segs}H", cmap[base + 14:base + 14 + 2 * segs])
+        pos = base + 16 + 2 * segs
+        starts = struct.unpack(f">{segs}H", cmap[pos:pos + 2 * segs])
+        deltas = struct.unpack(f">{segs}h", cmap[pos + 2 * segs:pos + 4 * segs])
+        range_pos = pos + 4 * segs
+        ranges = struct.unpack(f">{segs}H", cmap[range_pos:range_pos + 2 * segs])
+
+        mapping = {}
+        for i in range(segs):
+            for code in range(starts[i], min(ends[i], 0xFFFE) + 1):
+                if ranges[i]:
+                    at = range_pos + 2 * i + ranges[i] + 2 * (code - starts[i])
+                    glyph = struct.unpack(">H", cmap[at:at + 2])[0]
+                    if glyph:
+                        glyph = (glyph + deltas[i]) & 0xFFFF
+                else:
+                    glyph = (code + deltas[i]) & 0xFFFF
+                if glyph:
+                    mapping[code] = glyph
+        return mapping
+
+    def advance(self, glyph):
+        i = min(glyph, self.num_hmetrics - 1)
+        return struct.unpack(">H", self.hmtx[4 * i:4 * i + 2])[0]
+
+    def contours(self, glyph):
+        """Outline of a glyph as lists of (x, y, on_curve) points in font units."""
+        if self.long_loca:
+            start, end = struct.unpack(">II", self.loca[4 * glyph:4 * glyph + 8])
+        else:
+            start, end = (2 * v for v in struct.unpack(">HH", self.loca[2 * glyph:2 * glyph + 4]))
+        if start == end:
+            return []
+
+        g = self.glyf[start:end]
+        num_contours = struct.unpack(">h", g[0:2])[0]
+        if num_contours < 0:
+            return self.composite(g)
+
+        end_points = struct.unpack(f">{num_contours}H", g[10:10 + 2 * num_contours])
+        pos = 10 + 2 * num_contours
+        pos += 2 + struct.unpack(">H", g[pos:pos + 2])[0]      # skip instructions
+        count = end_points[-1] + 1 if num_contours else 0
+
+        flags = []
+        while len(flags) < count:
+            flag = g[pos]
+            pos += 1
+            flags.append(flag)
+            if flag & 0x08:
+                flags.extend([flag] * g[pos])
+                pos += 1
+
+        def coords(short_bit, same_bit):
+            nonlocal pos
+            values, value = [], 0
+            for flag in flags[:count]:
+                if flag & short_bit:
+                    delta = g[pos]
+                    pos += 1
+                    value += delta if flag & same_bit else -delta
+                elif not flag & same_bit:
+                    value += struct.unpack(">h", g[pos:pos + 2])[0]
+                    pos += 2
+                values.append(value)
+            return values
+
+        xs = coords(0x02, 0x10)
+        ys = coords(0x04, 0x20)
+
+        result, first = [], 0
+        for last in end_points:
+            result.append([(xs[i], ys[i], bool(flags[i] & 1)) for i in range(first, last + 1)])
+            first = last + 1
+        return result
+
+    def composite(self, g):
+        result, pos = [], 10
+        while True:
+            flags, glyph = struct.unpack(">HH", g[pos:pos + 4])
+            pos += 4
+            if flags & 0x01:
+                dx, dy = struct.unpack(">hh", g[pos:pos + 4])
+                pos += 4
+            else:
+                dx, dy = struct.unpack(">bb", g[pos:pos + 2])
+                pos += 2
+            a, b, c, d = 1.0, 0.0, 0.0, 1.0
+            if flags & 0x08:
+                a = d = struct.unpack(">h", g[pos:pos + 2])[0] / 16384
+                pos += 2
+            elif flags & 0x40:
+                a, d = (v / 16384 for v in struct.unpack(">hh", g[pos:pos + 4]))
+                pos += 4
+            elif flags & 0x80:
+                a, b, c, d = (v / 16384 for v in struct.unpack(">hhhh", g[pos:pos + 8]))
+                pos += 8
+            for contour in self.contours(glyph):
+                result.append([(a * x + c * y + dx, b * x + d * y + dy, on) for x, y, on in contour])
+            if not flags & 0x20:
+                return result
+
+
+def flatten(contour, steps=6):
+    """Turns a TrueType contour (quadratic, with implied on-curve points) into a closed polyline."""
+    points = []
+    n = len(contour)
+    # Start at an on-curve point, or the midpoint of two off-curve points
+    start = next((i for i, p in enumerate(contour) if p[2]), None)
+    if start is None:
+        a, b = contour[0], contour[1]
+        contour = [((a[0] + b[0]) / 2, (a[1] + b[1]) / 2, True)] + contour[1:] + contour[:1]
+        start, n = 0, len(contour)
+    contour = contour[start:] + contour[:start]
+
+    points.append(contour[0][:2])
+    i = 1
+    while i <= n:
+        p = contour[i % n]
+        if p[2]:
+            points.append(p[:2])
+            i += 1
+            continue
+        nxt = contour[(i + 1) % n]
+        end = nxt[:2] if nxt[2] else ((p[0] + nxt[0]) / 2, (p[1] + nxt[1]) / 2)
+        x0, y0 = points[-1]
+        for s in range(1, steps + 1):
+            t = s / steps
+            points.append(((1 - t) ** 2 * x0 + 2 * (1 - t) * t * p[0] + t * t * end[0],
+                           (1 - t) ** 2 * y0 + 2 * (1 - t) * t * p[1] + t * t * end[1]))
+        i += 2 if nxt[2] else 1
+    return points
+
+
+def rasterize(polylines, scale, baseline, shift=0.0, samples=4):
+    """Renders polylines (font units, y up), moved right by shift pixels, onto a pixel grid whose
+    row 0 starts baseline pixels above the baseline. Returns (x_min, y_min, rows of coverage
+    from 0 to 1) or None if the glyph is empty."""
+    edges = []
+    for poly in polylines:
+        for (x0, y0), (x1, y1) in zip(poly, poly[1:] + poly[:1]):
+            if y0 != y1:
+                edges.append((x0 * scale + shift, baseline - y0 * scale, x1 * scale + shift, baseline - y1 * scale))
+    if not edges:
+        return None
+
+    x_min = int(min(min(e[0], e[2]) for e in edges)) - 1
+    x_max = int(max(max(e[0], e[2]) for e in edges)) + 2
+    y_min = int(min(min(e[1], e[3]) for e in edges)) - 1
+    y_max = int(max(max(e[1], e[3]) for e in edges)) + 2
+    width = x_max - x_min
+    cover = [[0] * width for _ in range(y_max - y_min)]
+
+    for sy in range((y_max - y_min) * samples):
+        y = y_min + (sy + 0.5) / samples
+        crossings = []
+        for x0, y0, x1, y1 in edges:
+            if (y0 <= y < y1) or (y1 <= y < y0):
+                crossings.append((x0 + (y - y0) * (x1 - x0) / (y1 - y0), 1 if y1 > y0 else -1))
+        crossings.sort()
+        winding = 0
+        for (xa, wa), (xb, _) in zip(crossings, crossings[1:]):
+            winding += wa
+            if not winding:
+                continue
+            # Nonzero span from xa to xb: count the subsamples inside
+            for sx in range(max(0, int((xa - x_min) * samples - 0.5)), int((xb - x_min) * samples + 0.5) + 1):
+                if xa <= x_min + (sx + 0.5) / samples < xb and sx < width * samples:
+                    cover[sy // samples][sx // samples] += 1
+
+    return x_min, y_min, [[c / (samples * samples) for c in row] for row in cover]
+
+
+def read_ttf(path, size, first, last):
+    font = TrueType(open(path, "rb").read())
+    scale = size / font.units_per_em
+    ascent = round(font.ascender * scale)
+    descent = round(-font.descender * scale)
+
+    glyphs = {}
+    for code in range(first, last + 1):
+        glyph = font.cmap.get(code)
+        if glyph is None:
+            continue
+        advance = round(font.advance(glyph) * scale)
+        outline = [flatten(c) for c in font.contours(glyph) if len(c) > 1]
+        if rasterize(outline, scale, ascent) is None:
+            glyphs[code] = (advance, 0, 0, [])
+            continue
+
+        # Poor man's hinting: of a few sub-pixel positions, keep the one that leaves the fewest
+        # half-covered pixels, so vertical stems land on whole columns
+        best = None
+        for shift in (0.0, 0.25, 0.5, 0.75):
+            x_min, y_min, cover = rasterize(outline, scale, ascent, shift)
+            blur = sum(c * (1 - c) for row in cover for c in row)
+            if best is None or blur < best[0]:
+                best = (blur, x_min, y_min, cover)
+        _, x_min, y_min, cover = best
+        glyphs[code] = (advance, x_min, ascent - y_min, [[c >= 0.5 for c in row] for row in cover])
+    return ascent, descent, glyphs
+
+
+# --- Output ---
+
+def crop(x_offset, y_top, rows):
+    """Trims blank rows and columns; returns (x_offset, y_top, rows) of the ink only."""
+    while rows and not any(rows[0]):
+        rows = rows[1:]
+        y_top -= 1
+    while rows and not any(rows[-1]):
+        rows = rows[:-1]
+    if not rows:
+        return 0, 0, []
+    left = min(row.index(True) for row in rows if any(row))
+    right = max(len(row) - row[::-1].index(True) for row in rows if any(row))
+    return x_offset + left, y_top, [row[left:right] for row in rows]
+
+
+def to_pages(rows):
+    width = len(rows[0]) if rows else 0
+    out = bytearray(width * ((len(rows) + 7) // 8))
+    for y, row in enumerate(rows):
+        for x, lit in enumerate(row):
+            if lit:
+                out[(y // 8) * width + x] |= 1 << (y % 8)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a BDF or TrueType font into an ssd1306_font_t.")
+    parser.add_argument("font")
+    parser.add_argument("-n", "--name", help="variable name (default: derived from the file name)")
+    parser.add_argument("-s", "--size", type=int, help="pixels per em, required for TrueType fonts")
+    parser.add_argument("-r", "--range", default="32-126", help="first-last character codes (default 32-126)")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    first, last = (int(v, 0) for v in args.range.split("-"))
+    if args.font.lower().endswith(".bdf"):
+        ascent, descent, glyphs = read_bdf(args.font, first, last)
+        origin = os.path.basename(args.font)
+    else:
+        if not args.size:
+            parser.error("TrueType fonts need --size")
+        ascent, descent, glyphs = read_ttf(args.font, args.size, first, last)
+        origin = f"{os.path.basename(args.font)} at {args.size} px"
+
+    if not glyphs:
+        sys.exit("no glyphs in range")
+    first, last = min(glyphs), max(glyphs)
+    height = ascent + descent
+    name = args.name or "font_" + re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.font))[0]).lower()
+
+    bitmaps = bytearray()
+    table = []
+    for code in range(first, last + 1):
+        if code not in glyphs:
+            table.append((len(bitmaps), 0, 0, 0, 0, 0, code))
+            continue
+        advance, x_offset, y_top, rows = glyphs[code]
+        x_offset, y_top, rows = crop(x_offset, y_top, rows)
+        offset = len(bitmaps)
+        bitmaps += to_pages(rows)
+        table.append((offset, len(rows[0]) if rows else 0, len(rows), x_offset, ascent - y_top if rows else 0, advance, code))
+
+    out = ["/**"]
+    if args.output:
+        out.append(f" * @file {os.path.basename(args.output)}")
+    out += [
+        f" * @brief {name}: {origin}, characters {first}-{last}, {height} px line.",
+        " * ",
+        f" * Generated by host/font2c.py; {len(bitmaps)} bytes of glyph bitmaps.",
+        " */",
+        "",
+        '#include "ssd1306.h"',
+        "",
+        f"static const uint8_t {name}_bitmaps[] = {{",
+    ]
+    for i in range(0, len(bitmaps), 16):
+        out.append("    " + " ".join(f"0x{b:02X}," for b in bitmaps[i:i + 16]))
+    out += ["};", "", f"static const ssd1306_glyph_t {name}_glyphs[] = {{"]
+    for offset, w, h, xo, yo, adv, code in table:
+        label = "space" if code == 32 else chr(code) if 32 < code < 127 and chr(code) != "\\" else f"0x{code:02X}"
+        out.append(f"    {{ {offset:5}, {w:2}, {h:2}, {xo:3}, {yo:3}, {adv:2} }},   // {label}")
+    out += [
+        "};",
+        "",
+        f"const ssd1306_font_t {name} = {{",
+        f"    .bitmaps = {name}_bitmaps,",
+        f"    .glyphs = {name}_glyphs,",
+        f"    .first = {first},",
+        f"    .last = {last},",
+        f"    .height = {height},",
+        f"    .baseline = {ascent},",
+        "};",
+    ]
+
+    text = "\n".join(out) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
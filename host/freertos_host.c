@@ -0,0 +1,265 @@
+/**
+ * @file freertos_host.c
+ * @brief Minimal FreeRTOS task/semaphore/queue layer on POSIX threads, for building the SSD1306 driver on a host.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+
+struct host_semaphore {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    unsigned count;
+};
+
+struct host_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint8_t* items;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;                   // oldest item
+    UBaseType_t count;
+};
+
+struct host_task {
+    TaskFunction_t fn;
+    void* arg;
+};
+
+static void deadline_after(struct timespec* ts, TickType_t ticks)
+{
+    clock_gettime(CLOCK_REALTIME, ts);
+    uint64_t ms = (uint64_t)ticks * portTICK_PERIOD_MS;
+    ts->tv_sec += ms / 1000;
+    ts->tv_nsec += (ms % 1000) * 1000000;
+    if (ts->tv_nsec >= 1000000000) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000;
+    }
+}
+
+static SemaphoreHandle_t semaphore_create(unsigned count)
+{
+    SemaphoreHandle_t sem = calloc(1, sizeof(*sem));
+    if (!sem) return NULL;
+    pthread_mutex_init(&sem->lock, NULL);
+    pthread_cond_init(&sem->cond, NULL);
+    sem->count = count;
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return semaphore_create(0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return semaphore_create(1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks_to_wait)
+{
+    struct timespec deadline;
+    BaseType_t taken;
+
+    if (ticks_to_wait != portMAX_DELAY) deadline_after(&deadline, ticks_to_wait);
+
+    pthread_mutex_lock(&sem->lock);
+    while (!sem->count) {
+        if (ticks_to_wait == portMAX_DELAY) {
+            pthread_cond_wait(&sem->cond, &sem->lock);
+        } else if (pthread_cond_timedwait(&sem->cond, &sem->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    taken = sem->count ? pdTRUE : pdFALSE;
+    if (taken) sem->count--;
+    pthread_mutex_unlock(&sem->lock);
+
+    return taken;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    BaseType_t given;
+
+    pthread_mutex_lock(&sem->lock);
+    given = sem->count ? pdFALSE : pdTRUE;
+    sem->count = 1;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->lock);
+
+    return given;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t sem)
+{
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->lock);
+    free(sem);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    QueueHandle_t queue = calloc(1, sizeof(*queue));
+    if (!queue) return NULL;
+    queue->items = malloc(length * item_size);
+    if (!queue->items) {
+        free(queue);
+        return NULL;
+    }
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->cond, NULL);
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+// Senders never wait on the host; a full queue fails right away, as with a zero timeout
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait)
+{
+    (void)ticks_to_wait;
+    BaseType_t sent = pdFALSE;
+
+    pthread_mutex_lock(&queue->lock);
+    if (queue->count < queue->length) {
+        UBaseType_t tail = (queue->head + queue->count) % queue->length;
+        memcpy(&queue->items[tail * queue->item_size], item, queue->item_size);
+        queue->count++;
+        pthread_cond_broadcast(&queue->cond);
+        sent = pdTRUE;
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return sent;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higher_priority_task_woken)
+{
+    if (higher_priority_task_woken) *higher_priority_task_woken = pdFALSE;
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait)
+{
+    struct timespec deadline;
+    BaseType_t received = pdFALSE;
+
+    if (ticks_to_wait != portMAX_DELAY) deadline_after(&deadline, ticks_to_wait);
+
+    pthread_mutex_lock(&queue->lock);
+    while (!queue->count && ticks_to_wait) {
+        if (ticks_to_wait == portMAX_DELAY) {
+            pthread_cond_wait(&queue->cond, &queue->lock);
+        } else if (pthread_cond_timedwait(&queue->cond, &queue->lock, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    if (queue->count) {
+        memcpy(item, &queue->items[queue->head * queue->item_size], queue->item_size);
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        received = pdTRUE;
+    }
+    pthread_mutex_unlock(&queue->lock);
+
+    return received;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    pthread_mutex_lock(&queue->lock);
+    UBaseType_t count = queue->count;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    pthread_cond_destroy(&queue->cond);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->items);
+    free(queue);
+}
+
+static void* task_entry(void* p)
+{
+    struct host_task task = *(struct host_task*)p;
+    free(p);
+    task.fn(task.arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack_depth, void* arg, UBaseType_t priority, TaskHandle_t* handle)
+{
+    (void)name;
+    (void)stack_depth;
+    (void)priority;
+    pthread_t thread;
+    struct host_task* task = malloc(sizeof(*task));
+    if (!task) return pdFAIL;
+
+    task->fn = fn;
+    task->arg = arg;
+    if (pthread_create(&thread, NULL, task_entry, task) != 0) {
+        free(task);
+        return pdFAIL;
+    }
+    pthread_detach(thread);
+    if (handle) *handle = (TaskHandle_t)thread;
+
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    if (!task) pthread_exit(NULL);
+    // Deleting another task is not supported on the host; tasks end with the process
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (TickType_t)((uint64_t)now.tv_sec * configTICK_RATE_HZ + now.tv_nsec / (1000000000 / configTICK_RATE_HZ));
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec ts = {
+        .tv_sec = (ticks * portTICK_PERIOD_MS) / 1000,
+        .tv_nsec = (long)((ticks * portTICK_PERIOD_MS) % 1000) * 1000000
+    };
+    while (nanosleep(&ts, &ts) == -1 && errno == EINTR) {}
+}
+
+void vTaskDelayUntil(TickType_t* previous_wake, TickType_t period)
+{
+    TickType_t wake = *previous_wake + period;
+    TickType_t now = xTaskGetTickCount();
+
+    if ((int32_t)(wake - now) > 0) vTaskDelay(wake - now);
+    *previous_wake = wake;
+}
+
+static pthread_mutex_t critical_lock = PTHREAD_MUTEX_INITIALIZER;
+
+void vPortEnterCritical(void)
+{
+    pthread_mutex_lock(&critical_lock);
+}
+
+void vPortExitCritical(void)
+{
+    pthread_mutex_unlock(&critical_lock);
+}
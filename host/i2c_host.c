@@ -0,0 +1,139 @@
+/**
+ * @file i2c_host.c
+ * @brief ESP8266 I2C master API on top of a ssd1306_transport_t write function, for running ssd1306_i2c.c on a host.
+ *
+ * Command links record what was appended, pointers included, and i2c_master_cmd_begin() reads the
+ * bytes behind those pointers when it runs, the way the SDK does.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/i2c.h"
+
+#define I2C_HOST_MAX_OPS        8       // start, address, two writes and stop is all the driver appends
+#define I2C_HOST_MAX_BYTES      1100    // largest transaction: prefix and a full frame
+
+typedef enum {
+    I2C_HOST_START,
+    I2C_HOST_WRITE_BYTE,
+    I2C_HOST_WRITE,
+    I2C_HOST_STOP
+} i2c_host_op_type_t;
+
+typedef struct {
+    i2c_host_op_type_t type;
+    uint8_t byte;
+    const uint8_t* data;
+    size_t len;
+} i2c_host_op_t;
+
+typedef struct {
+    i2c_host_op_t ops[I2C_HOST_MAX_OPS];
+    int count;
+} i2c_host_link_t;
+
+static esp_err_t (*bus_write)(void* ctx, i2c_port_t i2c_num, uint8_t address,
+                              const uint8_t* prefix, size_t prefix_len,
+                              const uint8_t* data, size_t data_len);
+static void* bus_ctx;
+static int live_links;
+
+void i2c_host_connect(esp_err_t (*write)(void* ctx, i2c_port_t i2c_num, uint8_t address,
+                                         const uint8_t* prefix, size_t prefix_len,
+                                         const uint8_t* data, size_t data_len), void* ctx)
+{
+    bus_write = write;
+    bus_ctx = ctx;
+}
+
+int i2c_host_live_links(void)
+{
+    return live_links;
+}
+
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode)
+{
+    (void)i2c_num;
+    return mode == I2C_MODE_MASTER ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t* i2c_conf)
+{
+    (void)i2c_num;
+    return i2c_conf ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+i2c_cmd_handle_t i2c_cmd_link_create(void)
+{
+    i2c_host_link_t* link = calloc(1, sizeof(*link));
+    if (link) live_links++;
+    return link;
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle)
+{
+    if (!cmd_handle) return;
+    free(cmd_handle);
+    live_links--;
+}
+
+static esp_err_t i2c_host_append(i2c_cmd_handle_t cmd_handle, i2c_host_op_type_t type, uint8_t byte, const uint8_t* data, size_t len)
+{
+    i2c_host_link_t* link = cmd_handle;
+    if (!link || link->count == I2C_HOST_MAX_OPS) return ESP_ERR_INVALID_ARG;
+
+    link->ops[link->count++] = (i2c_host_op_t){ .type = type, .byte = byte, .data = data, .len = len };
+    return ESP_OK;
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle)
+{
+    return i2c_host_append(cmd_handle, I2C_HOST_START, 0, NULL, 0);
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en)
+{
+    (void)ack_en;
+    return i2c_host_append(cmd_handle, I2C_HOST_WRITE_BYTE, data, NULL, 1);
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, uint8_t* data, size_t data_len, bool ack_en)
+{
+    (void)ack_en;
+    return i2c_host_append(cmd_handle, I2C_HOST_WRITE, 0, data, data_len);
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle)
+{
+    return i2c_host_append(cmd_handle, I2C_HOST_STOP, 0, NULL, 0);
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait)
+{
+    static uint8_t bytes[I2C_HOST_MAX_BYTES];
+    i2c_host_link_t* link = cmd_handle;
+    size_t len = 0;
+    esp_err_t err = ESP_OK;
+
+    (void)ticks_to_wait;
+    if (!link) return ESP_ERR_INVALID_ARG;
+
+    // The first byte after a start is the address; the rest goes out as one transaction at the stop
+    for (int i = 0; i < link->count; i++) {
+        const i2c_host_op_t* op = &link->ops[i];
+
+        if (op->type == I2C_HOST_START) {
+            len = 0;
+        } else if (op->type == I2C_HOST_STOP) {
+            if (len && bus_write) err = bus_write(bus_ctx, i2c_num, bytes[0] >> 1, bytes + 1, len - 1, NULL, 0);
+            if (err != ESP_OK) return err;
+        } else {
+            const uint8_t* src = op->type == I2C_HOST_WRITE ? op->data : &op->byte;
+            if (len + op->len > sizeof(bytes)) return ESP_ERR_INVALID_SIZE;
+            memcpy(bytes + len, src, op->len);
+            len += op->len;
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file i2c.h
+ * @brief Host stand-in for the ESP8266 I2C master driver used by the SSD1306 driver.
+ * 
+ * Most host builds reach the panel through a ssd1306_transport_t (see ssd1306_sim.h) and only use
+ * the types. i2c_host.c implements the i2c_master_* API on top of such a transport, so that
+ * ssd1306_i2c.c can be run against the simulator as well.
+ */
+
+#ifndef HOST_DRIVER_I2C_H
+#define HOST_DRIVER_I2C_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef int i2c_port_t;
+
+#define I2C_NUM_0           0
+#define I2C_NUM_MAX         1
+#define I2C_MASTER_WRITE    0
+#define I2C_MASTER_READ     1
+
+typedef enum {
+    I2C_MODE_MASTER,
+    I2C_MODE_MAX
+} i2c_mode_t;
+
+typedef struct {
+    i2c_mode_t mode;
+    int sda_io_num;
+    int sda_pullup_en;
+    int scl_io_num;
+    int scl_pullup_en;
+    uint32_t clk_stretch_tick;
+} i2c_config_t;
+
+typedef void* i2c_cmd_handle_t;
+
+esp_err_t i2c_driver_install(i2c_port_t i2c_num, i2c_mode_t mode);
+esp_err_t i2c_param_config(i2c_port_t i2c_num, const i2c_config_t* i2c_conf);
+
+i2c_cmd_handle_t i2c_cmd_link_create(void);
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd_handle, uint8_t data, bool ack_en);
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd_handle, uint8_t* data, size_t data_len, bool ack_en);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd_handle);
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num, i2c_cmd_handle_t cmd_handle, TickType_t ticks_to_wait);
+
+/**
+ * @brief Sends every transaction i2c_master_cmd_begin() runs to write(ctx, ...) as one prefix.
+ */
+void i2c_host_connect(esp_err_t (*write)(void* ctx, i2c_port_t i2c_num, uint8_t address,
+                                         const uint8_t* prefix, size_t prefix_len,
+                                         const uint8_t* data, size_t data_len), void* ctx);
+
+/**
+ * @brief Command links created and not yet deleted.
+ */
+int i2c_host_live_links(void);
+
+#endif // HOST_DRIVER_I2C_H
@@ -0,0 +1,33 @@
+/**
+ * @file esp_err.h
+ * @brief Host stand-in for the ESP8266 RTOS SDK error codes used by the SSD1306 driver.
+ */
+
+#ifndef HOST_ESP_ERR_H
+#define HOST_ESP_ERR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK                  0
+#define ESP_FAIL                -1
+#define ESP_ERR_NO_MEM          0x101
+#define ESP_ERR_INVALID_ARG     0x102
+#define ESP_ERR_INVALID_STATE   0x103
+#define ESP_ERR_INVALID_SIZE    0x104
+#define ESP_ERR_NOT_FOUND       0x105
+#define ESP_ERR_NOT_SUPPORTED   0x106
+#define ESP_ERR_TIMEOUT         0x107
+
+#define ESP_ERROR_CHECK(x) do {                                             \
+        esp_err_t __err_rc = (x);                                           \
+        if (__err_rc != ESP_OK) {                                           \
+            fprintf(stderr, "%s:%d: %s failed (0x%x)\n",                    \
+                    __FILE__, __LINE__, #x, __err_rc);                      \
+            abort();                                                        \
+        }                                                                   \
+    } while (0)
+
+#endif // HOST_ESP_ERR_H
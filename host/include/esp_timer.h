@@ -0,0 +1,22 @@
+/**
+ * @file esp_timer.h
+ * @brief Host stand-in for the ESP8266 RTOS SDK high resolution timer.
+ */
+
+#ifndef HOST_ESP_TIMER_H
+#define HOST_ESP_TIMER_H
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Microseconds since an arbitrary point, from the monotonic clock.
+ */
+static inline int64_t esp_timer_get_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+#endif // HOST_ESP_TIMER_H
@@ -0,0 +1,33 @@
+/**
+ * @file FreeRTOS.h
+ * @brief Host stand-in for the FreeRTOS types used by the SSD1306 driver (1 ms tick).
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define configTICK_RATE_HZ      1000
+#define configMAX_PRIORITIES    15
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFF)
+#define portTICK_PERIOD_MS      ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS        portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms) * configTICK_RATE_HZ / 1000)
+
+// Critical sections are one process-wide lock, not nested
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+#define portENTER_CRITICAL()    vPortEnterCritical()
+#define portEXIT_CRITICAL()     vPortExitCritical()
+
+#define pdFALSE                 0
+#define pdTRUE                  1
+#define pdFAIL                  pdFALSE
+#define pdPASS                  pdTRUE
+
+#endif // HOST_FREERTOS_H
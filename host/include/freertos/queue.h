@@ -0,0 +1,20 @@
+/**
+ * @file queue.h
+ * @brief Host stand-in for FreeRTOS queues, backed by POSIX threads.
+ */
+
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_queue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks_to_wait);
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higher_priority_task_woken);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks_to_wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+void vQueueDelete(QueueHandle_t queue);
+
+#endif // HOST_FREERTOS_QUEUE_H
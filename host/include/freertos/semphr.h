@@ -0,0 +1,19 @@
+/**
+ * @file semphr.h
+ * @brief Host stand-in for FreeRTOS binary semaphores and mutexes, backed by POSIX threads.
+ */
+
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_semaphore* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks_to_wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+
+#endif // HOST_FREERTOS_SEMPHR_H
@@ -0,0 +1,25 @@
+/**
+ * @file task.h
+ * @brief Host stand-in for the FreeRTOS task API, backed by POSIX threads.
+ */
+
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include <sched.h>
+#include "freertos/FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void* arg);
+
+BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stack_depth, void* arg, UBaseType_t priority, TaskHandle_t* handle);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previous_wake, TickType_t period);
+TickType_t xTaskGetTickCount(void);
+
+#define taskYIELD()     sched_yield()
+#define taskENTER_CRITICAL_FROM_ISR()       (vPortEnterCritical(), (UBaseType_t)0)
+#define taskEXIT_CRITICAL_FROM_ISR(saved)   ((void)(saved), vPortExitCritical())
+
+#endif // HOST_FREERTOS_TASK_H
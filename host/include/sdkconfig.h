@@ -0,0 +1,58 @@
+/**
+ * @file sdkconfig.h
+ * @brief Host stand-in for the generated SDK configuration: the defaults of the driver's Kconfig menu.
+ *
+ * Other panels can be tried on the host by defining the options on the command line, e.g.
+ * make CPPFLAGS+="-DCONFIG_SSD1306_GEOMETRY_72X40 -DCONFIG_SSD1306_FIXED_GEOMETRY".
+ */
+
+#ifndef HOST_SDKCONFIG_H
+#define HOST_SDKCONFIG_H
+
+#if !defined(CONFIG_SSD1306_GEOMETRY_128X32) && !defined(CONFIG_SSD1306_GEOMETRY_64X48) && !defined(CONFIG_SSD1306_GEOMETRY_72X40)
+#define CONFIG_SSD1306_GEOMETRY_128X64      1
+#endif
+
+#ifndef CONFIG_SSD1306_COLUMN_OFFSET
+#if defined(CONFIG_SSD1306_GEOMETRY_64X48)
+#define CONFIG_SSD1306_COLUMN_OFFSET        32
+#elif defined(CONFIG_SSD1306_GEOMETRY_72X40)
+#define CONFIG_SSD1306_COLUMN_OFFSET        28
+#else
+#define CONFIG_SSD1306_COLUMN_OFFSET        0
+#endif
+#endif
+
+#ifndef CONFIG_SSD1306_MULTIPLEX
+#define CONFIG_SSD1306_MULTIPLEX            0
+#endif
+
+#if !defined(CONFIG_SSD1306_GEOMETRY_128X32) && !defined(CONFIG_SSD1306_COM_ALTERNATIVE)
+#define CONFIG_SSD1306_COM_ALTERNATIVE      1
+#endif
+
+#if defined(CONFIG_SSD1306_GEOMETRY_72X40) && !defined(CONFIG_SSD1306_INTERNAL_IREF)
+#define CONFIG_SSD1306_INTERNAL_IREF        1
+#endif
+
+#if !defined(CONFIG_SSD1306_FRAMEBUFFER_HEAP) && !defined(CONFIG_SSD1306_FRAMEBUFFER_STATIC) && !defined(CONFIG_SSD1306_FRAMEBUFFER_NONE)
+#define CONFIG_SSD1306_FRAMEBUFFER_STATIC   1
+#endif
+
+#ifndef CONFIG_SSD1306_I2C_ADDRESS
+#define CONFIG_SSD1306_I2C_ADDRESS          0x3C
+#endif
+#ifndef CONFIG_SSD1306_I2C_SCL_GPIO
+#define CONFIG_SSD1306_I2C_SCL_GPIO         14
+#endif
+#ifndef CONFIG_SSD1306_I2C_SDA_GPIO
+#define CONFIG_SSD1306_I2C_SDA_GPIO         12
+#endif
+#define CONFIG_SSD1306_I2C_PULLUPS          1
+#define CONFIG_SSD1306_I2C_CLK_STRETCH_TICK 300
+#define CONFIG_SSD1306_I2C_TIMEOUT_MS       1000
+#ifndef CONFIG_SSD1306_I2C_LINK_POOL
+#define CONFIG_SSD1306_I2C_LINK_POOL        8
+#endif
+
+#endif // HOST_SDKCONFIG_H
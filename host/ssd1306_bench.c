@@ -0,0 +1,294 @@
+/**
+ * @file ssd1306_bench.c
+ * @author Abdulaziz Alrashidi
+ * @brief Host benchmark for the SSD1306 driver: CPU time and bus traffic per frame of representative scenes.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ * 
+ * @details
+ * Every scene is drawn and flushed through a simulated controller. After each frame the simulated
+ * GDDRAM is compared with the framebuffer, so the benchmark fails (exit code 1) if a flush ever
+ * leaves the panel out of sync. Bus figures are deterministic and can be diffed between builds;
+ * CPU figures are host time and only meaningful relative to each other.
+ * 
+ * Usage: ssd1306_bench [-n frames] [-c bus_hz] [-d] [scene...]
+ *
+ * -d flushes through the diff encoder (ssd1306_diff_flush_start()) instead of the dirty spans.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ssd1306.h"
+#include "ssd1306_sim.h"
+#include "ssd1306_sprite.h"
+
+typedef struct {
+    const char* name;
+    const char* description;
+    void (*setup)(void);
+    void (*frame)(uint32_t n);
+} bench_scene_t;
+
+static ssd1306_sim_bus_t bus;
+static ssd1306_sim_t panel;
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// --- Scenes ---
+
+static void text_frame(uint32_t n)
+{
+    char line[22];
+
+    ssd1306_clear();
+    for (uint8_t row = 0; row < 8; row++) {
+        snprintf(line, sizeof(line), "Line %u: frame %05u", row, (unsigned)(n + row));
+        ssd1306_draw_string(0, row * 8, line, 1, 1, COLOR_WHITE);
+    }
+}
+
+static void dashboard_setup(void)
+{
+    ssd1306_clear();
+    ssd1306_draw_string_centered(0, "DASHBOARD", 1, 1, COLOR_WHITE);
+    ssd1306_draw_horizontal_line(0, 127, 9, COLOR_WHITE);
+    ssd1306_draw_string(0, 14, "Temp", 1, 1, COLOR_WHITE);
+    ssd1306_draw_string(0, 24, "Hum", 1, 1, COLOR_WHITE);
+    ssd1306_draw_string(0, 34, "Press", 1, 1, COLOR_WHITE);
+    ssd1306_draw_empty_rect(0, 50, 128, 10, COLOR_WHITE);
+}
+
+static void dashboard_frame(uint32_t n)
+{
+    char value[8];
+
+    // Only the values and the progress bar change from frame to frame
+    snprintf(value, sizeof(value), "%2u.%uC", (unsigned)(20 + n % 10), (unsigned)(n % 7));
+    ssd1306_clear_region(64, 14, 64, 8);
+    ssd1306_draw_string(64, 14, value, 1, 1, COLOR_WHITE);
+
+    if (n % 4 == 0) {
+        snprintf(value, sizeof(value), "%3u%%", (unsigned)(40 + n % 50));
+        ssd1306_clear_region(64, 24, 64, 8);
+        ssd1306_draw_string(64, 24, value, 1, 1, COLOR_WHITE);
+    }
+
+    uint8_t fill = 2 + (n * 3) % 124;
+    ssd1306_draw_full_rect(2, 52, fill, 6, COLOR_WHITE);
+    ssd1306_draw_full_rect(2 + fill, 52, 124 - fill, 6, COLOR_BLACK);
+}
+
+static void shapes_frame(uint32_t n)
+{
+    ssd1306_clear();
+    ssd1306_draw_full_circle(20 + n % 88, 32, 14, COLOR_WHITE);
+    ssd1306_draw_empty_circle(64, 32, 30, COLOR_WHITE);
+    ssd1306_draw_filled_triangle(n % 128, 0, 127, 63, 0, 63, COLOR_WHITE);
+    ssd1306_draw_full_rect(50, 20, 28, 24, COLOR_BLACK);
+    ssd1306_draw_empty_rect(50, 20, 28, 24, COLOR_WHITE);
+    ssd1306_draw_line(0, 0, 127, n % 64, COLOR_WHITE);
+}
+
+static void clock_setup(void)
+{
+    ssd1306_clear();
+    ssd1306_draw_string_centered(8, "12:00:00", 2, 2, COLOR_WHITE);
+}
+
+static void clock_frame(uint32_t n)
+{
+    char secs[3];
+
+    // A blinking clock: only the seconds digits change
+    uint8_t x = (SCREEN_WIDTH - ssd1306_get_string_width("12:00:00", 2)) / 2 + 6 * 12;
+    snprintf(secs, sizeof(secs), "%02u", (unsigned)(n % 60));
+    ssd1306_clear_region(x, 8, 24, 16);
+    ssd1306_draw_string(x, 8, secs, 2, 2, COLOR_WHITE);
+}
+
+static uint8_t sprite_icon[16 * 2];      // a 16x16 ring, built by sprite_setup()
+
+static void sprite_setup(void)
+{
+    memset(sprite_icon, 0, sizeof(sprite_icon));
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+            int d = (2 * x - 15) * (2 * x - 15) + (2 * y - 15) * (2 * y - 15);
+            if (d <= 225 && d >= 100) sprite_icon[(y / 8) * 16 + x] |= 1 << (y % 8);
+        }
+    }
+    ssd1306_clear();
+}
+
+static void sprite_frame(uint32_t n)
+{
+    // An icon bouncing across the screen at unaligned rows
+    uint8_t x = (n * 3) % 112;
+    uint8_t y = (n * 5) % 96 < 48 ? (n * 5) % 96 : 96 - (n * 5) % 96;
+    if (n) {
+        uint8_t px = ((n - 1) * 3) % 112;
+        uint8_t py = ((n - 1) * 5) % 96 < 48 ? ((n - 1) * 5) % 96 : 96 - ((n - 1) * 5) % 96;
+        ssd1306_clear_region(px, py, 16, 16);
+    }
+    ssd1306_draw_bitmap(x, y, sprite_icon, 16, 16, COLOR_WHITE);
+}
+
+static uint8_t layers_background[BUFFER_SIZE];
+static uint8_t layers_disc[16 * 2];     // opaque area of sprite_icon
+static uint8_t layers_marker[5] = { 0x04, 0x0E, 0x1F, 0x0E, 0x04 };
+static ssd1306_compositor_t layers;
+static ssd1306_sprite_t layers_icon, layers_pointer, layers_progress;
+
+static void layers_setup(void)
+{
+    sprite_setup();
+    memset(layers_disc, 0, sizeof(layers_disc));
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+            if ((2 * x - 15) * (2 * x - 15) + (2 * y - 15) * (2 * y - 15) <= 225) layers_disc[(y / 8) * 16 + x] |= 1 << (y % 8);
+        }
+    }
+
+    // The static screen is drawn once and kept as the background
+    dashboard_setup();
+    for (int x = 0; x < SCREEN_WIDTH; x += 8) {
+        ssd1306_draw_vertical_line(x, 12, 47, COLOR_WHITE);
+    }
+    memcpy(layers_background, ssd1306_default.buffer, BUFFER_SIZE);
+
+    ssd1306_compositor_init(&layers, &ssd1306_default, layers_background);
+    ssd1306_sprite_init(&layers_icon, sprite_icon, layers_disc, 16, 16, 0, 12);
+    ssd1306_sprite_init(&layers_pointer, layers_marker, NULL, 5, 5, 0, 44);
+    ssd1306_sprite_init(&layers_progress, layers_marker, NULL, 5, 5, 2, 52);
+    ssd1306_compositor_add(&layers, &layers_icon);
+    ssd1306_compositor_add(&layers, &layers_pointer);
+    ssd1306_compositor_add(&layers, &layers_progress);
+    ssd1306_compositor_render(&layers);
+}
+
+static void layers_frame(uint32_t n)
+{
+    // An icon bouncing over the grid, a pointer sweeping and a progress marker creeping
+    ssd1306_sprite_move(&layers_icon, (n * 3) % 112, 12 + ((n * 5) % 40 < 20 ? (n * 5) % 40 : 40 - (n * 5) % 40));
+    ssd1306_sprite_move(&layers_pointer, (n * 2) % 124, 44);
+    ssd1306_sprite_move(&layers_progress, 2 + (n / 4) % 120, 52);
+    ssd1306_compositor_render(&layers);
+}
+
+static void full_frame(uint32_t n)
+{
+    ssd1306_draw_full_rect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, n % 2 ? COLOR_WHITE : COLOR_BLACK);
+}
+
+static const bench_scene_t scenes[] = {
+    { "text",      "8 lines of changing text",            NULL,            text_frame },
+    { "dashboard", "static labels, 2 values, a bar",      dashboard_setup, dashboard_frame },
+    { "shapes",    "circles, triangle, rects, line",      NULL,            shapes_frame },
+    { "clock",     "2x clock, seconds only",              clock_setup,     clock_frame },
+    { "sprite",    "16x16 bitmap moving, unaligned",      sprite_setup,    sprite_frame },
+    { "layers",    "3 masked sprites over a background",  layers_setup,    layers_frame },
+    { "full",      "whole screen on/off",                 NULL,            full_frame },
+};
+
+static bool run_scene(const bench_scene_t* scene, uint32_t frames)
+{
+    double draw_us = 0;
+    double flush_us = 0;
+    bool in_sync = true;
+
+    ssd1306_clear();
+    ssd1306_display();
+    if (scene->setup) {
+        scene->setup();
+        ssd1306_display();
+    }
+    ssd1306_sim_reset_stats(&bus);
+    ssd1306_stats_reset();
+
+    for (uint32_t n = 0; n < frames; n++) {
+        double t0 = now_us();
+        scene->frame(n);
+        double t1 = now_us();
+        ssd1306_display();
+        double t2 = now_us();
+
+        draw_us += t1 - t0;
+        flush_us += t2 - t1;
+
+        if (in_sync && !ssd1306_sim_matches(&panel, &ssd1306_default)) {
+            fprintf(stderr, "%s: panel out of sync after frame %u\n", scene->name, (unsigned)n);
+            in_sync = false;
+        }
+    }
+
+    const ssd1306_sim_stats_t* st = &bus.stats;
+    ssd1306_stats_t drv;
+    ssd1306_stats_get(&drv);
+
+    double wire_ms = st->wire_time_us / frames / 1000;
+    printf("%-10s %9.1f %9.1f %8.0f %8.2f %9.1f %9.1f %8.2f %7.0f  %s\n",
+           scene->name,
+           draw_us / frames, flush_us / frames, (double)drv.pixels / frames,
+           (double)st->transactions / frames, (double)st->bytes / frames,
+           (double)st->data_bytes / frames, wire_ms, wire_ms > 0 ? 1000 / wire_ms : 0,
+           scene->description);
+
+    return in_sync;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t frames = 200;
+    uint32_t clock_hz = 400000;
+    int first_scene = argc;
+    bool diff = false;
+    bool ok = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+            frames = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+            clock_hz = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-d")) {
+            diff = true;
+        } else {
+            first_scene = i;
+            break;
+        }
+    }
+    if (!frames || !clock_hz) {
+        fprintf(stderr, "usage: %s [-n frames] [-c bus_hz] [-d] [scene...]\n", argv[0]);
+        return 2;
+    }
+
+    ssd1306_sim_bus_init(&bus, clock_hz);
+    ssd1306_sim_attach(&bus, &panel, SSD1306_ADDR);
+    ssd1306_set_transport(&bus.transport);
+    ssd1306_init();
+    if (diff) ssd1306_diff_flush_start();
+
+    printf("%u frames per scene, bus at %u Hz%s\n\n", (unsigned)frames, (unsigned)clock_hz, diff ? ", diff flush" : "");
+    printf("%-10s %9s %9s %8s %8s %9s %9s %8s %7s\n",
+           "scene", "draw us", "flush us", "pixels", "tx", "bytes", "data", "wire ms", "max fps");
+
+    for (size_t s = 0; s < sizeof(scenes) / sizeof(scenes[0]); s++) {
+        bool selected = first_scene >= argc;
+        for (int i = first_scene; i < argc; i++) {
+            if (!strcmp(argv[i], scenes[s].name)) selected = true;
+        }
+        if (selected) ok &= run_scene(&scenes[s], frames);
+    }
+
+    printf("\nper frame; draw/flush are host CPU time, wire ms is the estimated bus time\n");
+    return ok ? 0 : 1;
+}
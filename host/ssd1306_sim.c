@@ -0,0 +1,215 @@
+/**
+ * @file ssd1306_sim.c
+ * @author Abdulaziz Alrashidi
+ * @brief Simulated SSD1306 controllers on a simulated I2C bus.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ */
+
+#include <string.h>
+
+#include "ssd1306_sim.h"
+
+// Arguments following each command byte
+static uint8_t ssd1306_sim_arg_count(uint8_t cmd)
+{
+    switch (cmd) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xAD: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void ssd1306_sim_execute(ssd1306_sim_t* sim)
+{
+    uint8_t* c = sim->cmd;
+
+    if (c[0] < 0x10) {                                  // lower column nibble (page mode)
+        sim->col = (sim->col & 0xF0) | c[0];
+        return;
+    }
+    if (c[0] < 0x20) {                                  // higher column nibble (page mode)
+        sim->col = (sim->col & 0x0F) | (c[0] & 0x0F) << 4;
+        return;
+    }
+    if (c[0] >= 0x40 && c[0] <= 0x7F) {                 // display start line
+        sim->start_line = c[0] & 0x3F;
+        return;
+    }
+    if (c[0] >= 0xB0 && c[0] <= 0xB7) {                 // page start (page mode)
+        sim->page = c[0] & 0x07;
+        return;
+    }
+
+    switch (c[0]) {
+    case 0x20:
+        sim->addressing_mode = c[1] & 0x03;
+        break;
+    case 0x21:                                          // column window, horizontal/vertical modes
+        sim->col_start = c[1] & 0x7F;
+        sim->col_end = c[2] & 0x7F;
+        sim->col = sim->col_start;
+        break;
+    case 0x22:                                          // page window, horizontal/vertical modes
+        sim->page_start = c[1] & 0x07;
+        sim->page_end = c[2] & 0x07;
+        sim->page = sim->page_start;
+        break;
+    case 0x26: case 0x27: case 0x29: case 0x2A:         // scroll setup is only latched by 0x2F
+        break;
+    case 0x2E:
+        sim->scrolling = false;
+        break;
+    case 0x2F:
+        sim->scrolling = true;
+        break;
+    case 0x81:
+        sim->contrast = c[1];
+        break;
+    case 0xA6: case 0xA7:
+        sim->inverted = c[0] & 0x01;
+        break;
+    case 0xA8:
+        sim->multiplex = c[1] & 0x3F;
+        break;
+    case 0xAE: case 0xAF:
+        sim->display_on = c[0] & 0x01;
+        break;
+    default:
+        break;
+    }
+}
+
+static void ssd1306_sim_command(ssd1306_sim_t* sim, ssd1306_sim_stats_t* stats, uint8_t byte)
+{
+    stats->cmd_bytes++;
+
+    if (sim->cmd_len < sizeof(sim->cmd)) sim->cmd[sim->cmd_len] = byte;
+    sim->cmd_len++;
+
+    if (sim->cmd_len == 1) sim->cmd_need = 1 + ssd1306_sim_arg_count(byte);
+    if (sim->cmd_len < sim->cmd_need) return;
+
+    ssd1306_sim_execute(sim);
+    sim->cmd_len = 0;
+}
+
+static void ssd1306_sim_data(ssd1306_sim_t* sim, ssd1306_sim_stats_t* stats, uint8_t byte)
+{
+    stats->data_bytes++;
+    sim->gddram_writes++;
+    if (sim->scrolling) sim->scroll_violations++;
+    sim->gddram[sim->page][sim->col] = byte;
+
+    switch (sim->addressing_mode) {
+    case 0:                                             // horizontal: columns first, then pages
+        if (sim->col++ >= sim->col_end) {
+            sim->col = sim->col_start;
+            sim->page = sim->page >= sim->page_end ? sim->page_start : sim->page + 1;
+        }
+        break;
+    case 1:                                             // vertical: pages first, then columns
+        if (sim->page++ >= sim->page_end) {
+            sim->page = sim->page_start;
+            sim->col = sim->col >= sim->col_end ? sim->col_start : sim->col + 1;
+        }
+        break;
+    default:                                            // page: column wraps, page stays
+        if (sim->col++ >= SSD1306_GDDRAM_WIDTH - 1) sim->col = 0;
+        break;
+    }
+}
+
+static esp_err_t ssd1306_sim_write(void* ctx, i2c_port_t i2c_num, uint8_t address, const uint8_t* prefix, size_t prefix_len, const uint8_t* data, size_t data_len)
+{
+    ssd1306_sim_bus_t* bus = ctx;
+    ssd1306_sim_t* sim = NULL;
+    (void)i2c_num;
+    size_t total = prefix_len + data_len;
+
+    // Start, address byte, payload and stop; every byte is 8 bits plus the acknowledge
+    bus->stats.transactions++;
+    bus->stats.bytes += 1 + total;
+    bus->stats.wire_time_us += (9.0 * (1 + total) + 2) * 1e6 / bus->clock_hz;
+
+    for (size_t i = 0; i < bus->device_count; i++) {
+        if (bus->devices[i]->address == address) sim = bus->devices[i];
+    }
+    if (!sim) {
+        bus->stats.nacks++;
+        return ESP_FAIL;
+    }
+
+    // Control byte: Co = 1 means one byte follows and then another control byte,
+    // Co = 0 means everything up to the stop is commands (D/C = 0) or data (D/C = 1)
+    bool streaming = false;
+    bool is_data = false;
+    bool expect_control = true;
+
+    for (size_t i = 0; i < total; i++) {
+        uint8_t byte = i < prefix_len ? prefix[i] : data[i - prefix_len];
+
+        if (!streaming && expect_control) {
+            bus->stats.control_bytes++;
+            is_data = byte & 0x40;
+            streaming = !(byte & 0x80);
+            expect_control = false;
+            continue;
+        }
+
+        if (is_data) {
+            ssd1306_sim_data(sim, &bus->stats, byte);
+        } else {
+            ssd1306_sim_command(sim, &bus->stats, byte);
+        }
+        if (!streaming) expect_control = true;
+    }
+
+    return ESP_OK;
+}
+
+void ssd1306_sim_bus_init(ssd1306_sim_bus_t* bus, uint32_t clock_hz)
+{
+    memset(bus, 0, sizeof(*bus));
+    bus->clock_hz = clock_hz;
+    bus->transport.init = NULL;
+    bus->transport.write = ssd1306_sim_write;
+    bus->transport.ctx = bus;
+}
+
+void ssd1306_sim_attach(ssd1306_sim_bus_t* bus, ssd1306_sim_t* sim, uint8_t address)
+{
+    // Power-on state from the datasheet: page addressing, full windows, display off
+    memset(sim, 0, sizeof(*sim));
+    sim->address = address;
+    sim->addressing_mode = 2;
+    sim->col_end = SSD1306_GDDRAM_WIDTH - 1;
+    sim->page_end = SSD1306_GDDRAM_PAGES - 1;
+    sim->contrast = 0x7F;
+    sim->multiplex = 0x3F;
+
+    if (bus->device_count < SSD1306_SIM_MAX_DEVICES) bus->devices[bus->device_count++] = sim;
+}
+
+void ssd1306_sim_reset_stats(ssd1306_sim_bus_t* bus)
+{
+    memset(&bus->stats, 0, sizeof(bus->stats));
+}
+
+bool ssd1306_sim_matches(const ssd1306_sim_t* sim, const ssd1306_t* dev)
+{
+    for (uint8_t page = 0; page < dev->pages; page++) {
+        if (memcmp(&sim->gddram[page][dev->col_offset], &dev->buffer[page * dev->width], dev->width)) return false;
+    }
+    return true;
+}
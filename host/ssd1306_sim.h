@@ -0,0 +1,114 @@
+/**
+ * @file ssd1306_sim.h
+ * @author Abdulaziz Alrashidi
+ * @brief Simulated SSD1306 controllers on a simulated I2C bus, for running the driver on a host.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ * 
+ * @details
+ * The simulator decodes the byte stream the driver puts on the bus the way the controller does:
+ * control bytes (Co and D/C), commands and their arguments, the three addressing modes, column and
+ * page windows and GDDRAM writes. The bus counts transactions and bytes and estimates how long the
+ * traffic would take on the wire at a given clock.
+ */
+
+#ifndef SSD1306_SIM_H
+#define SSD1306_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+#define SSD1306_SIM_MAX_DEVICES 4       //!< panels that can share one simulated bus
+
+/**
+ * @brief Traffic counters of a simulated bus.
+ */
+typedef struct {
+    uint32_t transactions;              //!< start ... stop sequences
+    uint64_t bytes;                     //!< bytes on the wire, address byte included
+    uint64_t cmd_bytes;                 //!< command bytes (arguments included) decoded by the panels
+    uint64_t data_bytes;                //!< GDDRAM bytes decoded by the panels
+    uint64_t control_bytes;             //!< control bytes (0x00, 0x40, 0x80, 0xC0)
+    uint32_t nacks;                     //!< transactions to an address nobody answers
+    double wire_time_us;                //!< estimated time on the wire at the bus clock
+} ssd1306_sim_stats_t;
+
+/**
+ * @brief One simulated SSD1306 controller.
+ */
+typedef struct {
+    uint8_t address;                    //!< 7-bit address the controller answers to
+    uint8_t gddram[SSD1306_GDDRAM_PAGES][SSD1306_GDDRAM_WIDTH];
+
+    uint8_t addressing_mode;            //!< 0 horizontal, 1 vertical, 2 page
+    uint8_t col_start, col_end;         //!< column window (0x21)
+    uint8_t page_start, page_end;       //!< page window (0x22)
+    uint8_t col, page;                  //!< GDDRAM pointer
+
+    bool display_on;
+    bool inverted;
+    bool scrolling;                     //!< 0x2F seen without a following 0x2E
+    uint8_t contrast;
+    uint8_t multiplex;
+    uint8_t start_line;
+
+    uint8_t cmd[8];                     //!< command being assembled from its arguments
+    uint8_t cmd_len;
+    uint8_t cmd_need;
+
+    uint64_t gddram_writes;             //!< GDDRAM bytes written to this controller
+    uint64_t scroll_violations;         //!< GDDRAM bytes written while scrolling, which the datasheet prohibits
+} ssd1306_sim_t;
+
+/**
+ * @brief A simulated I2C bus with the panels attached to it.
+ */
+typedef struct {
+    ssd1306_sim_t* devices[SSD1306_SIM_MAX_DEVICES];
+    size_t device_count;
+    uint32_t clock_hz;                  //!< bus clock used for the wire time estimate
+    ssd1306_sim_stats_t stats;
+    ssd1306_transport_t transport;      //!< pass to ssd1306_set_transport()
+} ssd1306_sim_bus_t;
+
+
+/**
+ * @brief Initializes a bus and its transport.
+ * 
+ * @param bus The bus to initialize.
+ * @param clock_hz Bus clock, e.g. 100000 or 400000.
+ */
+void ssd1306_sim_bus_init(ssd1306_sim_bus_t* bus, uint32_t clock_hz);
+
+
+/**
+ * @brief Attaches a controller in its power-on state to the bus.
+ * 
+ * @param bus The bus.
+ * @param sim The controller.
+ * @param address Its 7-bit address.
+ */
+void ssd1306_sim_attach(ssd1306_sim_bus_t* bus, ssd1306_sim_t* sim, uint8_t address);
+
+
+/**
+ * @brief Resets the traffic counters of the bus.
+ */
+void ssd1306_sim_reset_stats(ssd1306_sim_bus_t* bus);
+
+
+/**
+ * @brief Checks that what the panel shows matches a device's framebuffer.
+ * 
+ * @param sim The controller.
+ * @param dev The device drawing for it.
+ * @return true if every byte of the framebuffer is in GDDRAM
+ */
+bool ssd1306_sim_matches(const ssd1306_sim_t* sim, const ssd1306_t* dev);
+
+#endif // SSD1306_SIM_H
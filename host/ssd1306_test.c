@@ -0,0 +1,1025 @@
+/**
+ * @file ssd1306_test.c
+ * @author Abdulaziz Alrashidi
+ * @brief Host tests for the SSD1306 driver: framebuffer output checked against reference rasterisers.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ *
+ * @details
+ * The optimized primitives are checked pixel for pixel against straightforward implementations:
+ * lines and circles against the per-pixel algorithms the driver started from, bitmaps against a
+ * per-bit plot, RLE against raw blits, clipped drawing against unclipped drawing masked afterward,
+ * and paged rendering with bands of every size against rendering into the framebuffer.
+ * The helper modules (layouts, animations, the draw queue, grayscale, dithering) are checked for
+ * the framebuffer they leave behind, and the I2C transport (on a stub of the SDK's i2c_master_*
+ * API, see i2c_host.c) for keeping the panel in sync without building new command links once its
+ * pool is warm. Every case runs on random inputs from a fixed seed.
+ *
+ * Usage: ssd1306_test
+ *
+ * Prints one line per failed check and exits non-zero if there was any.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "driver/i2c.h"
+
+#include "ssd1306.h"
+#include "ssd1306_sim.h"
+#include "ssd1306_anim.h"
+#include "ssd1306_dither.h"
+#include "ssd1306_gray.h"
+#include "ssd1306_layout.h"
+#include "ssd1306_pacer.h"
+#include "ssd1306_queue.h"
+#include "ssd1306_sprite.h"
+
+#define CHECK(cond, ...) do {                                       \
+        if (!(cond)) {                                              \
+            fprintf(stderr, "%s:%d: ", __func__, __LINE__);         \
+            fprintf(stderr, __VA_ARGS__);                           \
+            fputc('\n', stderr);                                    \
+            failures++;                                             \
+        }                                                           \
+    } while (0)
+
+typedef struct {
+    const char* name;
+    void (*run)(void);
+} test_case_t;
+
+static ssd1306_sim_bus_t bus;
+static ssd1306_sim_t panel;
+static ssd1306_t* dev = &ssd1306_default;
+static uint8_t expected[BUFFER_SIZE];
+static uint32_t seed = 1;
+static int failures;
+
+static int rnd(int lo, int hi)
+{
+    seed = seed * 1103515245 + 12345;
+    return lo + (int)((seed >> 8) % (uint32_t)(hi - lo + 1));
+}
+
+static void random_fill(uint8_t* fb)
+{
+    for (size_t i = 0; i < BUFFER_SIZE; i++) fb[i] = rnd(0, 255);
+}
+
+// Gives the framebuffer and expected the same random content
+static void random_background(void)
+{
+    random_fill(dev->buffer);
+    memcpy(expected, dev->buffer, BUFFER_SIZE);
+}
+
+static void blank_background(void)
+{
+    memset(dev->buffer, 0, BUFFER_SIZE);
+    memset(expected, 0, BUFFER_SIZE);
+}
+
+// Compares the framebuffer with expected and reports the first differing pixel
+static bool matches(const char* what)
+{
+    for (size_t i = 0; i < BUFFER_SIZE; i++) {
+        if (dev->buffer[i] == expected[i]) continue;
+        uint8_t diff = dev->buffer[i] ^ expected[i];
+        int bit = 0;
+        while (!(diff >> bit & 1)) bit++;
+        CHECK(false, "%s: pixel (%d, %d) is %d, expected %d", what, (int)(i % SCREEN_WIDTH),
+              (int)(i / SCREEN_WIDTH * 8 + bit), dev->buffer[i] >> bit & 1, expected[i] >> bit & 1);
+        return false;
+    }
+    return true;
+}
+
+// --- Reference rasterisers ---
+
+static void ref_plot(uint8_t* fb, int x, int y, ssd1306_draw_mode_t color)
+{
+    if (x < 0 || y < 0 || x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT) return;
+
+    uint8_t* byte = &fb[(y / 8) * SCREEN_WIDTH + x];
+    uint8_t bit = 1 << (y & 7);
+    if (color == SSD1306_DRAW_XOR) *byte ^= bit;
+    else if (color == COLOR_WHITE) *byte |= bit;
+    else *byte &= ~bit;
+}
+
+static bool ref_get(const uint8_t* fb, int x, int y)
+{
+    return fb[(y / 8) * SCREEN_WIDTH + x] >> (y & 7) & 1;
+}
+
+// Bresenham, one pixel per step
+static void ref_line(int x0, int y0, int x1, int y1, ssd1306_draw_mode_t color)
+{
+    int dx = abs(x1 - x0);
+    int sx = x0 < x1 ? 1 : -1;
+    int dy = -abs(y1 - y0);
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+
+    for (;;) {
+        ref_plot(expected, x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+// Midpoint circle, outline or vertical spans between the octants
+static void ref_circle(int x0, int y0, int radius, bool fill, ssd1306_draw_mode_t color)
+{
+    int x = 0;
+    int y = radius;
+    int f = 1 - radius;
+    int ddf_x = 1;
+    int ddf_y = -2 * radius;
+
+    if (fill) {
+        for (int i = y0 - radius; i <= y0 + radius; i++) ref_plot(expected, x0, i, color);
+    } else {
+        ref_plot(expected, x0, y0 + radius, color);
+        ref_plot(expected, x0, y0 - radius, color);
+        ref_plot(expected, x0 + radius, y0, color);
+        ref_plot(expected, x0 - radius, y0, color);
+    }
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddf_y += 2;
+            f += ddf_y;
+        }
+        x++;
+        ddf_x += 2;
+        f += ddf_x;
+
+        if (fill) {
+            for (int i = y0 - y; i <= y0 + y; i++) {
+                ref_plot(expected, x0 + x, i, color);
+                ref_plot(expected, x0 - x, i, color);
+            }
+            for (int i = y0 - x; i <= y0 + x; i++) {
+                ref_plot(expected, x0 + y, i, color);
+                ref_plot(expected, x0 - y, i, color);
+            }
+        } else {
+            ref_plot(expected, x0 + x, y0 + y, color);
+            ref_plot(expected, x0 - x, y0 + y, color);
+            ref_plot(expected, x0 + x, y0 - y, color);
+            ref_plot(expected, x0 - x, y0 - y, color);
+            ref_plot(expected, x0 + y, y0 + x, color);
+            ref_plot(expected, x0 - y, y0 + x, color);
+            ref_plot(expected, x0 + y, y0 - x, color);
+            ref_plot(expected, x0 - y, y0 - x, color);
+        }
+    }
+}
+
+// Every set bit of a page-layout bitmap, one plot each
+static void ref_bitmap(int x, int y, const uint8_t* bitmap, int w, int h, ssd1306_draw_mode_t color)
+{
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            if (bitmap[(row / 8) * w + col] >> (row & 7) & 1) ref_plot(expected, x + col, y + row, color);
+        }
+    }
+}
+
+// PackBits: runs of three or more equal bytes are repeated, the rest is sent literally
+static size_t rle_encode(const uint8_t* src, size_t len, uint8_t* out)
+{
+    size_t n = 0;
+    size_t i = 0;
+
+    while (i < len) {
+        size_t run = 1;
+        while (i + run < len && run < 128 && src[i + run] == src[i]) run++;
+        if (run >= 3) {
+            out[n++] = 257 - run;
+            out[n++] = src[i];
+            i += run;
+            continue;
+        }
+
+        size_t start = i;
+        while (i < len && i - start < 128) {
+            if (i + 2 < len && src[i] == src[i + 1] && src[i] == src[i + 2]) break;
+            i++;
+        }
+        out[n++] = i - start - 1;
+        memcpy(&out[n], &src[start], i - start);
+        n += i - start;
+    }
+    return n;
+}
+
+// Standard 8x8 Bayer index, built by interleaving the bits of x ^ y and y in reverse order
+static int ref_bayer_index(int x, int y)
+{
+    int index = 0;
+    for (int k = 0; k < 3; k++) {
+        index = (index << 2) | (((x ^ y) >> k & 1) << 1) | (y >> k & 1);
+    }
+    return index;
+}
+
+// --- Primitives ---
+
+static void test_line(void)
+{
+    for (int i = 0; i < 400; i++) {
+        ssd1306_draw_mode_t color = rnd(0, 2);
+        int x0 = rnd(-40, 170), y0 = rnd(-40, 110), x1 = rnd(-40, 170), y1 = rnd(-40, 110);
+
+        random_background();
+        ssd1306_draw_line(x0, y0, x1, y1, color);
+        ref_line(x0, y0, x1, y1, color);
+        if (!matches("line")) {
+            fprintf(stderr, "  from (%d, %d) to (%d, %d), color %d\n", x0, y0, x1, y1, color);
+            return;
+        }
+    }
+}
+
+static void test_circle(void)
+{
+    for (int i = 0; i < 300; i++) {
+        bool fill = rnd(0, 1);
+        ssd1306_draw_mode_t color = rnd(0, 1);
+        int x0 = rnd(0, SCREEN_WIDTH - 1), y0 = rnd(0, SCREEN_HEIGHT - 1), radius = rnd(0, 40);
+
+        random_background();
+        if (fill)
+            ssd1306_draw_full_circle(x0, y0, radius, color);
+        else
+            ssd1306_draw_empty_circle(x0, y0, radius, color);
+        ref_circle(x0, y0, radius, fill, color);
+        if (!matches(fill ? "full circle" : "empty circle")) {
+            fprintf(stderr, "  center (%d, %d), radius %d, color %d\n", x0, y0, radius, color);
+            return;
+        }
+    }
+}
+
+static void test_bitmap(void)
+{
+    static uint8_t bitmap[8 * 64];
+    static uint8_t packed[8 * 64 * 2];
+    static uint8_t background[BUFFER_SIZE];
+
+    for (int i = 0; i < 300; i++) {
+        int w = rnd(1, 64), h = rnd(1, 64);
+        int x = rnd(-w, SCREEN_WIDTH), y = rnd(-h, SCREEN_HEIGHT);
+        ssd1306_draw_mode_t color = rnd(0, 3);
+        size_t size = (size_t)w * ((h + 7) / 8);
+
+        // Long runs as well as noise, so both kinds of PackBits packets occur
+        for (size_t j = 0; j < size; j++) bitmap[j] = rnd(0, 3) ? bitmap[j ? j - 1 : 0] : rnd(0, 255);
+
+        random_background();
+        memcpy(background, expected, BUFFER_SIZE);
+        ssd1306_draw_bitmap(x, y, bitmap, w, h, color);
+        if (color != SSD1306_DRAW_INVERT) {
+            ref_bitmap(x, y, bitmap, w, h, color);
+            if (!matches("bitmap")) {
+                fprintf(stderr, "  %dx%d at (%d, %d), color %d\n", w, h, x, y, color);
+                return;
+            }
+        }
+
+        memcpy(expected, dev->buffer, BUFFER_SIZE);
+        memcpy(dev->buffer, background, BUFFER_SIZE);
+        ssd1306_draw_bitmap_rle(x, y, packed, rle_encode(bitmap, size, packed), w, h, color);
+        if (!matches("RLE bitmap against the raw one")) {
+            fprintf(stderr, "  %dx%d at (%d, %d), color %d\n", w, h, x, y, color);
+            return;
+        }
+    }
+}
+
+// Shapes of every kind, offset by (dx, dy)
+static void draw_shapes(int dx, int dy, int n)
+{
+    static const uint8_t arrow[] = { 0x18, 0x3C, 0x7E, 0xFF, 0x18, 0x18, 0x18, 0x18 };
+    ssd1306_draw_mode_t color = n % 3;
+
+    ssd1306_draw_line(dx - 10, dy + 5, dx + 90, dy + 40, color);
+    ssd1306_draw_full_rect(dx + 20, dy + 10, 30, 20, color);
+    ssd1306_draw_empty_circle(dx + 60, dy + 30, 25, COLOR_WHITE);
+    ssd1306_draw_full_ellipse(dx + 30, dy + 40, 20, 9, color);
+    ssd1306_draw_string(dx + 5, dy + 2, "Clip", 1, 2, color);
+    ssd1306_draw_bitmap(dx + 70, dy - 3, arrow, 8, 8, color);
+    ssd1306_draw_filled_triangle(dx, dy + 60, dx + 40, dy + 20, dx + 80, dy + 62, color);
+}
+
+// Replaces the window [x, x + w) × [y, y + h) of expected with the same window of src
+static void merge_window(const uint8_t* src, int x, int y, int w, int h)
+{
+    for (int py = y; py < y + h; py++) {
+        for (int px = x; px < x + w; px++) {
+            ref_plot(expected, px, py, ref_get(src, px, py));
+        }
+    }
+}
+
+static void test_clip(void)
+{
+    static uint8_t shapes[BUFFER_SIZE];
+
+    for (int i = 0; i < 100; i++) {
+        int w = rnd(1, 90), h = rnd(1, 50);
+        int x = rnd(0, SCREEN_WIDTH - w), y = rnd(0, SCREEN_HEIGHT - h);
+        bool viewport = rnd(0, 1);
+        int dx = viewport ? x : 0, dy = viewport ? y : 0;
+
+        // Unclipped, at screen position
+        random_background();
+        draw_shapes(dx, dy, i);
+        memcpy(shapes, dev->buffer, BUFFER_SIZE);
+
+        memcpy(dev->buffer, expected, BUFFER_SIZE);
+        merge_window(shapes, x, y, w, h);
+
+        if (viewport) ssd1306_push_viewport(x, y, w, h);
+        else ssd1306_push_clip(x, y, w, h);
+        draw_shapes(0, 0, i);
+        ssd1306_pop_clip();
+
+        if (!matches(viewport ? "viewport" : "clip")) {
+            fprintf(stderr, "  window %dx%d at (%d, %d)\n", w, h, x, y);
+            return;
+        }
+    }
+}
+
+// A screen using most primitives, drawn whole by every band of a paged render
+static void draw_paged_scene(ssd1306_t* panel_dev, void* arg)
+{
+    static const uint8_t arrow[] = { 0x18, 0x3C, 0x7E, 0xFF, 0x18, 0x18, 0x18, 0x18 };
+    static uint8_t gradient[24 * 20];
+    (void)arg;
+
+    for (size_t i = 0; i < sizeof(gradient); i++) gradient[i] = (i % 24) * 11;
+
+    ssd1306_dev_clear(panel_dev);
+    ssd1306_dev_draw_string(panel_dev, 2, 3, "Paged", 2, 2, COLOR_WHITE);
+    ssd1306_dev_draw_line(panel_dev, 0, 63, 127, 0, SSD1306_DRAW_XOR);
+    ssd1306_dev_draw_empty_circle(panel_dev, 90, 30, 28, COLOR_WHITE);
+    ssd1306_dev_draw_full_circle(panel_dev, 90, 30, 9, SSD1306_DRAW_XOR);
+    ssd1306_dev_draw_filled_triangle(panel_dev, 5, 60, 40, 22, 60, 58, SSD1306_DRAW_XOR);
+    ssd1306_dev_draw_full_rect(panel_dev, 62, 7, 20, 18, SSD1306_DRAW_XOR);
+    ssd1306_dev_draw_bitmap(panel_dev, 110, 45, arrow, 8, 8, SSD1306_DRAW_INVERT);
+    ssd1306_dev_draw_gray_image(panel_dev, 100, 2, gradient, 24, 20, SSD1306_DITHER_FLOYD_STEINBERG);
+}
+
+static void test_paged(void)
+{
+    static uint8_t band[SCREEN_WIDTH * SCREEN_PAGES];
+    static const uint8_t band_pages[] = { 0, 1, 2, 3, SCREEN_PAGES };
+
+    blank_background();
+    draw_paged_scene(dev, NULL);
+    memcpy(expected, dev->buffer, BUFFER_SIZE);
+
+    for (size_t i = 0; i < sizeof(band_pages); i++) {
+        static uint8_t kept[BUFFER_SIZE];
+        ssd1306_paged_stats_t stats;
+
+        // Whatever the framebuffer holds is neither drawn over nor sent
+        random_fill(dev->buffer);
+        memcpy(kept, dev->buffer, BUFFER_SIZE);
+        ssd1306_dev_render_paged(dev, draw_paged_scene, NULL, band_pages[i] ? band : NULL,
+                                 band_pages[i] * SCREEN_WIDTH, &stats);
+        CHECK(!memcmp(dev->buffer, kept, BUFFER_SIZE), "%u-page bands: framebuffer changed", band_pages[i]);
+
+        memcpy(dev->buffer, expected, BUFFER_SIZE);
+        CHECK(ssd1306_sim_matches(&panel, dev), "%u-page bands: panel differs from a full render", band_pages[i]);
+        CHECK(stats.band_pages == (band_pages[i] ? band_pages[i] : 1), "%u-page bands: %u pages per pass",
+              band_pages[i], stats.band_pages);
+    }
+}
+
+// --- Helper modules ---
+
+static void test_layout(void)
+{
+    ssd1306_layout_t layout;
+    const ssd1306_font_t* font = &ssd1306_font_5x7;
+
+    // 10 characters of the 5x7 font per line
+    ssd1306_layout_init(&layout, "hello world foo bar", font, 0, 0, 60, 64, SSD1306_ALIGN_LEFT, SSD1306_LAYOUT_WRAP);
+    CHECK(layout.line_count == 3, "wrapped into %u lines, expected 3", layout.line_count);
+    CHECK(layout.lines[0].start == 0 && layout.lines[0].len == 5, "first line is %u+%u", layout.lines[0].start, layout.lines[0].len);
+    CHECK(layout.lines[1].start == 6 && layout.lines[1].len == 9, "second line is %u+%u", layout.lines[1].start, layout.lines[1].len);
+    CHECK(layout.lines[2].start == 16 && layout.lines[2].len == 3, "third line is %u+%u", layout.lines[2].start, layout.lines[2].len);
+    CHECK(!layout.truncated, "fitting text marked truncated");
+
+    ssd1306_layout_init(&layout, "a rather long line of text", font, 10, 0, 60, 8, SSD1306_ALIGN_RIGHT, SSD1306_LAYOUT_ELLIPSIS);
+    CHECK(layout.line_count == 1 && layout.truncated && layout.lines[0].ellipsis, "long line not ellipsized");
+    CHECK(layout.lines[0].width <= 60, "ellipsized line is %u px wide in a 60 px box", layout.lines[0].width);
+    CHECK(layout.lines[0].x + layout.lines[0].width == 70, "right-aligned line ends at %d", layout.lines[0].x + layout.lines[0].width);
+
+    // "..." is 18 px in the 5x7 font: a narrower box cuts the line without it
+    ssd1306_layout_init(&layout, "too long", font, 0, 0, 14, 8, SSD1306_ALIGN_LEFT, SSD1306_LAYOUT_ELLIPSIS);
+    CHECK(layout.truncated && !layout.lines[0].ellipsis, "ellipsis added to a 14 px box");
+    CHECK(layout.lines[0].width <= 14, "cut line is %u px wide in a 14 px box", layout.lines[0].width);
+
+    // Drawing a layout matches drawing its lines one by one
+    ssd1306_layout_init(&layout, "one two three four five six", font, 4, 8, 64, 40, SSD1306_ALIGN_CENTER, SSD1306_LAYOUT_WRAP);
+    blank_background();
+    ssd1306_layout_draw(&layout, dev, COLOR_WHITE);
+    memcpy(expected, dev->buffer, BUFFER_SIZE);
+    memset(dev->buffer, 0, BUFFER_SIZE);
+    for (uint8_t i = 0; i < layout.line_count; i++) {
+        char line[32];
+        memcpy(line, layout.str + layout.lines[i].start, layout.lines[i].len);
+        line[layout.lines[i].len] = 0;
+        ssd1306_draw_string_font(layout.lines[i].x, 8 + i * font->height, font, line, COLOR_WHITE);
+    }
+    matches("layout against its lines");
+}
+
+static void test_anim(void)
+{
+    ssd1306_anim_t anim;
+
+    // A typewriter ends where ssd1306_draw_string() would have
+    blank_background();
+    ssd1306_draw_string(3, 20, "Typewriter", 1, 2, COLOR_WHITE);
+    memcpy(expected, dev->buffer, BUFFER_SIZE);
+    memset(dev->buffer, 0, BUFFER_SIZE);
+    ssd1306_anim_type_init(&anim, dev, 3, 20, "Typewriter", 1, 2, 0, COLOR_WHITE);
+    ssd1306_anim_start(&anim);
+    ssd1306_anim_wait(&anim);
+    matches("typewriter");
+
+    // An overwrite leaves only the new string, whichever is longer
+    blank_background();
+    ssd1306_draw_string(0, 40, "short", 2, 1, COLOR_WHITE);
+    memcpy(expected, dev->buffer, BUFFER_SIZE);
+    memset(dev->buffer, 0, BUFFER_SIZE);
+    ssd1306_draw_string(0, 40, "a longer one", 2, 1, COLOR_WHITE);
+    ssd1306_anim_overwrite_init(&anim, dev, 0, 40, "a longer one", "short", 2, 1, 0);
+    ssd1306_anim_start(&anim);
+    ssd1306_anim_wait(&anim);
+    matches("overwrite");
+
+    // Between layouts, the end result is the old text erased and the new one drawn over it
+    static const char* words[] = { "a", "wide", "mm", "jig", "overwrite", "ill", "W", "...", "text" };
+    static const ssd1306_font_t* fonts[] = { &ssd1306_font_5x7, &ssd1306_font_sans16 };
+    for (int i = 0; i < 60; i++) {
+        static char text[2][96];
+        static uint8_t result[BUFFER_SIZE];
+        ssd1306_layout_t layouts[2];
+
+        for (int k = 0; k < 2; k++) {
+            text[k][0] = 0;
+            for (int n = rnd(1, 8); n; n--) {
+                strcat(text[k], words[rnd(0, sizeof(words) / sizeof(words[0]) - 1)]);
+                if (n > 1) strcat(text[k], " ");
+            }
+            ssd1306_layout_init(&layouts[k], text[k], fonts[rnd(0, 1)], rnd(0, 20), rnd(0, 20), rnd(30, 100), rnd(10, 44),
+                                rnd(0, 2), rnd(0, 3));
+        }
+
+        // Reference in expected, the effect in the framebuffer
+        random_background();
+        ssd1306_layout_draw(&layouts[0], dev, COLOR_WHITE);
+        memcpy(expected, dev->buffer, BUFFER_SIZE);
+        ssd1306_anim_layout_overwrite_init(&anim, dev, &layouts[0], &layouts[1], 0);
+        ssd1306_anim_start(&anim);
+        ssd1306_anim_wait(&anim);
+
+        memcpy(result, dev->buffer, BUFFER_SIZE);
+        memcpy(dev->buffer, expected, BUFFER_SIZE);
+        ssd1306_layout_draw(&layouts[0], dev, COLOR_BLACK);
+        ssd1306_layout_draw(&layouts[1], dev, COLOR_WHITE);
+        memcpy(expected, dev->buffer, BUFFER_SIZE);
+        memcpy(dev->buffer, result, BUFFER_SIZE);
+        if (!matches("layout overwrite")) {
+            fprintf(stderr, "  \"%s\" to \"%s\"\n", text[0], text[1]);
+            return;
+        }
+    }
+}
+
+static int pacer_renders;
+
+static void pacer_render(ssd1306_t* panel_dev, void* arg)
+{
+    (void)arg;
+    pacer_renders++;
+    ssd1306_dev_draw_full_rect(panel_dev, 20, 8, 10, 8, SSD1306_DRAW_XOR);
+}
+
+// Sleeps until the pacer's next slot, plus late_us, and ticks it
+static void pacer_tick_at_slot(ssd1306_pacer_t* pacer, uint32_t late_us)
+{
+    int64_t now = esp_timer_get_time();
+    int64_t wait = pacer->next_frame_us + late_us - now;
+    if (wait > 0) vTaskDelay((wait + 999) / 1000);
+    ssd1306_pacer_tick(pacer);
+}
+
+static void test_pacer(void)
+{
+    static ssd1306_pacer_t pacer;
+    const uint16_t fps = 50;
+
+    blank_background();
+    ssd1306_display_full();
+
+    // What one frame of the render callback costs on the bus
+    uint32_t transactions = bus.stats.transactions;
+    pacer_render(dev, NULL);
+    ssd1306_display();
+    uint32_t frame_transactions = bus.stats.transactions - transactions;
+    pacer_renders = 0;
+
+    ssd1306_pacer_init(&pacer, dev, fps, pacer_render, NULL);
+    ssd1306_pacer_tick(&pacer);
+    CHECK(pacer_renders == 1 && pacer.stats.frames == 1, "first tick: %d renders, %u frames", pacer_renders, (unsigned)pacer.stats.frames);
+
+    // Invalidations between two slots make one render and one flush
+    for (int i = 0; i < 5; i++) ssd1306_pacer_invalidate(&pacer);
+    transactions = bus.stats.transactions;
+    pacer_tick_at_slot(&pacer, 0);
+    CHECK(pacer_renders == 2 && pacer.stats.frames == 2, "5 invalidations: %d renders, %u frames", pacer_renders - 1, (unsigned)pacer.stats.frames - 1);
+    CHECK(bus.stats.transactions - transactions == frame_transactions, "coalesced frame took %u transactions, one frame takes %u",
+          (unsigned)(bus.stats.transactions - transactions), (unsigned)frame_transactions);
+
+    // A slot with nothing to send stays off the bus
+    transactions = bus.stats.transactions;
+    pacer_tick_at_slot(&pacer, 0);
+    CHECK(pacer.stats.idle_frames == 1 && pacer.stats.frames == 2, "idle slot: %u idle, %u frames", (unsigned)pacer.stats.idle_frames, (unsigned)pacer.stats.frames);
+    CHECK(bus.stats.transactions == transactions, "idle slot sent %u transactions", (unsigned)(bus.stats.transactions - transactions));
+
+    // Three and a half periods late: the three slots that passed are counted missed, not replayed
+    ssd1306_pacer_invalidate(&pacer);
+    pacer_tick_at_slot(&pacer, 7 * pacer.period_us / 2);
+    CHECK(pacer.stats.missed_frames == 3, "%u slots missed, expected 3", (unsigned)pacer.stats.missed_frames);
+    CHECK(pacer_renders == 3 && pacer.stats.frames == 3, "late slot: %d renders, %u frames", pacer_renders, (unsigned)pacer.stats.frames);
+    CHECK(ssd1306_pacer_tick(&pacer) > 0 && pacer.stats.frames == 3, "late slot replayed");
+
+    matches("pacer frames against the drawing");
+    CHECK(ssd1306_sim_matches(&panel, dev), "panel out of sync after the pacer");
+}
+
+#define SPRITE_COUNT    3
+
+// The compositor's result: the background, then each visible sprite's opaque pixels, bottom to top
+static void ref_composite(const uint8_t* background, ssd1306_sprite_t* const* order, int count)
+{
+    memcpy(expected, background, BUFFER_SIZE);
+    for (int s = 0; s < count; s++) {
+        const ssd1306_sprite_t* sprite = order[s];
+        const uint8_t* mask = sprite->mask ? sprite->mask : sprite->bitmap;
+        if (!sprite->visible) continue;
+
+        for (int row = 0; row < sprite->h; row++) {
+            for (int col = 0; col < sprite->w; col++) {
+                int i = (row / 8) * sprite->w + col;
+                if (!(mask[i] >> (row & 7) & 1)) continue;
+                ref_plot(expected, sprite->x + col, sprite->y + row, sprite->bitmap[i] >> (row & 7) & 1 ? COLOR_WHITE : COLOR_BLACK);
+            }
+        }
+    }
+}
+
+// Renders and checks the frame, and that the dirty spans are exactly the columns that changed
+static bool sprite_render_matches(ssd1306_compositor_t* comp, const uint8_t* background, ssd1306_sprite_t* const* order, int count, const char* what)
+{
+    static uint8_t before[BUFFER_SIZE];
+
+    ssd1306_display();
+    memcpy(before, dev->buffer, BUFFER_SIZE);
+    ssd1306_compositor_render(comp);
+    ref_composite(background, order, count);
+    if (!matches(what)) return false;
+
+    for (int page = 0; page < SCREEN_HEIGHT / 8; page++) {
+        int first = -1, last = -1;
+        for (int x = 0; x < SCREEN_WIDTH; x++) {
+            if (before[page * SCREEN_WIDTH + x] == dev->buffer[page * SCREEN_WIDTH + x]) continue;
+            if (first < 0) first = x;
+            last = x;
+        }
+
+        bool exact = first < 0 ? !dev->dirty_end[page]
+                               : dev->dirty_start[page] == first && dev->dirty_end[page] == last + 1;
+        if (!exact) {
+            CHECK(false, "%s: page %d dirty [%d, %d), changed [%d, %d]", what, page,
+                  dev->dirty_start[page], dev->dirty_end[page], first, last);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_sprite(void)
+{
+    static uint8_t background[BUFFER_SIZE];
+    static uint8_t pixels[2][SPRITE_COUNT][SSD1306_MAX_WIDTH * 3];
+    static uint8_t masks[SPRITE_COUNT][SSD1306_MAX_WIDTH * 3];
+    static ssd1306_compositor_t comp;
+    static ssd1306_sprite_t sprites[SPRITE_COUNT];
+    ssd1306_sprite_t* order[SPRITE_COUNT];
+    int count = SPRITE_COUNT;
+    char what[64];
+
+    random_background();
+    memcpy(background, dev->buffer, BUFFER_SIZE);
+    blank_background();
+    ssd1306_display_full();
+    ssd1306_compositor_init(&comp, dev, background);
+
+    // Heights that leave the last source page partly used, one to three pages, with and without a mask
+    static const uint8_t sizes[SPRITE_COUNT][2] = { { 17, 13 }, { 9, 5 }, { 24, 20 } };
+    for (int s = 0; s < SPRITE_COUNT; s++) {
+        int w = sizes[s][0], h = sizes[s][1];
+        for (int i = 0; i < w * 3; i++) {
+            pixels[0][s][i] = rnd(0, 255);
+            pixels[1][s][i] = rnd(0, 255);
+            masks[s][i] = rnd(0, 255);
+        }
+        ssd1306_sprite_init(&sprites[s], pixels[0][s], s == 1 ? NULL : masks[s], w, h, 10 + 20 * s, 3 + 5 * s);
+        ssd1306_compositor_add(&comp, &sprites[s]);
+        order[s] = &sprites[s];
+    }
+    if (!sprite_render_matches(&comp, background, order, count, "first render")) return;
+
+    // Overlapping each other, at unaligned and negative positions, shown, hidden, swapped and re-stacked
+    for (int step = 0; step < 400; step++) {
+        ssd1306_sprite_t* sprite = order[rnd(0, count - 1)];
+        int s = sprite - sprites;
+        int action = rnd(0, 9);
+
+        if (action < 6) {
+            int x = rnd(-sprite->w - 2, SCREEN_WIDTH + 1);
+            int y = action < 2 ? rnd(-sprite->h - 2, -1) : rnd(-sprite->h - 2, SCREEN_HEIGHT + 1);
+            if (action == 5) {
+                x = order[0]->x + rnd(-4, 4);
+                y = order[0]->y + rnd(-4, 4);
+            }
+            ssd1306_sprite_move(sprite, x, y);
+            snprintf(what, sizeof(what), "sprite %d moved to (%d, %d)", s, x, y);
+        } else if (action == 6) {
+            ssd1306_sprite_set_visible(sprite, !sprite->visible);
+            snprintf(what, sizeof(what), "sprite %d %s", s, sprite->visible ? "shown" : "hidden");
+        } else if (action == 7) {
+            int frame = sprite->bitmap == pixels[0][s];
+            ssd1306_sprite_set_bitmap(sprite, pixels[frame][s], sprite->mask);
+            snprintf(what, sizeof(what), "sprite %d switched to frame %d", s, frame);
+        } else {
+            // Removed, then put back on top
+            ssd1306_compositor_remove(sprite);
+            int at = 0;
+            while (order[at] != sprite) at++;
+            memmove(&order[at], &order[at + 1], (count - at - 1) * sizeof(order[0]));
+            count--;
+            snprintf(what, sizeof(what), "sprite %d removed", s);
+            if (!sprite_render_matches(&comp, background, order, count, what)) return;
+
+            ssd1306_compositor_add(&comp, sprite);
+            order[count++] = sprite;
+            snprintf(what, sizeof(what), "sprite %d added on top", s);
+        }
+
+        if (!sprite_render_matches(&comp, background, order, count, what)) return;
+    }
+
+    ssd1306_display();
+    CHECK(ssd1306_sim_matches(&panel, dev), "panel out of sync after compositing");
+}
+
+// Waits for the render task to draw up to count commands in total
+static bool queue_wait_drawn(ssd1306_queue_t* queue, uint32_t count)
+{
+    for (int wait = 0; queue->drawn < count && wait < 1000; wait++) vTaskDelay(1);
+    return queue->drawn == count;
+}
+
+// Commands partly off the panel are clipped instead of wrapping around
+static void test_queue_clip(ssd1306_queue_t* queue)
+{
+    static uint8_t glyph[BUFFER_SIZE];
+    uint32_t drawn = queue->drawn;
+
+    blank_background();
+    ssd1306_draw_char(0, 0, 'Q', 1, 1, COLOR_WHITE);
+    memcpy(glyph, dev->buffer, BUFFER_SIZE);
+    memset(dev->buffer, 0, BUFFER_SIZE);
+    ssd1306_display_full();
+
+    for (int y = 0; y < 8; y++)
+        for (int x = 0; x < 6; x++)
+            if (ref_get(glyph, x, y)) ref_plot(expected, x - 3, 20 + y, COLOR_WHITE);
+    for (int y = -3; y < 3; y++)
+        for (int x = -4; x < 6; x++) ref_plot(expected, x, y, SSD1306_DRAW_XOR);
+
+    CHECK(ssd1306_queue_text(queue, -3, 20, "Q", 1, 1, 0, COLOR_WHITE) == ESP_OK, "text not posted");
+    CHECK(ssd1306_queue_rect(queue, -4, -3, 10, 6, SSD1306_DRAW_XOR) == ESP_OK, "rect not posted");
+    CHECK(ssd1306_queue_rect(queue, SCREEN_WIDTH + 100, 0, 10, 6, COLOR_WHITE) == ESP_OK, "rect not posted");
+    CHECK(ssd1306_queue_invalidate(queue, -20, -20, 10, 10) == ESP_OK, "invalidate not posted");
+
+    CHECK(queue_wait_drawn(queue, drawn + 4), "%u of 4 clipped commands drawn", (unsigned)(queue->drawn - drawn));
+    matches("commands off the panel edges");
+    CHECK(ssd1306_sim_matches(&panel, dev), "panel out of sync after clipped commands");
+}
+
+#define QUEUE_PRODUCERS     4
+#define QUEUE_POSTS         5000
+
+typedef struct {
+    ssd1306_queue_t* queue;
+    uint32_t accepted;
+    SemaphoreHandle_t done;
+} queue_producer_t;
+
+static void queue_hold(ssd1306_t* panel_dev, void* arg)
+{
+    (void)panel_dev;
+    xSemaphoreTake(arg, portMAX_DELAY);
+}
+
+static void queue_producer(void* arg)
+{
+    queue_producer_t* producer = arg;
+    for (int i = 0; i < QUEUE_POSTS; i++) {
+        if (ssd1306_queue_invalidate(producer->queue, 0, 0, 1, 1) == ESP_OK) producer->accepted++;
+    }
+    xSemaphoreGive(producer->done);
+    vTaskDelete(NULL);
+}
+
+// Producers racing on a full queue: every post is either queued or counted as dropped
+static void test_queue_dropped(ssd1306_queue_t* queue)
+{
+    static queue_producer_t producers[QUEUE_PRODUCERS];
+    SemaphoreHandle_t hold = xSemaphoreCreateBinary();
+    uint32_t drawn = queue->drawn;
+    uint32_t dropped = queue->dropped;
+    uint32_t accepted = 0;
+
+    // The render task waits in a CALL until the producers are done
+    CHECK(ssd1306_queue_call(queue, queue_hold, hold) == ESP_OK, "call not posted");
+    for (int i = 0; i < QUEUE_PRODUCERS; i++) {
+        producers[i] = (queue_producer_t){ .queue = queue, .done = xSemaphoreCreateBinary() };
+        CHECK(xTaskCreate(queue_producer, "producer", 2048, &producers[i], 2, NULL) == pdPASS, "producer %d not started", i);
+    }
+    for (int i = 0; i < QUEUE_PRODUCERS; i++) {
+        xSemaphoreTake(producers[i].done, portMAX_DELAY);
+        vSemaphoreDelete(producers[i].done);
+        accepted += producers[i].accepted;
+    }
+    xSemaphoreGive(hold);
+
+    CHECK(queue->dropped - dropped == QUEUE_PRODUCERS * QUEUE_POSTS - accepted, "%u posts dropped, %u counted",
+          (unsigned)(QUEUE_PRODUCERS * QUEUE_POSTS - accepted), (unsigned)(queue->dropped - dropped));
+    CHECK(queue_wait_drawn(queue, drawn + 1 + accepted), "%u of %u commands drawn",
+          (unsigned)(queue->drawn - drawn), (unsigned)(1 + accepted));
+    vSemaphoreDelete(hold);
+}
+
+static void test_queue(void)
+{
+    static ssd1306_queue_t queue;
+    const int commands = 40;
+
+    blank_background();
+    for (int i = 0; i < commands; i++) {
+        uint8_t x = (i * 13) % 100, y = (i * 7) % 56;
+        if (i % 2)
+            ssd1306_draw_full_rect(x, y, 10, 6, SSD1306_DRAW_XOR);
+        else
+            ssd1306_draw_string(x, y, "Q", 1, 1, COLOR_WHITE);
+    }
+    memcpy(expected, dev->buffer, BUFFER_SIZE);
+    memset(dev->buffer, 0, BUFFER_SIZE);
+    ssd1306_display_full();
+
+    CHECK(ssd1306_queue_start(&queue, dev, commands, 1) == ESP_OK, "queue did not start");
+    for (int i = 0; i < commands; i++) {
+        uint8_t x = (i * 13) % 100, y = (i * 7) % 56;
+        esp_err_t err = i % 2 ? ssd1306_queue_rect(&queue, x, y, 10, 6, SSD1306_DRAW_XOR)
+                              : ssd1306_queue_text(&queue, x, y, "Q", 1, 1, 0, COLOR_WHITE);
+        CHECK(err == ESP_OK, "command %d not posted", i);
+    }
+
+    for (int wait = 0; queue.drawn < (uint32_t)commands && wait < 1000; wait++) vTaskDelay(1);
+    CHECK(queue.drawn == (uint32_t)commands, "%u of %d commands drawn", (unsigned)queue.drawn, commands);
+    CHECK(queue.dropped == 0, "%u commands dropped", (unsigned)queue.dropped);
+    matches("queued commands against direct drawing");
+    CHECK(ssd1306_sim_matches(&panel, dev), "panel out of sync after the queue flushed");
+
+    test_queue_clip(&queue);
+    test_queue_dropped(&queue);
+}
+
+static void test_gray(void)
+{
+    static ssd1306_gray_t gray;
+    ssd1306_gray_config_t config = { .field_rate = 200, .clock = 0xF0, .precharge = 0x21, .priority = 1 };
+    uint8_t clock = dev->clock, precharge = dev->precharge;
+
+    blank_background();
+    ssd1306_display_full();
+    CHECK(ssd1306_gray_start(&gray, dev, &config) == ESP_OK, "grayscale did not start");
+    CHECK(dev->clock == 0xF0 && dev->precharge == 0x21, "panel timing not applied");
+    for (uint8_t level = 0; level < SSD1306_GRAY_LEVELS; level++) {
+        ssd1306_gray_fill_rect(&gray, 10 + 20 * level, 5, 17, 30, level);
+    }
+
+    for (uint8_t level = 0; level < SSD1306_GRAY_LEVELS; level++) {
+        int x = 10 + 20 * level + 8, y = 20;
+        CHECK(ref_get(gray.planes[0], x, y) == (level & 1), "level %u: low plane bit wrong", level);
+        CHECK(ref_get(gray.planes[1], x, y) == (level >> 1), "level %u: high plane bit wrong", level);
+    }
+    vTaskDelay(20);
+    ssd1306_gray_stop(&gray);
+    CHECK(gray.stats.fields > 0, "no field shown");
+    CHECK(dev->clock == clock && dev->precharge == precharge, "panel timing not restored");
+
+    // Back to 1bpp, showing the high plane
+    for (uint8_t level = 0; level < SSD1306_GRAY_LEVELS; level++) {
+        for (int y = 5; y < 35; y++) {
+            for (int x = 10 + 20 * level; x < 27 + 20 * level; x++) ref_plot(expected, x, y, level >> 1);
+        }
+    }
+    matches("framebuffer after stopping");
+    CHECK(ssd1306_sim_matches(&panel, dev), "panel does not show the high plane after stopping");
+}
+
+static void test_dither(void)
+{
+    static uint8_t image[SCREEN_HEIGHT][SCREEN_WIDTH];
+    static int error[2][SCREEN_WIDTH + 2];
+
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        for (int x = 0; x < SCREEN_WIDTH; x++) image[y][x] = (x * 2 + y + rnd(0, 20)) & 0xFF;
+    }
+
+    for (int mode = SSD1306_DITHER_THRESHOLD; mode <= SSD1306_DITHER_FLOYD_STEINBERG; mode++) {
+        ssd1306_stats_t stats;
+        random_background();
+        ssd1306_stats_reset();
+        ssd1306_draw_gray_image(0, 0, &image[0][0], SCREEN_WIDTH, SCREEN_HEIGHT, mode);
+        ssd1306_stats_get(&stats);
+        CHECK(stats.pixels == SCREEN_WIDTH * SCREEN_HEIGHT, "dithering counted %u pixels", (unsigned)stats.pixels);
+        memset(error, 0, sizeof(error));
+
+        for (int y = 0; y < SCREEN_HEIGHT; y++) {
+            int* cur = &error[y & 1][1];
+            int* next = &error[~y & 1][1];
+            memset(next - 1, 0, sizeof(error[0]));
+
+            for (int x = 0; x < SCREEN_WIDTH; x++) {
+                bool on;
+                if (mode == SSD1306_DITHER_THRESHOLD) {
+                    on = image[y][x] >= 128;
+                } else if (mode == SSD1306_DITHER_BAYER) {
+                    on = image[y][x] > 4 * ref_bayer_index(x & 7, y & 7) + 2;
+                } else {
+                    int level = image[y][x] + cur[x];
+                    on = level >= 128;
+                    int e = level - (on ? 255 : 0);
+                    int e7 = e * 7 / 16, e3 = e * 3 / 16, e5 = e * 5 / 16;
+                    cur[x + 1] += e7;
+                    next[x - 1] += e3;
+                    next[x] += e5;
+                    next[x + 1] += e - e7 - e3 - e5;
+                }
+                ref_plot(expected, x, y, on ? COLOR_WHITE : COLOR_BLACK);
+            }
+        }
+
+        static const char* names[] = { "threshold dither", "Bayer dither", "Floyd-Steinberg dither" };
+        matches(names[mode]);
+    }
+}
+
+// --- Transport ---
+
+// One frame of a display loop: a counter and a blinking marker redrawn in place
+static void i2c_loop_frame(int frame)
+{
+    char text[8];
+    snprintf(text, sizeof(text), "%05d", frame);
+    ssd1306_draw_full_rect(40, 24, 30, 8, COLOR_BLACK);
+    ssd1306_draw_string(40, 24, text, 1, 1, COLOR_WHITE);
+    ssd1306_draw_full_rect(100, 50, 12, 6, SSD1306_DRAW_XOR);
+    if (frame % 10 == 0) ssd1306_cmd(frame % 20 ? 0xA6 : 0xA7);
+
+    if (frame % 25 == 0) ssd1306_display_full();
+    else ssd1306_display();
+}
+
+static void test_i2c_pool(void)
+{
+    ssd1306_set_transport(&ssd1306_i2c_transport);
+    i2c_host_connect(bus.transport.write, bus.transport.ctx);
+    CHECK(ssd1306_i2c_transport.init(NULL) == ESP_OK, "I2C transport did not start");
+
+    // Full frames, single commands and spans of every length and position
+    blank_background();
+    for (int frame = 0; frame < 300; frame++) {
+        int w = rnd(1, SCREEN_WIDTH), h = rnd(1, SCREEN_HEIGHT);
+        ssd1306_draw_full_rect(rnd(0, SCREEN_WIDTH - w), rnd(0, SCREEN_HEIGHT - h), w, h, SSD1306_DRAW_XOR);
+        ssd1306_draw_line(rnd(0, SCREEN_WIDTH - 1), rnd(0, SCREEN_HEIGHT - 1), rnd(0, SCREEN_WIDTH - 1), rnd(0, SCREEN_HEIGHT - 1), COLOR_WHITE);
+        if (frame % 10 == 0) ssd1306_cmd(frame % 20 ? 0xA6 : 0xA7);
+
+        if (frame % 50 == 0) ssd1306_display_full();
+        else ssd1306_display();
+        if (!ssd1306_sim_matches(&panel, dev)) {
+            CHECK(false, "panel out of sync after frame %d", frame);
+            break;
+        }
+    }
+    CHECK(i2c_host_live_links() <= CONFIG_SSD1306_I2C_LINK_POOL, "%d command links alive", i2c_host_live_links());
+
+    // A loop flushing the same spans every frame stops building links once warm
+    for (int frame = 0; frame < 20; frame++) i2c_loop_frame(frame);
+    uint32_t warm = ssd1306_i2c_get_alloc_count();
+    uint32_t transactions = bus.stats.transactions;
+    for (int frame = 20; frame < 120; frame++) i2c_loop_frame(frame);
+    transactions = bus.stats.transactions - transactions;
+
+    CHECK(ssd1306_i2c_get_alloc_count() == warm, "%u command links built after warm-up",
+          (unsigned)(ssd1306_i2c_get_alloc_count() - warm));
+    CHECK(ssd1306_sim_matches(&panel, dev), "panel out of sync after the display loop");
+
+    // and puts each write on the bus as one transaction, full frames included
+    ssd1306_set_transport(&bus.transport);
+    uint32_t direct = bus.stats.transactions;
+    for (int frame = 20; frame < 120; frame++) i2c_loop_frame(frame);
+    direct = bus.stats.transactions - direct;
+    CHECK(transactions == direct, "%u transactions through the I2C transport, %u written", (unsigned)transactions, (unsigned)direct);
+}
+
+// --- Scrolling ---
+
+// Runs last: the flush task it starts has no stop
+static void test_scroll(void)
+{
+    random_background();
+    memcpy(expected, dev->buffer, BUFFER_SIZE);
+    ssd1306_display_full();
+    CHECK(ssd1306_flush_task_start(1) == ESP_OK, "flush task did not start");
+
+    // A frame still on its way when the scroll starts has to land before RAM access is locked
+    ssd1306_draw_full_rect(10, 10, 50, 30, SSD1306_DRAW_XOR);
+    CHECK(ssd1306_display_async() == ESP_OK, "async flush not queued");
+    CHECK(ssd1306_scroll_start(SSD1306_SCROLL_LEFT, 0, SCREEN_HEIGHT / 8 - 1, SSD1306_SCROLL_5_FRAMES, 0) == ESP_OK, "scroll did not start");
+    CHECK(panel.scrolling, "scroll not activated on the panel");
+    CHECK(panel.scroll_violations == 0, "%llu bytes written while scrolling", (unsigned long long)panel.scroll_violations);
+    CHECK(ssd1306_sim_matches(&panel, dev), "pending frame not on the panel when the scroll started");
+    ssd1306_scroll_stop();
+
+    CHECK(ssd1306_wait_flush(SSD1306_WAIT_FOREVER) == ESP_OK, "waiting forever for an idle flush failed");
+}
+
+static const test_case_t tests[] = {
+    { "line",     test_line },
+    { "circle",   test_circle },
+    { "bitmap",   test_bitmap },
+    { "clip",     test_clip },
+    { "paged",    test_paged },
+    { "layout",   test_layout },
+    { "anim",     test_anim },
+    { "pacer",    test_pacer },
+    { "sprite",   test_sprite },
+    { "queue",    test_queue },
+    { "gray",     test_gray },
+    { "dither",   test_dither },
+    { "i2c pool", test_i2c_pool },
+    { "scroll",   test_scroll },
+};
+
+int main(void)
+{
+    ssd1306_sim_bus_init(&bus, 400000);
+    ssd1306_sim_attach(&bus, &panel, SSD1306_ADDR);
+    ssd1306_set_transport(&bus.transport);
+    ssd1306_init();
+
+    for (size_t t = 0; t < sizeof(tests) / sizeof(tests[0]); t++) {
+        int before = failures;
+        tests[t].run();
+        printf("%-10s %s\n", tests[t].name, failures == before ? "ok" : "FAILED");
+    }
+
+    printf("\n%d failed check%s\n", failures, failures == 1 ? "" : "s");
+    return failures ? 1 : 0;
+}
@@ -16,48 +16,343 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "esp_err.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "driver/i2c.h"
 
-// --- Pin Configuration ---
-#define I2C_SCL_IO      14                                  //!< gpio number for I2C clock
-#define I2C_SDA_IO      12                                  //!< gpio number for I2C data
+// --- Pin Configuration (menuconfig: "SSD1306 OLED", see Kconfig) ---
+#define I2C_SCL_IO      CONFIG_SSD1306_I2C_SCL_GPIO         //!< gpio number for I2C clock
+#define I2C_SDA_IO      CONFIG_SSD1306_I2C_SDA_GPIO         //!< gpio number for I2C data
 #define I2C_NUM         I2C_NUM_0                           //!< I2C port number
 
 // --- SSD1306 Constants ---
-#define SSD1306_ADDR    0x3C                                //!< SSD1306 device address
+#define SSD1306_ADDR    CONFIG_SSD1306_I2C_ADDRESS          //!< SSD1306 device address
 #define SSD1306_CMD     0x00                                //!< command register address
 #define SSD1306_DATA    0x40                                //!< data register address
+#define SSD1306_CMD_CO  0x80                                //!< control byte: one command follows, then another control byte
 
 #define WRITE_BIT       I2C_MASTER_WRITE                    //!< I2C write
 #define ACK_CHECK_EN    0x1                                 //!< I2C master will check ack from slave
 #define ACK_CHECK_DIS   0x0                                 //!< I2C master will not check ack from slave
 
+#if defined(CONFIG_SSD1306_GEOMETRY_128X32)
+#define SCREEN_WIDTH    128                                 // geometry of the default panel
+#define SCREEN_HEIGHT   32
+#elif defined(CONFIG_SSD1306_GEOMETRY_64X48)
+#define SCREEN_WIDTH    64
+#define SCREEN_HEIGHT   48
+#elif defined(CONFIG_SSD1306_GEOMETRY_72X40)
+#define SCREEN_WIDTH    72
+#define SCREEN_HEIGHT   40
+#else
 #define SCREEN_WIDTH    128
 #define SCREEN_HEIGHT   64
-#define BUFFER_SIZE     (SCREEN_WIDTH * SCREEN_HEIGHT / 8)  // 128 columns × 8 pages
+#endif
+#define SCREEN_PAGES    (SCREEN_HEIGHT / 8)                 // 8 rows of pixels per page
+#define BUFFER_SIZE     (SCREEN_WIDTH * SCREEN_HEIGHT / 8)  // SCREEN_WIDTH columns × SCREEN_PAGES pages
+
+#define SSD1306_GDDRAM_WIDTH    128                         //!< columns of the controller's display RAM
+#define SSD1306_GDDRAM_PAGES    8                           //!< pages of the controller's display RAM
+
+#ifdef CONFIG_SSD1306_FIXED_GEOMETRY
+#define SSD1306_MAX_WIDTH   SCREEN_WIDTH                    //!< every panel is the configured one
+#define SSD1306_MAX_HEIGHT  SCREEN_HEIGHT
+#else
+#define SSD1306_MAX_WIDTH   SSD1306_GDDRAM_WIDTH            //!< widest panel the controller drives
+#define SSD1306_MAX_HEIGHT  (8 * SSD1306_GDDRAM_PAGES)      //!< tallest panel the controller drives
+#endif
+#define SSD1306_MAX_PAGES   (SSD1306_MAX_HEIGHT / 8)
+#define SSD1306_CLIP_DEPTH  4                               //!< nested ssd1306_push_clip() / ssd1306_push_viewport() calls per panel
+#define SSD1306_POLYGON_MAX_POINTS  16                      //!< vertices ssd1306_draw_filled_polygon() takes
+#define SSD1306_WAIT_FOREVER        UINT32_MAX              //!< ssd1306_wait_flush() timeout that never expires
 
 #define COLOR_WHITE     1                                   // pixel on
 #define COLOR_BLACK     0                                   // pixel off
 
+// --- Statistics ---
+#ifndef SSD1306_ENABLE_STATS
+#define SSD1306_ENABLE_STATS        0                       //!< 1 to count transactions, flush times and drawing work
+#endif
+#define SSD1306_STATS_HIST_BUCKETS  8                       //!< flush duration histogram buckets
+#define SSD1306_STATS_HIST_BASE_US  500                     //!< bucket i holds flushes under (500 << i) µs, the last one the rest
+
+// --- Types ---
+/**
+ * @brief Called from the flush task once an asynchronous flush has reached the display.
+ */
+typedef void (*ssd1306_flush_cb_t)(void* arg);
+
+/**
+ * @brief What one ssd1306_render_paged() call used.
+ */
+typedef struct {
+    uint16_t ram_bytes;                         //!< band plus the panel state saved meanwhile; a framebuffer takes buffer_size
+    uint8_t band_pages;                         //!< pages rendered per pass
+    uint8_t passes;                             //!< times the draw callback ran
+} ssd1306_paged_stats_t;
+
+/**
+ * @brief Direction of a hardware scroll.
+ */
+typedef enum {
+    SSD1306_SCROLL_RIGHT,                       //!< horizontal, content moves right
+    SSD1306_SCROLL_LEFT,                        //!< horizontal, content moves left
+    SSD1306_SCROLL_DIAG_RIGHT,                  //!< right and up through the vertical scroll area
+    SSD1306_SCROLL_DIAG_LEFT                    //!< left and up through the vertical scroll area
+} ssd1306_scroll_dir_t;
+
+/**
+ * @brief Time between two scroll steps, in frames (values are the controller's encoding).
+ */
+typedef enum {
+    SSD1306_SCROLL_2_FRAMES   = 0x07,
+    SSD1306_SCROLL_3_FRAMES   = 0x04,
+    SSD1306_SCROLL_4_FRAMES   = 0x05,
+    SSD1306_SCROLL_5_FRAMES   = 0x00,
+    SSD1306_SCROLL_25_FRAMES  = 0x06,
+    SSD1306_SCROLL_64_FRAMES  = 0x01,
+    SSD1306_SCROLL_128_FRAMES = 0x02,
+    SSD1306_SCROLL_256_FRAMES = 0x03
+} ssd1306_scroll_speed_t;
+
+/**
+ * @brief How a drawing function combines its shape with the framebuffer, passed as its color.
+ * 
+ * Applied to whole framebuffer bytes in every drawing path. COLOR_WHITE and COLOR_BLACK are
+ * SSD1306_DRAW_SET and SSD1306_DRAW_CLEAR. A cursor or sprite drawn with SSD1306_DRAW_XOR is erased
+ * by drawing it again, whatever it was drawn over.
+ */
+typedef enum {
+    SSD1306_DRAW_CLEAR = COLOR_BLACK,           //!< pixels of the shape are turned off
+    SSD1306_DRAW_SET = COLOR_WHITE,             //!< pixels of the shape are turned on
+    SSD1306_DRAW_XOR,                           //!< pixels of the shape are toggled
+    SSD1306_DRAW_INVERT                         //!< inverse video: pixels of the shape off, the rest of its character cell or bitmap on
+} ssd1306_draw_mode_t;
+
+/**
+ * @brief How the driver reaches the panels.
+ * 
+ * The default, ssd1306_i2c_transport, uses the ESP8266 I2C driver. Host builds plug in a simulator instead.
+ */
+typedef struct {
+    esp_err_t (*init)(void* ctx);               //!< brings up the bus, called once before the first panel is initialized (may be NULL)
+    esp_err_t (*write)(void* ctx, i2c_port_t i2c_num, uint8_t address,
+                       const uint8_t* prefix, size_t prefix_len,
+                       const uint8_t* data, size_t data_len);   //!< one transaction: address, control/command bytes, then data
+    void* ctx;                                  //!< passed to every call
+} ssd1306_transport_t;
+
+/**
+ * @brief Bus, address and geometry of a panel, passed to ssd1306_dev_init().
+ */
+typedef struct {
+    i2c_port_t i2c_num;                         //!< I2C port the panel is on
+    uint8_t address;                            //!< 7-bit device address (0x3C or 0x3D)
+    uint8_t width;                              //!< width in pixels, up to SSD1306_MAX_WIDTH
+    uint8_t height;                             //!< height in pixels, a multiple of 8 up to SSD1306_MAX_HEIGHT
+    uint8_t* buffer;                            //!< width * height / 8 bytes, or NULL to allocate one
+    uint8_t col_offset;                         //!< first GDDRAM column the panel shows (32 on 64x48, 28 on 72x40 panels)
+    uint8_t multiplex;                          //!< COM lines driven, 0 for the height
+    uint8_t com_pins;                           //!< COM pin configuration (0xDA argument), 0 for the usual one for the height
+} ssd1306_config_t;
+
+/**
+ * @brief Clip rectangle and drawing origin of a panel, see ssd1306_push_clip().
+ */
+typedef struct {
+    int16_t x0, y0;                             //!< top-left pixel of the clip, screen coordinates
+    int16_t x1, y1;                             //!< bottom-right pixel, inclusive; x1 < x0 clips everything
+    int16_t origin_x, origin_y;                 //!< screen position of drawing coordinate (0, 0)
+} ssd1306_clip_t;
+
+/**
+ * @brief A panel and its framebuffer.
+ * 
+ * Fields are managed by the driver; read them, but do not change them.
+ */
+typedef struct {
+    i2c_port_t i2c_num;
+    uint8_t address;
+    uint8_t width;
+    uint8_t height;
+    uint8_t pages;                              //!< height / 8
+    uint8_t* buffer;                            //!< framebuffer, one byte per column and page
+    size_t buffer_size;                         //!< width * pages
+    uint8_t col_offset;                         //!< GDDRAM column of x = 0
+    uint8_t multiplex;
+    uint8_t com_pins;
+    uint8_t clock;                              //!< display clock (0xD5 argument) last sent by the driver
+    uint8_t precharge;                          //!< pre-charge period (0xD9 argument) last sent by the driver
+
+    uint8_t dirty_start[SSD1306_MAX_PAGES];     //!< first dirty column per page
+    uint8_t dirty_end[SSD1306_MAX_PAGES];       //!< one past the last dirty column, 0 if the page is clean
+    uint8_t addr_mode;                          //!< memory addressing mode the panel is in (0x20 argument)
+
+    // Diff flush (see ssd1306_diff_flush_start())
+    uint8_t* shadow;                            //!< copy of what GDDRAM shows, NULL unless diff flushing
+    uint8_t shadow_stale;                       //!< bit per page whose dirty span may differ from the shadow
+
+    // Asynchronous flush (see ssd1306_flush_task_start())
+    uint8_t* back_buffer;
+    uint8_t back_dirty_start[SSD1306_MAX_PAGES];
+    uint8_t back_dirty_end[SSD1306_MAX_PAGES];
+    SemaphoreHandle_t flush_request;
+    SemaphoreHandle_t flush_idle;
+    ssd1306_flush_cb_t flush_cb;
+    void* flush_cb_arg;
+
+    // Hardware scroll (see ssd1306_scroll_start())
+    bool scrolling;                             //!< GDDRAM is locked, flushes are held back
+    uint8_t scroll_first_page;
+    uint8_t scroll_last_page;
+
+    // Clipping (see ssd1306_push_clip())
+    ssd1306_clip_t clip;                        //!< applies to all drawing functions
+    ssd1306_clip_t clip_stack[SSD1306_CLIP_DEPTH];
+    uint8_t clip_depth;
+
+    // Page streaming (see ssd1306_render_paged())
+    uint8_t band_first_page;                    //!< page buffer[0] belongs to while a band is drawn, 0 otherwise
+    uint8_t band_pages;                         //!< pages buffer holds while a band is drawn, 0 otherwise
+} ssd1306_t;
+
+/**
+ * @brief Draws the whole screen on dev; called by ssd1306_render_paged() once per band of pages.
+ */
+typedef void (*ssd1306_page_draw_cb_t)(ssd1306_t* dev, void* arg);
+
+/**
+ * @brief Drawing primitives counted in ssd1306_stats_t.calls.
+ */
+typedef enum {
+    SSD1306_PRIM_PIXEL,                         //!< ssd1306_draw_pixel()
+    SSD1306_PRIM_CHAR,                          //!< ssd1306_draw_char(), once per glyph of a string
+    SSD1306_PRIM_RECT,                          //!< filled and empty rectangles, rounded or not
+    SSD1306_PRIM_LINE,                          //!< lines, horizontal and vertical lines
+    SSD1306_PRIM_CIRCLE,                        //!< filled and empty circles and ellipses, arcs
+    SSD1306_PRIM_TRIANGLE,                      //!< filled and empty triangles
+    SSD1306_PRIM_CLEAR,                         //!< ssd1306_clear()
+    SSD1306_PRIM_BITMAP,                        //!< raw and compressed bitmaps
+    SSD1306_PRIM_POLYGON,                       //!< filled polygons
+    SSD1306_PRIM_COUNT
+} ssd1306_primitive_t;
+
+/**
+ * @brief Counters kept since boot or the last ssd1306_stats_reset(), across all panels.
+ * 
+ * Only collected when the driver is built with SSD1306_ENABLE_STATS set to 1.
+ */
+typedef struct {
+    uint32_t cmd_transactions;                  //!< transactions carrying only commands
+    uint32_t data_transactions;                 //!< transactions carrying GDDRAM data
+    uint32_t cmd_bytes;                         //!< control and command bytes sent
+    uint32_t data_bytes;                        //!< GDDRAM bytes sent
+
+    uint32_t flushes;                           //!< flushes that sent anything
+    uint32_t flush_min_us;
+    uint32_t flush_avg_us;
+    uint32_t flush_max_us;
+    uint64_t flush_total_us;
+    uint32_t flush_hist[SSD1306_STATS_HIST_BUCKETS];    //!< flush durations, see SSD1306_STATS_HIST_BASE_US
+
+    uint32_t calls[SSD1306_PRIM_COUNT];         //!< public drawing calls per primitive
+    uint32_t pixels;                            //!< pixels touched in the framebuffer, clipped
+
+    uint32_t i2c_errors;                        //!< failed transactions other than timeouts
+    uint32_t i2c_timeouts;                      //!< transactions that timed out
+} ssd1306_stats_t;
+
+/**
+ * @brief A vertex of ssd1306_draw_filled_polygon().
+ */
+typedef struct {
+    int16_t x;
+    int16_t y;
+} ssd1306_point_t;
+
+/**
+ * @brief Metrics and bitmap of one glyph of an ssd1306_font_t.
+ */
+typedef struct {
+    uint16_t offset;                            //!< first byte of the bitmap in ssd1306_font_t.bitmaps
+    uint8_t width;                              //!< bitmap columns, 0 for blank glyphs such as space
+    uint8_t height;                             //!< bitmap rows
+    int8_t x_offset;                            //!< left edge of the bitmap, relative to the pen position
+    int8_t y_offset;                            //!< top row of the bitmap, relative to the top of the line
+    uint8_t advance;                            //!< distance from this pen position to the next
+} ssd1306_glyph_t;
+
+/**
+ * @brief A bitmap font, monospace or proportional, of any height up to the panel's.
+ * 
+ * Each glyph's bitmap is in the display's page layout (like ssd1306_draw_bitmap()): (height + 7) / 8
+ * rows of width bytes, bit 0 on top. host/font2c.py generates fonts from BDF and TrueType files.
+ */
+typedef struct {
+    const uint8_t* bitmaps;                     //!< all glyph bitmaps
+    const ssd1306_glyph_t* glyphs;              //!< one entry per character from first to last
+    uint8_t first;                              //!< first character code
+    uint8_t last;                               //!< last character code
+    uint8_t height;                             //!< line height in pixels
+    uint8_t baseline;                           //!< rows from the top of the line to the baseline
+} ssd1306_font_t;
+
 // --- Font ---
 extern const char font5x7[];
+extern const ssd1306_font_t ssd1306_font_5x7;                   // font5x7 as a descriptor: 8 px line, 6 px advance
+extern const ssd1306_font_t ssd1306_font_sans16;                // DejaVu Sans, proportional, 19 px line
+extern const ssd1306_font_t ssd1306_font_sans_bold24_digits;    // DejaVu Sans Bold, ' ' to ':' only, 28 px line
 
 // --- Framebuffer ---
-extern uint8_t buffer[BUFFER_SIZE];
+#ifdef CONFIG_SSD1306_FRAMEBUFFER_STATIC
+extern uint8_t buffer[BUFFER_SIZE];         // framebuffer of ssd1306_default; heap builds only have ssd1306_default.buffer
+#endif
+
+// --- Transport ---
+extern const ssd1306_transport_t ssd1306_i2c_transport;   // ESP8266 I2C master on I2C_SCL_IO/I2C_SDA_IO
+
+// --- Devices ---
+extern ssd1306_t ssd1306_default;   // the SCREEN_WIDTH x SCREEN_HEIGHT panel at SSD1306_ADDR, drawing into buffer
 
 // --- Function Prototypes ---
 /**
  * @brief Initializes the I2C protocol (config and installation)
  * 
+ * Called once by ssd1306_init() through ssd1306_i2c_transport.
+ * 
  * @return esp_err_t ESP_OK if initialized successfully
  */
 esp_err_t i2c_init(void);
 
 
+/**
+ * @brief Number of I2C command links ssd1306_i2c_transport has built so far.
+ * 
+ * Each one is a round of heap allocations. Links are pooled by transaction shape (address and
+ * length), CONFIG_SSD1306_I2C_LINK_POOL of them, so once a display loop that flushes the same
+ * spans every frame has run a few frames this count stops moving; log it to check. Loops that
+ * produce more shapes than that rebuild links as they go.
+ * 
+ * @return uint32_t Command links built since boot.
+ */
+uint32_t ssd1306_i2c_get_alloc_count(void);
+
+
+/**
+ * @brief Replaces the transport used to reach the panels.
+ * 
+ * Must be called before ssd1306_init() / ssd1306_dev_init().
+ * 
+ * @param transport The transport to use from now on.
+ */
+void ssd1306_set_transport(const ssd1306_transport_t* transport);
+
+
 /**
  * @brief A wrapper for i2c_master_write specifically designed for ssd1306
  * 
- * Writes data_len bytes targeting specific ssd1306 register
+ * Writes data_len bytes targeting specific ssd1306 register of ssd1306_default, through the current transport
  * 
  * @param i2c_num I2C port number to be used
  * @param reg_address the target register to be written into
@@ -67,6 +362,22 @@ esp_err_t i2c_init(void);
 void ssd1306_write(i2c_port_t i2c_num, uint8_t reg_address, uint8_t* data, size_t data_len);
 
 
+/**
+ * @brief Writes a list of commands followed by display data in a single I2C transaction.
+ * 
+ * Every command is sent behind its own SSD1306_CMD_CO control byte, then a single SSD1306_DATA
+ * control byte switches the rest of the transaction to GDDRAM data. This saves the start, address
+ * and stop overhead of sending the commands on their own.
+ * 
+ * @param i2c_num I2C port number to be used
+ * @param cmds the commands to be sent first (at most 16)
+ * @param cmd_len the number of commands
+ * @param data the display data to be sent after the commands
+ * @param data_len the length of the display data
+ */
+void ssd1306_write_cmd_data(i2c_port_t i2c_num, const uint8_t* cmds, size_t cmd_len, uint8_t* data, size_t data_len);
+
+
 /**
  * @brief Initializes the SSD1306 device with the proper initialization commands.
  * 
@@ -76,6 +387,22 @@ void ssd1306_write(i2c_port_t i2c_num, uint8_t reg_address, uint8_t* data, size_
 void ssd1306_init(void);
 
 
+/**
+ * @brief Initializes another SSD1306 device, e.g. a second panel at 0x3D or a 128x32 panel.
+ * 
+ * Installs the I2C driver if needed, allocates the framebuffer unless config->buffer is given,
+ * then sends the init sequence for the panel's geometry. A 128x32 panel only uses 512 bytes and
+ * its flushes only cover 4 pages.
+ * 
+ * @note Draw into it with the ssd1306_dev_*() variants below; the functions without the prefix work on ssd1306_default.
+ * 
+ * @param dev The device to initialize.
+ * @param config Bus, address and geometry of the panel.
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG on unsupported geometry, ESP_ERR_NO_MEM if allocation failed
+ */
+esp_err_t ssd1306_dev_init(ssd1306_t* dev, const ssd1306_config_t* config);
+
+
 /**
  * @brief Sends a command to the SSD1306 device.
  * 
@@ -84,6 +411,17 @@ void ssd1306_init(void);
 void ssd1306_cmd(uint8_t cmd);
 
 
+/**
+ * @brief Sends a list of commands to the SSD1306 device in a single I2C transaction.
+ * 
+ * Prefer this over repeated ssd1306_cmd() calls, each of which is a transaction of its own.
+ * 
+ * @param cmds An array of the commands (and their arguments) to be sent.
+ * @param len The length of the array.
+ */
+void ssd1306_cmd_list(const uint8_t* cmds, size_t len);
+
+
 /**
  * @brief Sends data to the SSD1306 device.
  * 
@@ -97,6 +435,8 @@ void ssd1306_data(uint8_t* data, size_t len);
  * @brief Clears the internal framebuffer.
  * 
  * Sets all bytes in the framebuffer to zero, effectively clearing the display content in memory.
+ * Only the columns that were lit are marked dirty, so clearing an empty screen costs no flush.
+ * The whole screen is cleared whatever the clip; use ssd1306_clear_region() to clear inside it.
  * 
  * @note Call ssd1306_display() afterward to reflect the changes on the actual screen.
  */
@@ -106,12 +446,238 @@ void ssd1306_clear(void);
 /**
  * @brief Displays the framebuffer.
  * 
- * Renders whatever in the framebuffer on the screen.
+ * Sends only the parts of the framebuffer that changed since the last flush. Every page keeps
+ * the first and last column touched by the drawing functions, and only that span is written
+ * to the display's GDDRAM.
  * 
+ * @note Code that writes into buffer directly must call ssd1306_mark_dirty() for the region it changed.
  */
 void ssd1306_display(void);
 
 
+/**
+ * @brief Displays the whole framebuffer, regardless of what changed.
+ * 
+ * Useful after the display lost its content (power cycle, reset) or to resync it with the framebuffer.
+ */
+void ssd1306_display_full(void);
+
+
+/**
+ * @brief Draws and sends the screen a band of pages at a time, without a full framebuffer.
+ *
+ * For each band the panel's buffer is pointed at band, which is zeroed, and the clip is narrowed to
+ * the band's rows; draw then runs and the band is sent in one transaction. All drawing functions
+ * clip against those rows, so draw simply draws the whole screen every time and only what falls in
+ * the band is kept. A one-page band costs width bytes instead of the framebuffer's width * pages, at
+ * the price of running draw once per page; a two-page band halves the passes.
+ *
+ * Every page is sent whole: whatever draw does not draw is blank. This works for panels with a
+ * framebuffer too (the framebuffer is left as it was), and is the only way to draw on the default
+ * panel when it is built without one (CONFIG_SSD1306_FRAMEBUFFER_NONE).
+ *
+ * @note draw must use the drawing functions only, on the panel it is passed. ssd1306_clear() clears the band; the flush
+ *       functions, the sprite compositor and anything else that reads the whole framebuffer must
+ *       not be used from it. The clip draw sees is the caller's, narrowed to the band.
+ *
+ * @param draw Draws the screen, or NULL to blank the panel.
+ * @param arg Argument passed to draw.
+ * @param band Buffer of whole pages (width bytes each), or NULL for a one-page band on the stack.
+ * @param band_size Bytes of band; the pages that fit, up to the panel's, are used.
+ * @param stats Receives what the call used, or NULL.
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG if band holds no whole page, ESP_ERR_INVALID_STATE while scrolling
+ */
+esp_err_t ssd1306_render_paged(ssd1306_page_draw_cb_t draw, void* arg, uint8_t* band, size_t band_size, ssd1306_paged_stats_t* stats);
+
+
+/**
+ * @brief Makes flushes send only the bytes that differ from what the panel shows.
+ * 
+ * Allocates a shadow copy of GDDRAM (width * pages bytes). Every flush then compares the dirty spans
+ * with it and picks the cheapest way to address what changed: one horizontal-mode window around all
+ * changes, or page-mode runs (0xB0 | page and two column nibbles), where runs separated by fewer
+ * unchanged bytes than a new transaction costs are merged. Redrawing identical content sends nothing.
+ * Applies to ssd1306_display() and ssd1306_display_async().
+ * 
+ * @note The driver tracks the addressing mode; do not send 0x20 through ssd1306_cmd() while diffing.
+ * 
+ * @return ESP_OK, ESP_ERR_INVALID_STATE while scrolling or without a framebuffer, ESP_ERR_NO_MEM if the shadow cannot be allocated
+ */
+esp_err_t ssd1306_diff_flush_start(void);
+
+
+/**
+ * @brief Frees the shadow copy; flushes send the dirty spans again.
+ */
+void ssd1306_diff_flush_stop(void);
+
+
+/**
+ * @brief Starts the task that performs asynchronous flushes.
+ * 
+ * Allocates a back buffer the size of the panel's framebuffer (dev->buffer_size bytes, BUFFER_SIZE for
+ * the default panel) that the task sends while the caller keeps drawing into the framebuffer. Call
+ * once, after ssd1306_init(). If it fails, nothing stays allocated and flushes remain synchronous.
+ * 
+ * @param priority FreeRTOS priority of the flush task.
+ * @return esp_err_t ESP_OK if started, ESP_ERR_INVALID_STATE if already running or without a framebuffer, ESP_ERR_NO_MEM otherwise
+ */
+esp_err_t ssd1306_flush_task_start(UBaseType_t priority);
+
+
+/**
+ * @brief Hands the changed parts of the framebuffer to the flush task and returns.
+ * 
+ * The dirty spans are copied into the back buffer, so drawing the next frame can start right away
+ * while the current one is on the bus. If the previous flush is still running, this waits for it.
+ * 
+ * @return esp_err_t ESP_OK if queued, ESP_ERR_INVALID_STATE if ssd1306_flush_task_start() was not called
+ */
+esp_err_t ssd1306_display_async(void);
+
+
+/**
+ * @brief Waits for the flush started by ssd1306_display_async() to complete.
+ * 
+ * @param timeout_ms Maximum time to wait in milliseconds, or SSD1306_WAIT_FOREVER.
+ * @return esp_err_t ESP_OK once no flush is pending, ESP_ERR_TIMEOUT otherwise
+ */
+esp_err_t ssd1306_wait_flush(uint32_t timeout_ms);
+
+
+/**
+ * @brief Sets a function to be called each time an asynchronous flush completes.
+ * 
+ * @note The callback runs in the flush task; keep it short.
+ * 
+ * @param cb The callback, or NULL to remove it.
+ * @param arg Argument passed to the callback.
+ */
+void ssd1306_set_flush_callback(ssd1306_flush_cb_t cb, void* arg);
+
+
+/**
+ * @brief Starts a continuous hardware scroll of a range of pages.
+ * 
+ * The controller moves the content on its own, so a ticker or marquee costs no bus traffic per step.
+ * Pending changes are flushed first. While the scroll runs the controller's RAM must not be written,
+ * so ssd1306_display() keeps changes pending until ssd1306_scroll_stop().
+ * 
+ * @param dir Scroll direction.
+ * @param start_page First page (8-pixel row) to scroll.
+ * @param end_page Last page to scroll.
+ * @param speed Frames between two steps.
+ * @param vertical_offset Rows moved up per step for diagonal scrolls (ignored for horizontal ones).
+ * @return esp_err_t ESP_OK if started, ESP_ERR_INVALID_ARG on an invalid page range or offset,
+ *         or the error of waiting for a pending asynchronous flush (the scroll is not started then)
+ */
+esp_err_t ssd1306_scroll_start(ssd1306_scroll_dir_t dir, uint8_t start_page, uint8_t end_page, ssd1306_scroll_speed_t speed, uint8_t vertical_offset);
+
+
+/**
+ * @brief Sets the rows a diagonal scroll moves through.
+ * 
+ * @param fixed_rows Rows at the top that stay in place.
+ * @param scroll_rows Rows below them that scroll.
+ * @return esp_err_t ESP_OK, or ESP_ERR_INVALID_ARG if the area does not fit the panel
+ */
+esp_err_t ssd1306_scroll_set_vertical_area(uint8_t fixed_rows, uint8_t scroll_rows);
+
+
+/**
+ * @brief Stops the hardware scroll.
+ * 
+ * The scroll shifted the panel's RAM, so the scrolled pages are marked dirty; call ssd1306_display()
+ * afterward to restore them from the framebuffer along with any changes held back meanwhile.
+ */
+void ssd1306_scroll_stop(void);
+
+
+/**
+ * @brief Tells whether a hardware scroll is running.
+ * 
+ * @return true between ssd1306_scroll_start() and ssd1306_scroll_stop()
+ */
+bool ssd1306_is_scrolling(void);
+
+
+/**
+ * @brief Marks a region of the framebuffer as changed so the next ssd1306_display() sends it.
+ * 
+ * The drawing functions do this on their own; call it only after writing into buffer directly.
+ * 
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ * @param w Width of the region.
+ * @param h Height of the region.
+ */
+void ssd1306_mark_dirty(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+
+/**
+ * @brief Copies the performance counters.
+ * 
+ * @param out Receives the counters; zeroed when statistics are compiled out.
+ * @return ESP_OK, or ESP_ERR_NOT_SUPPORTED if SSD1306_ENABLE_STATS is 0.
+ */
+esp_err_t ssd1306_stats_get(ssd1306_stats_t* out);
+
+
+/**
+ * @brief Zeroes the performance counters.
+ */
+void ssd1306_stats_reset(void);
+
+
+/**
+ * @brief Adds to ssd1306_stats_t.pixels, for modules that write the framebuffer without the drawing functions.
+ * 
+ * @param pixels Pixels written, after clipping. Ignored when statistics are compiled out.
+ */
+void ssd1306_stats_add_pixels(uint32_t pixels);
+
+
+/**
+ * @brief Restricts drawing to a rectangle until the matching ssd1306_pop_clip().
+ * 
+ * The rectangle is given in drawing coordinates and intersected with the current clip, so nested
+ * clips only ever shrink. Every drawing function clips its shape against it analytically and skips
+ * shapes entirely outside it, so drawing offscreen or hidden parts costs next to nothing.
+ * 
+ * @param x Left edge.
+ * @param y Top edge.
+ * @param w Width; 0 clips everything.
+ * @param h Height; 0 clips everything.
+ * @return ESP_OK, or ESP_ERR_NO_MEM if SSD1306_CLIP_DEPTH clips are already pushed.
+ */
+esp_err_t ssd1306_push_clip(int x, int y, int w, int h);
+
+
+/**
+ * @brief Like ssd1306_push_clip(), and also moves the drawing origin to the rectangle's corner.
+ * 
+ * Until the matching ssd1306_pop_clip(), (0, 0) is the top-left pixel of the viewport, so a widget
+ * can draw itself in its own coordinates wherever it is placed.
+ * 
+ * @return ESP_OK, or ESP_ERR_NO_MEM if SSD1306_CLIP_DEPTH clips are already pushed.
+ */
+esp_err_t ssd1306_push_viewport(int x, int y, int w, int h);
+
+
+/**
+ * @brief Restores the clip and origin in effect before the last push.
+ * 
+ * @return ESP_OK, or ESP_ERR_INVALID_STATE if nothing was pushed.
+ */
+esp_err_t ssd1306_pop_clip(void);
+
+
+/**
+ * @brief Drops all pushed clips: the whole screen is drawable again, with the origin in its corner.
+ */
+void ssd1306_reset_clip(void);
+
+
 
 /**
  * @brief Draws a single pixel on the screen.
@@ -122,7 +688,7 @@ void ssd1306_display(void);
  * @param y 
  * @param color 
  */
-void ssd1306_draw_pixel(uint8_t x, uint8_t y, bool color);
+void ssd1306_draw_pixel(uint8_t x, uint8_t y, ssd1306_draw_mode_t color);
 
 
 /**
@@ -135,9 +701,9 @@ void ssd1306_draw_pixel(uint8_t x, uint8_t y, bool color);
  * @param c Character to draw.
  * @param size_x Horizontal scaling factor.
  * @param size_y Vertical scaling factor.
- * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off).
+ * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off) or draw mode.
  */
-void ssd1306_draw_char(uint8_t x, uint8_t y, char c, uint8_t size_x, uint8_t size_y, bool color);
+void ssd1306_draw_char(uint8_t x, uint8_t y, char c, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color);
 
 
 /**
@@ -150,14 +716,18 @@ void ssd1306_draw_char(uint8_t x, uint8_t y, char c, uint8_t size_x, uint8_t siz
  * @param str Null-terminated string to draw.
  * @param size_x Horizontal scaling factor.
  * @param size_y Vertical scaling factor.
- * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off).
+ * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off) or draw mode.
  */
-void ssd1306_draw_string(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, bool color);
+void ssd1306_draw_string(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color);
 
 
 /**
  * @brief Draws a wrapped string, breaking lines if the text exceeds the screen width.
  * 
+ * Lines break at whatever character reaches the edge, so existing screens keep their exact output,
+ * and any size_x/size_y scale works, which a layout font cannot express. For word wrap, measure the
+ * text with ssd1306_layout_init() and SSD1306_LAYOUT_WRAP and draw it with ssd1306_layout_draw().
+ * 
  * @note Call ssd1306_display() afterward to render the string on the actual screen.
  * 
  * @param x Starting X-coordinate.
@@ -165,14 +735,16 @@ void ssd1306_draw_string(uint8_t x, uint8_t y, const char* str, uint8_t size_x,
  * @param str String to draw.
  * @param size_x Horizontal scaling factor.
  * @param size_y Vertical scaling factor.
- * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off).
+ * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off) or draw mode.
  */
-void ssd1306_draw_string_wrapped(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, bool color);
+void ssd1306_draw_string_wrapped(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color);
 
 
 /**
  * @brief Draws a string character-by-character with a delay between each character.
  * 
+ * Blocks until the last character is shown; see ssd1306_anim.h for the non-blocking version.
+ * 
  * @note No need to call ssd1306_display() afterward.
  * 
  * @param x Starting X-coordinate.
@@ -181,14 +753,16 @@ void ssd1306_draw_string_wrapped(uint8_t x, uint8_t y, const char* str, uint8_t
  * @param size_x Horizontal scaling factor.
  * @param size_y Vertical scaling factor.
  * @param tick_delay_ms Delay in milliseconds between characters.
- * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off).
+ * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off) or draw mode.
  */
-void ssd1306_draw_string_char_by_char(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, bool color);
+void ssd1306_draw_string_char_by_char(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color);
 
 
 /**
  * @brief Draws a wrapped string character-by-character with a delay.
  * 
+ * Breaks lines like ssd1306_draw_string_wrapped(); ssd1306_anim_layout_init() animates a word-wrapped layout.
+ * 
  * @note No need to call ssd1306_display() afterward.
  * 
  * @param x Starting X-coordinate.
@@ -197,9 +771,9 @@ void ssd1306_draw_string_char_by_char(uint8_t x, uint8_t y, const char* str, uin
  * @param size_x Horizontal scaling factor.
  * @param size_y Vertical scaling factor.
  * @param tick_delay_ms Delay between each character in milliseconds.
- * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off).
+ * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off) or draw mode.
  */
-void ssd1306_draw_string_wrapped_char_by_char(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, bool color);
+void ssd1306_draw_string_wrapped_char_by_char(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color);
 
 
 /**
@@ -211,9 +785,9 @@ void ssd1306_draw_string_wrapped_char_by_char(uint8_t x, uint8_t y, const char*
  * @param str String to draw.
  * @param size_x Horizontal scaling factor.
  * @param size_y Vertical scaling factor.
- * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off).
+ * @param color Pixel color (COLOR_WHITE = on, COLOR_BLACK = off) or draw mode.
  */
-void ssd1306_draw_string_centered(uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, bool color);
+void ssd1306_draw_string_centered(uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color);
 
 
 /**
@@ -226,9 +800,9 @@ void ssd1306_draw_string_centered(uint8_t y, const char* str, uint8_t size_x, ui
  * @param size_x Horizontal scaling factor.
  * @param size_y Vertical scaling factor.
  * @param tick_delay_ms Delay between each character in milliseconds.
- * @param Pixel color (COLOR_WHITE = on, COLOR_BLACK = off).
+ * @param Pixel color (COLOR_WHITE = on, COLOR_BLACK = off) or draw mode.
  */
-void ssd1306_draw_string_centered_char_by_char(uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, bool color);
+void ssd1306_draw_string_centered_char_by_char(uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color);
 
 
 /**
@@ -242,6 +816,107 @@ uint8_t ssd1306_get_string_width(const char* str, uint8_t size_x);
 
 
 
+/**
+ * @brief Draws a 1bpp bitmap; set bits are drawn in color, clear bits leave the framebuffer as is.
+ * 
+ * The bitmap uses the display's own layout: (h + 7) / 8 rows of w bytes, each byte a column of
+ * 8 pixels with bit 0 on top. Bitmaps at a y that is a multiple of 8 are copied byte for byte;
+ * others are shifted across two pages. Parts outside the screen are clipped. SSD1306_DRAW_INVERT
+ * draws the bitmap's negative over its w × h box.
+ * 
+ * @note Call ssd1306_display() afterward to render the bitmap on the actual screen.
+ * 
+ * @param x X-coordinate of the top-left corner, may be negative.
+ * @param y Y-coordinate of the top-left corner, may be negative.
+ * @param bitmap w * ((h + 7) / 8) bytes.
+ * @param w Width of the bitmap.
+ * @param h Height of the bitmap.
+ * @param color Pixel color or draw mode of the set bits.
+ */
+void ssd1306_draw_bitmap(int x, int y, const uint8_t* bitmap, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws a PackBits-compressed bitmap, decoding it straight into the framebuffer.
+ * 
+ * The stream compresses the byte sequence ssd1306_draw_bitmap() takes. Each header byte n is followed
+ * by n + 1 literal bytes if n < 128, or by one byte repeated 257 - n times if n > 128; 128 is skipped.
+ * host/bitmap2c.py converts PBM and PNG images into this format.
+ * 
+ * @note Call ssd1306_display() afterward to render the bitmap on the actual screen.
+ * 
+ * @param x X-coordinate of the top-left corner, may be negative.
+ * @param y Y-coordinate of the top-left corner, may be negative.
+ * @param data The compressed stream.
+ * @param len Length of the stream in bytes.
+ * @param w Width of the bitmap.
+ * @param h Height of the bitmap.
+ * @param color Pixel color or draw mode of the set bits.
+ */
+void ssd1306_draw_bitmap_rle(int x, int y, const uint8_t* data, size_t len, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws one character in the given font; set pixels are drawn in color, the rest is left as is.
+ * 
+ * With SSD1306_DRAW_INVERT the character cell (advance × line height) is lit and the glyph cleared.
+ * 
+ * @note Call ssd1306_display() afterward to render the character on the actual screen.
+ * 
+ * @param x Pen position (left edge of the character cell), may be negative.
+ * @param y Top of the line, may be negative.
+ * @param font The font to draw with.
+ * @param c The character; characters the font lacks draw nothing.
+ * @param color Pixel color or draw mode.
+ * @return int The advance to the next pen position.
+ */
+int ssd1306_draw_char_font(int x, int y, const ssd1306_font_t* font, char c, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws a string in the given font on one line.
+ * 
+ * @note Call ssd1306_display() afterward to render the string on the actual screen.
+ * 
+ * @param x Pen position of the first character.
+ * @param y Top of the line.
+ * @param font The font to draw with.
+ * @param str The string to draw.
+ * @param color Pixel color or draw mode.
+ * @return int The pen position after the last character drawn.
+ */
+int ssd1306_draw_string_font(int x, int y, const ssd1306_font_t* font, const char* str, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws a string in the given font, centered horizontally.
+ * 
+ * @note Call ssd1306_display() afterward to render the string on the actual screen.
+ * 
+ * @param y Top of the line.
+ * @param font The font to draw with.
+ * @param str The string to draw.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_draw_string_font_centered(int y, const ssd1306_font_t* font, const char* str, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Returns the advance of a character in the given font, 0 if the font lacks it.
+ */
+uint8_t ssd1306_font_char_width(const ssd1306_font_t* font, char c);
+
+
+/**
+ * @brief Measures a string in the given font: the sum of its characters' advances.
+ * 
+ * @param font The font to measure with.
+ * @param str The string to measure.
+ * @return uint16_t Width of the string in pixels.
+ */
+uint16_t ssd1306_font_string_width(const ssd1306_font_t* font, const char* str);
+
+
 /**
  * @brief Draws a filled rectangle.
  * 
@@ -251,9 +926,9 @@ uint8_t ssd1306_get_string_width(const char* str, uint8_t size_x);
  * @param y Y-coordinate of the top-left corner.
  * @param w Width of the rectangle.
  * @param h Height of the rectangle.
- * @param color Pixel color.
+ * @param color Pixel color or draw mode.
  */
-void ssd1306_draw_full_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color);
+void ssd1306_draw_full_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
 
 
 /**
@@ -265,9 +940,71 @@ void ssd1306_draw_full_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool col
  * @param y Y-coordinate of the top-left corner.
  * @param w Width of the rectangle.
  * @param h Height of the rectangle.
- * @param color Pixel color.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_draw_empty_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Clears a rectangular region of the framebuffer.
+ * 
+ * @note Call ssd1306_display() afterward to render the cleared region on the actual screen.
+ * 
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ * @param w Width of the region.
+ * @param h Height of the region.
+ */
+void ssd1306_clear_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+
+/**
+ * @brief Draws a filled rectangle with rounded corners.
+ * 
+ * The corners are quarters of the filled circle of the given radius, which is limited to
+ * (min(w, h) - 1) / 2.
+ * 
+ * @note Call ssd1306_display() afterward to render the rectangle on the actual screen.
+ * 
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ * @param w Width of the rectangle.
+ * @param h Height of the rectangle.
+ * @param radius Radius of the corners, 0 for square ones.
+ * @param color Pixel color or draw mode.
  */
-void ssd1306_draw_empty_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color);
+void ssd1306_draw_full_round_rect(int x, int y, uint8_t w, uint8_t h, uint8_t radius, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws the outline of a rectangle with rounded corners: the edge pixels of
+ *        ssd1306_draw_full_round_rect() with the same arguments.
+ * 
+ * @note Call ssd1306_display() afterward to render the rectangle on the actual screen.
+ * 
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ * @param w Width of the rectangle.
+ * @param h Height of the rectangle.
+ * @param radius Radius of the corners, 0 for square ones.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_draw_empty_round_rect(int x, int y, uint8_t w, uint8_t h, uint8_t radius, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Inverts a rectangular region of the framebuffer, e.g. to highlight a menu entry.
+ * 
+ * Inverting it again restores it.
+ * 
+ * @note Call ssd1306_display() afterward to render the inverted region on the actual screen.
+ * 
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ * @param w Width of the region.
+ * @param h Height of the region.
+ */
+void ssd1306_invert_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
 
 
 /**
@@ -278,9 +1015,9 @@ void ssd1306_draw_empty_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool co
  * @param x0 Center X-coordinate.
  * @param y0 Center Y-coordinate.
  * @param radius Radius of the circle.
- * @param color Pixel color.
+ * @param color Pixel color or draw mode.
  */
-void ssd1306_draw_full_circle(uint8_t x0, uint8_t y0, uint8_t radius, bool color);
+void ssd1306_draw_full_circle(uint8_t x0, uint8_t y0, uint8_t radius, ssd1306_draw_mode_t color);
 
 
 /**
@@ -291,9 +1028,61 @@ void ssd1306_draw_full_circle(uint8_t x0, uint8_t y0, uint8_t radius, bool color
  * @param x0 Center X-coordinate.
  * @param y0 Center Y-coordinate.
  * @param radius Radius of the circle.
- * @param color Pixel color.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_draw_empty_circle(uint8_t x0, uint8_t y0, uint8_t radius, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws a filled ellipse with horizontal and vertical axes.
+ * 
+ * Equal radii draw the same pixels as ssd1306_draw_full_circle().
+ * 
+ * @note Call ssd1306_display() afterward to render the ellipse on the actual screen.
+ * 
+ * @param x0 Center X-coordinate.
+ * @param y0 Center Y-coordinate.
+ * @param rx Horizontal radius.
+ * @param ry Vertical radius.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_draw_full_ellipse(int x0, int y0, uint8_t rx, uint8_t ry, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws the outline of an ellipse: the edge pixels of ssd1306_draw_full_ellipse() with the
+ *        same arguments, so the two line up when combined.
+ * 
+ * @note Call ssd1306_display() afterward to render the ellipse on the actual screen.
+ * 
+ * @param x0 Center X-coordinate.
+ * @param y0 Center Y-coordinate.
+ * @param rx Horizontal radius.
+ * @param ry Vertical radius.
+ * @param color Pixel color or draw mode.
  */
-void ssd1306_draw_empty_circle(uint8_t x0, uint8_t y0, uint8_t radius, bool color);
+void ssd1306_draw_empty_ellipse(int x0, int y0, uint8_t rx, uint8_t ry, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws a filled arc: the part of a ring between two angles.
+ * 
+ * Angles are in degrees, 0 pointing right and increasing clockwise (90 points down). The arc runs
+ * clockwise from start_angle to end_angle; a span of 360 degrees or more draws the whole ring, equal
+ * angles draw nothing. An inner radius of 0 draws a pie slice, radius - inner_radius + 1 is the
+ * thickness of the ring otherwise. Gauges and progress rings are arcs redrawn with a moving end angle.
+ * 
+ * @note Call ssd1306_display() afterward to render the arc on the actual screen.
+ * 
+ * @param x0 Center X-coordinate.
+ * @param y0 Center Y-coordinate.
+ * @param radius Outer radius.
+ * @param inner_radius Inner radius, up to radius.
+ * @param start_angle Start of the arc, in degrees.
+ * @param end_angle End of the arc, in degrees.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_draw_arc(int x0, int y0, uint8_t radius, uint8_t inner_radius, int16_t start_angle, int16_t end_angle, ssd1306_draw_mode_t color);
 
 
 /**
@@ -305,9 +1094,9 @@ void ssd1306_draw_empty_circle(uint8_t x0, uint8_t y0, uint8_t radius, bool colo
  * @param y0 Starting Y-coordinate.
  * @param x1 Ending X-coordinate.
  * @param y1 Ending Y-coordinate.
- * @param color Pixel color.
+ * @param color Pixel color or draw mode.
  */
-void ssd1306_draw_line(int x0, int y0, int x1, int y1, bool color);
+void ssd1306_draw_line(int x0, int y0, int x1, int y1, ssd1306_draw_mode_t color);
 
 
 /**
@@ -318,9 +1107,22 @@ void ssd1306_draw_line(int x0, int y0, int x1, int y1, bool color);
  * @param x_start Starting X-coordinate.
  * @param x_end Ending X-coordinate.
  * @param y Y-coordinate for the line.
- * @param color Pixel color.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_draw_horizontal_line(int x_start, int x_end, int y, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws a vertical line.
+ * 
+ * @note Call ssd1306_display() afterward to render the line on the actual screen.
+ * 
+ * @param x X-coordinate for the line.
+ * @param y_start Starting Y-coordinate.
+ * @param y_end Ending Y-coordinate.
+ * @param color Pixel color or draw mode.
  */
-void ssd1306_draw_horizontal_line(int x_start, int x_end, int y, bool color);
+void ssd1306_draw_vertical_line(int x, int y_start, int y_end, ssd1306_draw_mode_t color);
 
 
 /**
@@ -334,9 +1136,9 @@ void ssd1306_draw_horizontal_line(int x_start, int x_end, int y, bool color);
  * @param y1 Y of point 2.
  * @param x2 X of point 3.
  * @param y2 Y of point 3.
- * @param color Pixel color.
+ * @param color Pixel color or draw mode.
  */
-void ssd1306_draw_empty_triangle(int x0, int y0, int x1, int y1, int x2, int y2, bool color);
+void ssd1306_draw_empty_triangle(int x0, int y0, int x1, int y1, int x2, int y2, ssd1306_draw_mode_t color);
 
 
 /**
@@ -350,15 +1152,34 @@ void ssd1306_draw_empty_triangle(int x0, int y0, int x1, int y1, int x2, int y2,
  * @param y1 Y of point 2.
  * @param x2 X of point 3.
  * @param y2 Y of point 3.
- * @param color Pixel color.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_draw_filled_triangle(int x0, int y0, int x1, int y1, int x2, int y2, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws a filled polygon, convex or not.
+ * 
+ * The inside follows the even-odd rule, so the loops of a self-intersecting polygon alternate
+ * between filled and empty. The edges themselves are always drawn, which keeps thin parts visible.
+ * 
+ * @note Call ssd1306_display() afterward to render the polygon on the actual screen.
+ * 
+ * @param points The vertices in order; the last one connects back to the first.
+ * @param count Number of vertices, 3 to SSD1306_POLYGON_MAX_POINTS.
+ * @param color Pixel color or draw mode.
+ * @return esp_err_t ESP_OK, or ESP_ERR_INVALID_ARG if count is out of range
  */
-void ssd1306_draw_filled_triangle(int x0, int y0, int x1, int y1, int x2, int y2, bool color);
+esp_err_t ssd1306_draw_filled_polygon(const ssd1306_point_t* points, uint8_t count, ssd1306_draw_mode_t color);
 
 
 
 /**
  * @brief Overwrites a character on screen with a new one.
  * 
+ * The old glyph's pixels are cleared and the new one's set in a single pass when both have the
+ * same size; overwriting a character with itself changes nothing and costs no flush.
+ * 
  * @note Call ssd1306_display() afterward to render overwritten char on the actual screen.
  * 
  * @param x X-coordinate.
@@ -392,6 +1213,9 @@ void ssd1306_overwrite_string_char_by_char(uint8_t x, uint8_t y, const char* old
 /**
  * @brief Overwrites a wrapped string character-by-character.
  * 
+ * Breaks lines like ssd1306_draw_string_wrapped(); ssd1306_anim_layout_overwrite_init() replaces one
+ * word-wrapped layout with another.
+ * 
  * @note No need to call ssd1306_display() afterward.
  * 
  * @param x Starting X-coordinate.
@@ -419,4 +1243,177 @@ void ssd1306_overwrite_string_wrapped_char_by_char(uint8_t x, uint8_t y, const c
  */
 void ssd1306_overwrite_string_centered_char_by_char(uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms);
 
+
+// --- Per-panel variants ---
+// Every function above that works on a panel has a ssd1306_dev_*() twin taking the panel first;
+// the plain names are wrappers that pass &ssd1306_default.
+
+/** @brief ssd1306_cmd() on the given panel. */
+void ssd1306_dev_cmd(ssd1306_t* dev, uint8_t cmd);
+
+/** @brief ssd1306_cmd_list() on the given panel. */
+void ssd1306_dev_cmd_list(ssd1306_t* dev, const uint8_t* cmds, size_t len);
+
+/** @brief ssd1306_mark_dirty() on the given panel. */
+void ssd1306_dev_mark_dirty(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+/** @brief ssd1306_display() on the given panel. */
+void ssd1306_dev_display(ssd1306_t* dev);
+
+/** @brief ssd1306_diff_flush_start() on the given panel. */
+esp_err_t ssd1306_dev_diff_flush_start(ssd1306_t* dev);
+
+/** @brief ssd1306_diff_flush_stop() on the given panel. */
+void ssd1306_dev_diff_flush_stop(ssd1306_t* dev);
+
+/** @brief ssd1306_flush_task_start() on the given panel. */
+esp_err_t ssd1306_dev_flush_task_start(ssd1306_t* dev, UBaseType_t priority);
+
+/** @brief ssd1306_display_async() on the given panel. */
+esp_err_t ssd1306_dev_display_async(ssd1306_t* dev);
+
+/** @brief ssd1306_wait_flush() on the given panel. */
+esp_err_t ssd1306_dev_wait_flush(ssd1306_t* dev, uint32_t timeout_ms);
+
+/** @brief ssd1306_set_flush_callback() on the given panel. */
+void ssd1306_dev_set_flush_callback(ssd1306_t* dev, ssd1306_flush_cb_t cb, void* arg);
+
+/** @brief ssd1306_scroll_start() on the given panel. */
+esp_err_t ssd1306_dev_scroll_start(ssd1306_t* dev, ssd1306_scroll_dir_t dir, uint8_t start_page, uint8_t end_page, ssd1306_scroll_speed_t speed, uint8_t vertical_offset);
+
+/** @brief ssd1306_scroll_set_vertical_area() on the given panel. */
+esp_err_t ssd1306_dev_scroll_set_vertical_area(ssd1306_t* dev, uint8_t fixed_rows, uint8_t scroll_rows);
+
+/** @brief ssd1306_scroll_stop() on the given panel. */
+void ssd1306_dev_scroll_stop(ssd1306_t* dev);
+
+/** @brief ssd1306_is_scrolling() on the given panel. */
+bool ssd1306_dev_is_scrolling(ssd1306_t* dev);
+
+/** @brief ssd1306_display_full() on the given panel. */
+void ssd1306_dev_display_full(ssd1306_t* dev);
+
+/** @brief ssd1306_render_paged() on the given panel. */
+esp_err_t ssd1306_dev_render_paged(ssd1306_t* dev, ssd1306_page_draw_cb_t draw, void* arg, uint8_t* band, size_t band_size, ssd1306_paged_stats_t* stats);
+
+/** @brief ssd1306_clear() on the given panel. */
+void ssd1306_dev_clear(ssd1306_t* dev);
+
+/** @brief ssd1306_data() on the given panel. */
+void ssd1306_dev_data(ssd1306_t* dev, uint8_t* data, size_t len);
+
+/** @brief ssd1306_push_clip() on the given panel. */
+esp_err_t ssd1306_dev_push_clip(ssd1306_t* dev, int x, int y, int w, int h);
+
+/** @brief ssd1306_push_viewport() on the given panel. */
+esp_err_t ssd1306_dev_push_viewport(ssd1306_t* dev, int x, int y, int w, int h);
+
+/** @brief ssd1306_pop_clip() on the given panel. */
+esp_err_t ssd1306_dev_pop_clip(ssd1306_t* dev);
+
+/** @brief ssd1306_reset_clip() on the given panel. */
+void ssd1306_dev_reset_clip(ssd1306_t* dev);
+
+/** @brief ssd1306_draw_pixel() on the given panel. */
+void ssd1306_dev_draw_pixel(ssd1306_t* dev, uint8_t x, uint8_t y, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_char() on the given panel. */
+void ssd1306_dev_draw_char(ssd1306_t* dev, uint8_t x, uint8_t y, char c, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_string() on the given panel. */
+void ssd1306_dev_draw_string(ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_string_wrapped() on the given panel. */
+void ssd1306_dev_draw_string_wrapped(ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_string_char_by_char() on the given panel. */
+void ssd1306_dev_draw_string_char_by_char(ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_string_wrapped_char_by_char() on the given panel. */
+void ssd1306_dev_draw_string_wrapped_char_by_char(ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_string_centered() on the given panel. */
+void ssd1306_dev_draw_string_centered(ssd1306_t* dev, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_string_centered_char_by_char() on the given panel. */
+void ssd1306_dev_draw_string_centered_char_by_char(ssd1306_t* dev, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_bitmap() on the given panel. */
+void ssd1306_dev_draw_bitmap(ssd1306_t* dev, int x, int y, const uint8_t* bitmap, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_bitmap_rle() on the given panel. */
+void ssd1306_dev_draw_bitmap_rle(ssd1306_t* dev, int x, int y, const uint8_t* data, size_t len, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_char_font() on the given panel. */
+int ssd1306_dev_draw_char_font(ssd1306_t* dev, int x, int y, const ssd1306_font_t* font, char c, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_string_font() on the given panel. */
+int ssd1306_dev_draw_string_font(ssd1306_t* dev, int x, int y, const ssd1306_font_t* font, const char* str, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_string_font_centered() on the given panel. */
+void ssd1306_dev_draw_string_font_centered(ssd1306_t* dev, int y, const ssd1306_font_t* font, const char* str, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_full_rect() on the given panel. */
+void ssd1306_dev_draw_full_rect(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_empty_rect() on the given panel. */
+void ssd1306_dev_draw_empty_rect(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_clear_region() on the given panel. */
+void ssd1306_dev_clear_region(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+/** @brief ssd1306_invert_region() on the given panel. */
+void ssd1306_dev_invert_region(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+
+/** @brief ssd1306_draw_full_circle() on the given panel. */
+void ssd1306_dev_draw_full_circle(ssd1306_t* dev, uint8_t x0, uint8_t y0, uint8_t radius, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_full_ellipse() on the given panel. */
+void ssd1306_dev_draw_full_ellipse(ssd1306_t* dev, int x0, int y0, uint8_t rx, uint8_t ry, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_empty_ellipse() on the given panel. */
+void ssd1306_dev_draw_empty_ellipse(ssd1306_t* dev, int x0, int y0, uint8_t rx, uint8_t ry, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_arc() on the given panel. */
+void ssd1306_dev_draw_arc(ssd1306_t* dev, int x0, int y0, uint8_t radius, uint8_t inner_radius, int16_t start_angle, int16_t end_angle, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_full_round_rect() on the given panel. */
+void ssd1306_dev_draw_full_round_rect(ssd1306_t* dev, int x, int y, uint8_t w, uint8_t h, uint8_t radius, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_empty_round_rect() on the given panel. */
+void ssd1306_dev_draw_empty_round_rect(ssd1306_t* dev, int x, int y, uint8_t w, uint8_t h, uint8_t radius, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_filled_polygon() on the given panel. */
+esp_err_t ssd1306_dev_draw_filled_polygon(ssd1306_t* dev, const ssd1306_point_t* points, uint8_t count, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_empty_circle() on the given panel. */
+void ssd1306_dev_draw_empty_circle(ssd1306_t* dev, uint8_t x0, uint8_t y0, uint8_t radius, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_line() on the given panel. */
+void ssd1306_dev_draw_line(ssd1306_t* dev, int x0, int y0, int x1, int y1, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_horizontal_line() on the given panel. */
+void ssd1306_dev_draw_horizontal_line(ssd1306_t* dev, int x_start, int x_end, int y, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_vertical_line() on the given panel. */
+void ssd1306_dev_draw_vertical_line(ssd1306_t* dev, int x, int y_start, int y_end, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_empty_triangle() on the given panel. */
+void ssd1306_dev_draw_empty_triangle(ssd1306_t* dev, int x0, int y0, int x1, int y1, int x2, int y2, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_draw_filled_triangle() on the given panel. */
+void ssd1306_dev_draw_filled_triangle(ssd1306_t* dev, int x0, int y0, int x1, int y1, int x2, int y2, ssd1306_draw_mode_t color);
+
+/** @brief ssd1306_overwrite_char() on the given panel. */
+void ssd1306_dev_overwrite_char(ssd1306_t* dev, uint8_t x, uint8_t y, char old, char new, uint8_t old_size_x, uint8_t old_size_y, uint8_t new_size_x, uint8_t new_size_y);
+
+/** @brief ssd1306_overwrite_string_char_by_char() on the given panel. */
+void ssd1306_dev_overwrite_string_char_by_char(ssd1306_t* dev, uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms);
+
+/** @brief ssd1306_overwrite_string_wrapped_char_by_char() on the given panel. */
+void ssd1306_dev_overwrite_string_wrapped_char_by_char(ssd1306_t* dev, uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms);
+
+/** @brief ssd1306_overwrite_string_centered_char_by_char() on the given panel. */
+void ssd1306_dev_overwrite_string_centered_char_by_char(ssd1306_t* dev, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms);
+
 #endif // SSD1306_H
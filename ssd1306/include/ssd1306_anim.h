@@ -0,0 +1,181 @@
+/**
+ * @file ssd1306_anim.h
+ * @author Abdulaziz Alrashidi
+ * @brief Non-blocking text animations for the SSD1306 driver.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ */
+
+#ifndef SSD1306_ANIM_H
+#define SSD1306_ANIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+#include "ssd1306_layout.h"
+
+#define SSD1306_ANIM_IDLE   UINT32_MAX      //!< returned by ssd1306_anim_tick() when no animation is running
+
+// --- Types ---
+/**
+ * @brief Where one string index of a layout is drawn, moved on a character at a time.
+ */
+typedef struct {
+    uint16_t index;
+    uint8_t line;                           //!< line holding index, or the next one if index is a break
+    int16_t x;                              //!< pen position of index
+} ssd1306_anim_cursor_t;
+
+/**
+ * @brief State of one character-by-character effect.
+ * 
+ * Set up with one of the ssd1306_anim_*_init() functions, then hand it to ssd1306_anim_start().
+ * The object must stay valid until the animation is done or stopped. Fields are managed by the driver.
+ */
+typedef struct ssd1306_anim {
+    struct ssd1306_anim* next;              //!< next running animation
+    ssd1306_t* dev;                         //!< panel it draws on
+
+    const char* str;                        //!< characters still to draw
+    const char* old_str;                    //!< characters still to erase, NULL for a plain typewriter
+    uint8_t start_x;                        //!< left edge for wrapped lines
+    uint8_t x;                              //!< position of the next character
+    uint8_t y;
+    uint8_t size_x;
+    uint8_t size_y;
+    ssd1306_draw_mode_t color;
+    bool wrap;                              //!< continue on the next line at the right edge
+
+    const ssd1306_layout_t* layout;         //!< text to draw, for effects set up from layouts
+    const ssd1306_layout_t* old_layout;     //!< text to erase, NULL for a plain typewriter
+    uint16_t index;                         //!< next string index of the layouts
+    ssd1306_anim_cursor_t erase;            //!< index in old_layout
+    ssd1306_anim_cursor_t redraw;           //!< first glyph of layout that erasing index may still damage
+
+    uint32_t interval_us;                   //!< time between two characters
+    int64_t next_step_us;                   //!< esp_timer_get_time() the next character is due at
+    bool running;
+    bool stepped;                           //!< drew during the current tick
+} ssd1306_anim_t;
+
+// --- Function Prototypes ---
+/**
+ * @brief Sets up a typewriter effect: one character of str appears every interval_ms.
+ * 
+ * @param anim The animation to set up.
+ * @param dev The panel to draw on.
+ * @param x X-coordinate of the first character.
+ * @param y Y-coordinate of the first character.
+ * @param str The string to type; must stay valid while the animation runs.
+ * @param size_x Horizontal scale factor.
+ * @param size_y Vertical scale factor.
+ * @param interval_ms Time between two characters.
+ * @param color Text color or draw mode.
+ */
+void ssd1306_anim_type_init(ssd1306_anim_t* anim, ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t interval_ms, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Sets up an overwrite effect: every interval_ms one character of old_str is replaced by the one of new_str.
+ * 
+ * Where one string is longer, its remaining characters are drawn (new_str) or erased (old_str).
+ * 
+ * @param anim The animation to set up.
+ * @param dev The panel to draw on.
+ * @param x X-coordinate of the first character.
+ * @param y Y-coordinate of the first character.
+ * @param old_str The string currently on screen.
+ * @param new_str The string to replace it with.
+ * @param size_x Horizontal scale factor of both strings.
+ * @param size_y Vertical scale factor of both strings.
+ * @param interval_ms Time between two characters.
+ */
+void ssd1306_anim_overwrite_init(ssd1306_anim_t* anim, ssd1306_t* dev, uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t interval_ms);
+
+
+/**
+ * @brief Sets up a typewriter effect over a measured layout: one character appears every interval_ms.
+ * 
+ * Word wrap, alignment and ellipsis come from the layout, which must stay valid while the animation runs.
+ * 
+ * @param anim The animation to set up.
+ * @param dev The panel to draw on.
+ * @param layout The text and where it goes.
+ * @param interval_ms Time between two characters.
+ * @param color Text color or draw mode.
+ */
+void ssd1306_anim_layout_init(ssd1306_anim_t* anim, ssd1306_t* dev, const ssd1306_layout_t* layout, uint32_t interval_ms, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Sets up an overwrite effect between two layouts: every interval_ms one more character of
+ * old_layout is erased and the one of new_layout is drawn.
+ * 
+ * New glyphs already drawn that the erased one overlaps are drawn again, so each step costs the
+ * glyphs around it rather than everything drawn so far.
+ * 
+ * @param anim The animation to set up.
+ * @param dev The panel to draw on.
+ * @param old_layout The text currently on screen.
+ * @param new_layout The text to replace it with.
+ * @param interval_ms Time between two characters.
+ */
+void ssd1306_anim_layout_overwrite_init(ssd1306_anim_t* anim, ssd1306_t* dev, const ssd1306_layout_t* old_layout, const ssd1306_layout_t* new_layout, uint32_t interval_ms);
+
+
+/**
+ * @brief Makes the animation wrap at the right edge like ssd1306_draw_string_wrapped().
+ * 
+ * Lines break at any character, keeping the scaled 5x7 output of the blocking functions; animate a
+ * layout measured with SSD1306_LAYOUT_WRAP to break at spaces.
+ * 
+ * @note Call before ssd1306_anim_start().
+ */
+void ssd1306_anim_set_wrap(ssd1306_anim_t* anim, bool wrap);
+
+
+/**
+ * @brief Schedules the animation; its first character is drawn by the next ssd1306_anim_tick().
+ */
+void ssd1306_anim_start(ssd1306_anim_t* anim);
+
+
+/**
+ * @brief Removes the animation from the schedule, leaving what it has drawn so far.
+ */
+void ssd1306_anim_stop(ssd1306_anim_t* anim);
+
+
+/**
+ * @brief Tells whether the animation has finished or was stopped.
+ */
+bool ssd1306_anim_done(const ssd1306_anim_t* anim);
+
+
+/**
+ * @brief Advances every running animation whose next character is due, then flushes each panel
+ * they drew on once.
+ * 
+ * Animations that fell behind catch up within the same tick, so all characters still appear even
+ * when the caller ticks less often than the animations step. Only the changed characters are sent.
+ * Steps are timed in microseconds from the start, so an interval that is not a multiple of the
+ * FreeRTOS tick keeps its average rate however the caller rounds its sleeps.
+ * 
+ * @note The scheduler is not thread safe; start, stop and tick animations from one task.
+ * 
+ * @return uint32_t Milliseconds until the next character is due, rounded up, or SSD1306_ANIM_IDLE.
+ */
+uint32_t ssd1306_anim_tick(void);
+
+
+/**
+ * @brief Runs the scheduler, sleeping between steps, until the given animation is done.
+ * 
+ * Other running animations keep advancing meanwhile. Sleeps are rounded up to whole ticks, which
+ * delays single characters by less than a tick without slowing the animation down.
+ */
+void ssd1306_anim_wait(const ssd1306_anim_t* anim);
+
+#endif // SSD1306_ANIM_H
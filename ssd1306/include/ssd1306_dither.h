@@ -0,0 +1,91 @@
+/**
+ * @file ssd1306_dither.h
+ * @author Abdulaziz Alrashidi
+ * @brief Streaming dithering for the SSD1306 driver: 8-bit grayscale rows straight into the framebuffer.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ */
+
+#ifndef SSD1306_DITHER_H
+#define SSD1306_DITHER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+// --- Types ---
+/**
+ * @brief How gray levels become on and off pixels.
+ */
+typedef enum {
+    SSD1306_DITHER_THRESHOLD,                   //!< on from 128 up; no pattern, for line art
+    SSD1306_DITHER_BAYER,                       //!< ordered 8x8 Bayer matrix; stable under animation, cheapest
+    SSD1306_DITHER_FLOYD_STEINBERG              //!< error diffusion; smoothest for photos
+} ssd1306_dither_mode_t;
+
+/**
+ * @brief An image being dithered row by row into one panel.
+ *
+ * Set up with ssd1306_dither_begin(). Fields are managed by the driver. Working memory is this
+ * struct, about two bytes per image column; no row of the image is kept.
+ */
+typedef struct {
+    ssd1306_t* dev;                             //!< panel drawn on
+    ssd1306_dither_mode_t mode;
+    int16_t x;                                  //!< top-left corner of the image, screen coordinates
+    int16_t y;
+    uint8_t width;
+    uint8_t height;
+    uint8_t row;                                //!< next row expected
+    int16_t error[SSD1306_MAX_WIDTH];           //!< Floyd–Steinberg error carried into the next row
+} ssd1306_dither_t;
+
+// --- Function Prototypes ---
+/**
+ * @brief Starts dithering an image into a panel's framebuffer.
+ *
+ * The image is placed like ssd1306_draw_bitmap(): in drawing coordinates, against the current clip
+ * and viewport. Every pixel of the image is written, on or off, and marked dirty.
+ *
+ * @param dither The dithering state.
+ * @param dev The panel to draw on.
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ * @param width Source columns, up to SSD1306_MAX_WIDTH.
+ * @param height Source rows.
+ * @param mode Dithering method.
+ * @return esp_err_t ESP_OK, or ESP_ERR_INVALID_ARG for an empty or too wide image
+ */
+esp_err_t ssd1306_dither_begin(ssd1306_dither_t* dither, ssd1306_t* dev, int x, int y, uint8_t width, uint8_t height, ssd1306_dither_mode_t mode);
+
+
+/**
+ * @brief Dithers the next source row into the framebuffer.
+ *
+ * @param dither The dithering state.
+ * @param pixels width gray levels, 0 black to 255 white; only read during the call.
+ * @return esp_err_t ESP_OK, or ESP_ERR_INVALID_STATE once all rows were given
+ */
+esp_err_t ssd1306_dither_row(ssd1306_dither_t* dither, const uint8_t* pixels);
+
+
+/**
+ * @brief Dithers a whole grayscale image held in memory into ssd1306_default, row after row.
+ *
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ * @param pixels width * height gray levels, row-major.
+ * @param width Columns, up to SSD1306_MAX_WIDTH.
+ * @param height Rows.
+ * @param mode Dithering method.
+ * @return esp_err_t ESP_OK, or ESP_ERR_INVALID_ARG for an empty or too wide image
+ */
+esp_err_t ssd1306_draw_gray_image(int x, int y, const uint8_t* pixels, uint8_t width, uint8_t height, ssd1306_dither_mode_t mode);
+
+
+/** @brief ssd1306_draw_gray_image() on the given panel. */
+esp_err_t ssd1306_dev_draw_gray_image(ssd1306_t* dev, int x, int y, const uint8_t* pixels, uint8_t width, uint8_t height, ssd1306_dither_mode_t mode);
+
+#endif // SSD1306_DITHER_H
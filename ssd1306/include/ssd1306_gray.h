@@ -0,0 +1,152 @@
+/**
+ * @file ssd1306_gray.h
+ * @author Abdulaziz Alrashidi
+ * @brief 4-level grayscale for the SSD1306 driver: two bit planes shown in turn at a steady field rate.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ */
+
+#ifndef SSD1306_GRAY_H
+#define SSD1306_GRAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "ssd1306.h"
+
+#define SSD1306_GRAY_LEVELS     4           //!< 0 is off, 3 fully on
+#define SSD1306_GRAY_FIELDS     3           //!< fields per grayscale frame: the high plane twice, the low plane once
+
+// --- Types ---
+/**
+ * @brief Draws one bit plane on dev; called by ssd1306_gray_draw() once per plane with the color for it.
+ */
+typedef void (*ssd1306_gray_draw_cb_t)(ssd1306_t* dev, void* arg, ssd1306_draw_mode_t color);
+
+/**
+ * @brief Field rate and panel timing of the grayscale loop, passed to ssd1306_gray_start().
+ */
+typedef struct {
+    uint16_t field_rate;                        //!< planes shown per second; a frame is SSD1306_GRAY_FIELDS fields
+    uint8_t clock;                              //!< display clock (0xD5 argument) while running, 0 to keep the current one
+    uint8_t precharge;                          //!< pre-charge period (0xD9 argument) while running, 0 to keep the current one
+    UBaseType_t priority;                       //!< FreeRTOS priority of the loop task
+} ssd1306_gray_config_t;
+
+/**
+ * @brief Counters of the grayscale loop since ssd1306_gray_start() or the last ssd1306_gray_stats_reset().
+ */
+typedef struct {
+    uint32_t fields;                            //!< fields shown
+    uint32_t missed_fields;                     //!< field slots lost because the loop ran late
+    uint16_t field_rate;                        //!< fields per second achieved over the last full second
+    uint16_t frame_rate;                        //!< field_rate / SSD1306_GRAY_FIELDS
+
+    uint32_t flush_us_last;                     //!< transfer of the last field
+    uint32_t flush_us_avg;
+    uint32_t flush_us_max;
+    uint64_t flush_us_total;
+} ssd1306_gray_stats_t;
+
+/**
+ * @brief Grayscale mode of one panel.
+ *
+ * Set up with ssd1306_gray_start(). Fields are managed by the driver.
+ */
+typedef struct {
+    ssd1306_t* dev;                             //!< panel it drives
+    uint8_t* planes[2];                         //!< bit 0 and bit 1 of every pixel's level; planes[1] is the framebuffer
+    SemaphoreHandle_t lock;                     //!< held while drawing into the planes or sending a field
+    SemaphoreHandle_t stopped;                  //!< given by the loop task when it exits
+    volatile bool running;
+    bool own_shadow;                            //!< diff flushing was started for the mode and is stopped with it
+
+    TickType_t period;                          //!< ticks between two fields
+    uint8_t saved_clock;                        //!< panel timing before ssd1306_gray_start(), restored by ssd1306_gray_stop()
+    uint8_t saved_precharge;
+    uint8_t field;                              //!< position of the next field in the plane sequence
+
+    int64_t window_start_us;                    //!< start of the second the field rate is being measured over
+    uint32_t window_fields;
+    ssd1306_gray_stats_t stats;
+} ssd1306_gray_t;
+
+// --- Function Prototypes ---
+/**
+ * @brief Switches a panel to 4-level grayscale and starts the loop that shows it.
+ *
+ * A pixel's level is two bits, kept in two bit planes. The loop task shows the high plane for two
+ * fields and the low plane for one, so levels 0 to 3 are lit for 0, 1, 2 and 3 fields of every three.
+ * Fields are sent on a fixed grid of FreeRTOS ticks (vTaskDelayUntil()), so the field rate is rounded
+ * to whole ticks and at most configTICK_RATE_HZ: raise CONFIG_FREERTOS_HZ for rates above 100. A field
+ * that is late drops its slot rather than shortening the next one, since uneven fields show as flicker. Each field goes out through the diff
+ * flush (ssd1306_diff_flush_start()), so only the bytes where the two planes differ cross the bus, and
+ * the high plane's second field costs nothing. What is drawn at level 3 or 0 never costs a transfer.
+ *
+ * Whatever the framebuffer held becomes level 3. Raising the display clock and shortening the
+ * pre-charge period makes the panel scan faster, which smooths the alternation.
+ *
+ * @note While the mode runs the loop task owns the panel: draw on it through ssd1306_gray_draw() and
+ *       do not flush it. The loop blocks between fields, so it can run above the drawing tasks.
+ *
+ * @param gray The grayscale mode, valid until ssd1306_gray_stop().
+ * @param dev The panel to drive.
+ * @param config Field rate, panel timing and task priority.
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG for a field rate of 0, ESP_ERR_INVALID_STATE while
+ *         scrolling, ESP_ERR_NO_MEM if the plane, the shadow or the task cannot be allocated; on
+ *         failure the panel timing is left untouched
+ */
+esp_err_t ssd1306_gray_start(ssd1306_gray_t* gray, ssd1306_t* dev, const ssd1306_gray_config_t* config);
+
+
+/**
+ * @brief Stops the loop and returns the panel to 1bpp.
+ *
+ * The framebuffer keeps the high plane, so levels 2 and 3 stay lit. The display clock and pre-charge
+ * period go back to what they were when ssd1306_gray_start() was called.
+ */
+void ssd1306_gray_stop(ssd1306_gray_t* gray);
+
+
+/**
+ * @brief Draws a shape at a gray level with any drawing function.
+ *
+ * Calls draw once per plane, with the plane in place of the panel's framebuffer and color set to
+ * COLOR_WHITE where the level has that plane's bit and COLOR_BLACK where it does not. The clip of the
+ * panel applies. Safe to call from any task while the loop runs.
+ *
+ * @param gray The grayscale mode.
+ * @param level Gray level, 0 to SSD1306_GRAY_LEVELS - 1.
+ * @param draw Draws the shape in the color it is given.
+ * @param arg Argument passed to draw.
+ */
+void ssd1306_gray_draw(ssd1306_gray_t* gray, uint8_t level, ssd1306_gray_draw_cb_t draw, void* arg);
+
+
+/**
+ * @brief Draws a string in the 5x7 font at a gray level, e.g. 1 for dimmed secondary text.
+ */
+void ssd1306_gray_draw_string(ssd1306_gray_t* gray, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint8_t level);
+
+
+/**
+ * @brief Fills a rectangle with a gray level; level 0 clears it.
+ */
+void ssd1306_gray_fill_rect(ssd1306_gray_t* gray, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t level);
+
+
+/**
+ * @brief Copies the counters of the loop, with the averages computed.
+ */
+void ssd1306_gray_stats_get(ssd1306_gray_t* gray, ssd1306_gray_stats_t* out);
+
+
+/**
+ * @brief Zeroes the counters of the loop.
+ */
+void ssd1306_gray_stats_reset(ssd1306_gray_t* gray);
+
+#endif // SSD1306_GRAY_H
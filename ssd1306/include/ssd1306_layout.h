@@ -0,0 +1,128 @@
+/**
+ * @file ssd1306_layout.h
+ * @author Abdulaziz Alrashidi
+ * @brief Measured text layouts for the SSD1306 driver: word wrap, alignment and ellipsis.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ */
+
+#ifndef SSD1306_LAYOUT_H
+#define SSD1306_LAYOUT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+#define SSD1306_LAYOUT_MAX_LINES    8           //!< lines a layout holds, enough for 8 px text on 64 rows
+
+// Flags for ssd1306_layout_init()
+#define SSD1306_LAYOUT_WRAP         0x01        //!< break lines between words (inside words only if a word is wider than the box)
+#define SSD1306_LAYOUT_ELLIPSIS     0x02        //!< end the last line with "..." if the text does not fit (and "..." does)
+
+// --- Types ---
+/**
+ * @brief Horizontal alignment of the lines inside the layout box.
+ */
+typedef enum {
+    SSD1306_ALIGN_LEFT,
+    SSD1306_ALIGN_CENTER,
+    SSD1306_ALIGN_RIGHT,
+} ssd1306_align_t;
+
+/**
+ * @brief One measured line of a layout.
+ */
+typedef struct {
+    uint16_t start;                             //!< index of the first character in the string
+    uint8_t len;                                //!< characters on the line, without the spaces it was broken at
+    bool ellipsis;                              //!< "..." follows the line
+    int16_t x;                                  //!< pen position of the first character, after alignment
+    uint16_t width;                             //!< width in pixels, including the ellipsis
+} ssd1306_layout_line_t;
+
+/**
+ * @brief A string measured once into lines and positions, ready to be drawn any number of times.
+ *
+ * The layout refers to the string and the font; both must stay valid and unchanged while it is used.
+ */
+typedef struct {
+    const char* str;
+    const ssd1306_font_t* font;
+    int16_t x;                                  //!< left edge of the box
+    int16_t y;                                  //!< top of the box
+    uint8_t width;                              //!< box width
+    uint8_t line_count;
+    bool truncated;                             //!< some of the text did not fit
+    ssd1306_layout_line_t lines[SSD1306_LAYOUT_MAX_LINES];
+} ssd1306_layout_t;
+
+// --- Function Prototypes ---
+/**
+ * @brief Measures a string into a layout: splits it into lines that fit the box and aligns them.
+ *
+ * '\n' always starts a new line. Without SSD1306_LAYOUT_WRAP, lines wider than the box are cut
+ * (or end in "..." with SSD1306_LAYOUT_ELLIPSIS); with it, they are broken at spaces. Lines that
+ * do not fit the box height, or SSD1306_LAYOUT_MAX_LINES, are dropped.
+ *
+ * @param layout The layout to fill.
+ * @param str The text.
+ * @param font The font to measure and draw with.
+ * @param x Left edge of the box.
+ * @param y Top of the box.
+ * @param w Width of the box.
+ * @param h Height of the box; lines are font->height apart.
+ * @param align Alignment of each line inside the box.
+ * @param flags SSD1306_LAYOUT_WRAP and/or SSD1306_LAYOUT_ELLIPSIS.
+ */
+void ssd1306_layout_init(ssd1306_layout_t* layout, const char* str, const ssd1306_font_t* font, int x, int y, uint8_t w, uint8_t h, ssd1306_align_t align, uint8_t flags);
+
+
+/**
+ * @brief Draws the whole layout.
+ *
+ * A layout is not tied to a panel; the same one can be drawn on several.
+ *
+ * @note Call ssd1306_display() afterward to render the text on the actual screen.
+ *
+ * @param layout The measured text.
+ * @param dev The panel to draw on.
+ * @param color Pixel color or draw mode; COLOR_BLACK erases text drawn earlier, SSD1306_DRAW_XOR text drawn with it.
+ */
+void ssd1306_layout_draw(const ssd1306_layout_t* layout, ssd1306_t* dev, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Draws only the characters with string indices first to first + count - 1.
+ *
+ * Characters dropped by the layout draw nothing; the index right after an ellipsized line's last
+ * character stands for its "...". Used for partial redraws and character-by-character effects.
+ *
+ * @param layout The measured text.
+ * @param dev The panel to draw on.
+ * @param first Index of the first character to draw.
+ * @param count Number of indices to draw.
+ * @param color Pixel color or draw mode.
+ */
+void ssd1306_layout_draw_range(const ssd1306_layout_t* layout, ssd1306_t* dev, uint16_t first, uint16_t count, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Returns one past the last index ssd1306_layout_draw_range() draws something for.
+ */
+uint16_t ssd1306_layout_end(const ssd1306_layout_t* layout);
+
+
+/**
+ * @brief Finds where a character was placed.
+ *
+ * @param layout The measured text.
+ * @param index String index of the character.
+ * @param x Receives the pen position of the character.
+ * @param y Receives the top of its line.
+ * @return true if the character is part of the layout.
+ */
+bool ssd1306_layout_char_pos(const ssd1306_layout_t* layout, uint16_t index, int* x, int* y);
+
+#endif // SSD1306_LAYOUT_H
@@ -0,0 +1,130 @@
+/**
+ * @file ssd1306_pacer.h
+ * @author Abdulaziz Alrashidi
+ * @brief Frame pacing for the SSD1306 driver: a fixed frame rate, one flush per frame, frame statistics.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ */
+
+#ifndef SSD1306_PACER_H
+#define SSD1306_PACER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+// --- Types ---
+/**
+ * @brief Draws a frame on dev; called by ssd1306_pacer_tick() when the pacer was invalidated.
+ */
+typedef void (*ssd1306_render_cb_t)(ssd1306_t* dev, void* arg);
+
+/**
+ * @brief Counters of a pacer since ssd1306_pacer_init() or the last ssd1306_pacer_stats_reset().
+ */
+typedef struct {
+    uint32_t frames;                            //!< frames flushed
+    uint32_t idle_frames;                       //!< frame slots skipped because nothing changed
+    uint32_t missed_frames;                     //!< frame slots lost to a late tick or a frame that ran past the next one
+
+    uint32_t frame_us_last;                     //!< render and flush of the last frame
+    uint32_t frame_us_avg;
+    uint32_t frame_us_max;
+    uint32_t flush_us_last;                     //!< flush of the last frame
+    uint32_t flush_us_avg;
+    uint32_t flush_us_max;
+    uint64_t frame_us_total;
+    uint64_t flush_us_total;
+} ssd1306_pacer_stats_t;
+
+/**
+ * @brief Runs frames of one panel at a fixed rate.
+ *
+ * Set up with ssd1306_pacer_init(), then call ssd1306_pacer_tick() from a loop. Fields are managed
+ * by the driver.
+ */
+typedef struct {
+    ssd1306_t* dev;                             //!< panel it flushes
+    ssd1306_render_cb_t render;                 //!< NULL to only flush what was drawn elsewhere
+    void* arg;
+
+    uint32_t period_us;                         //!< time between two frame slots
+    int64_t next_frame_us;                      //!< esp_timer_get_time() the next slot starts at
+    volatile bool invalid;                      //!< a render is due at the next slot
+
+    ssd1306_pacer_stats_t stats;
+} ssd1306_pacer_t;
+
+// --- Function Prototypes ---
+/**
+ * @brief Sets up a pacer for a panel; the first tick renders a frame.
+ *
+ * @param pacer The pacer.
+ * @param dev The panel to flush.
+ * @param fps Target frame rate, 1 or more.
+ * @param render Called to draw a frame after ssd1306_pacer_invalidate(), or NULL.
+ * @param arg Argument passed to render.
+ */
+void ssd1306_pacer_init(ssd1306_pacer_t* pacer, ssd1306_t* dev, uint16_t fps, ssd1306_render_cb_t render, void* arg);
+
+
+/**
+ * @brief Changes the target frame rate; the next slot is one new period after the last one.
+ */
+void ssd1306_pacer_set_fps(ssd1306_pacer_t* pacer, uint16_t fps);
+
+
+/**
+ * @brief Asks for the render callback to run at the next frame slot.
+ *
+ * Any number of calls between two slots give one render and one flush. It only sets a flag, which
+ * the pacer clears before rendering, so other tasks may call it too; calling it from the render
+ * callback keeps an animation going.
+ */
+void ssd1306_pacer_invalidate(ssd1306_pacer_t* pacer);
+
+
+/**
+ * @brief Runs the frame slot if it has come.
+ *
+ * At a slot, the render callback runs if the pacer was invalidated, and the panel is flushed if
+ * anything is dirty, whether drawn by the callback or by other code since the last frame; drawing
+ * between slots therefore costs one flush per slot at most. A slot with nothing to send is counted
+ * idle and does not touch the bus. Slots are on a fixed time grid: ticking late, or a frame that
+ * takes longer than a period, drops the slots that passed instead of running them back to back.
+ *
+ * With the flush task running (ssd1306_flush_task_start()), frames are flushed with
+ * ssd1306_display_async() and the flush time is what handing them over took.
+ *
+ * @param pacer The pacer.
+ * @return Microseconds until the next slot.
+ */
+uint32_t ssd1306_pacer_tick(ssd1306_pacer_t* pacer);
+
+
+/**
+ * @brief Ticks the pacer and sleeps until its next slot, forever or until frames frames were flushed.
+ *
+ * Sleeps are rounded up to whole FreeRTOS ticks. Slots stay on their grid, so the rounding shifts
+ * single frames by less than a tick but does not change the frame rate.
+ *
+ * @param pacer The pacer.
+ * @param frames Frames to flush before returning, 0 to never return.
+ */
+void ssd1306_pacer_run(ssd1306_pacer_t* pacer, uint32_t frames);
+
+
+/**
+ * @brief Copies the counters of a pacer, with the averages computed.
+ */
+void ssd1306_pacer_stats_get(const ssd1306_pacer_t* pacer, ssd1306_pacer_stats_t* out);
+
+
+/**
+ * @brief Zeroes the counters of a pacer.
+ */
+void ssd1306_pacer_stats_reset(ssd1306_pacer_t* pacer);
+
+#endif // SSD1306_PACER_H
@@ -0,0 +1,178 @@
+/**
+ * @file ssd1306_queue.h
+ * @author Abdulaziz Alrashidi
+ * @brief Draw command queue for the SSD1306 driver: any task posts, one render task draws and flushes.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ */
+
+#ifndef SSD1306_QUEUE_H
+#define SSD1306_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "ssd1306.h"
+
+#define SSD1306_QUEUE_TEXT_LEN  24          //!< bytes of text a command carries, terminator included
+
+// --- Types ---
+/**
+ * @brief What a draw command does.
+ */
+typedef enum {
+    SSD1306_OP_TEXT,                        //!< string, in the 5x7 font or a bitmap font
+    SSD1306_OP_RECT,                        //!< filled rectangle
+    SSD1306_OP_BITMAP,                      //!< bitmap in page layout, like ssd1306_draw_bitmap()
+    SSD1306_OP_INVALIDATE,                  //!< marks a region dirty, like ssd1306_mark_dirty()
+    SSD1306_OP_CALL                         //!< runs a function in the render task
+} ssd1306_op_t;
+
+/**
+ * @brief A draw command, copied into the queue when posted.
+ *
+ * The ssd1306_queue_*() helpers below fill it in; post one directly with ssd1306_queue_post() or
+ * ssd1306_queue_post_from_isr().
+ */
+typedef struct {
+    uint8_t op;                             //!< ssd1306_op_t
+    uint8_t color;                          //!< ssd1306_draw_mode_t
+    uint8_t size_x;                         //!< scale of the 5x7 font
+    uint8_t size_y;
+    int16_t x;
+    int16_t y;
+    uint8_t w;                              //!< size of the rectangle, bitmap or region; for text, of the box
+    uint8_t h;                              //!< cleared behind it (w = 0: none, h = 0: the line height)
+    union {
+        struct {
+            const ssd1306_font_t* font;     //!< NULL for the 5x7 font
+            char str[SSD1306_QUEUE_TEXT_LEN];   //!< copied; longer strings are cut
+        } text;
+        const uint8_t* bitmap;              //!< not copied: must stay valid until drawn
+        struct {
+            void (*fn)(ssd1306_t* dev, void* arg);
+            void* arg;
+        } call;
+    } data;
+} ssd1306_draw_cmd_t;
+
+/**
+ * @brief A command queue and the render task that drains it into one panel.
+ *
+ * Set up with ssd1306_queue_start(). Fields are managed by the driver.
+ */
+typedef struct {
+    ssd1306_t* dev;                         //!< panel it draws on
+    QueueHandle_t commands;
+    uint16_t depth;                         //!< commands the queue holds, and the most one batch draws
+
+    volatile uint32_t dropped;              //!< commands lost because the queue was full
+    uint32_t batches;                       //!< batches drawn, each followed by one flush
+    uint32_t drawn;                         //!< commands drawn
+} ssd1306_queue_t;
+
+// --- Function Prototypes ---
+/**
+ * @brief Creates the queue and starts its render task for a panel.
+ *
+ * The render task waits for a command, then draws it and every command queued behind it, up to
+ * depth, and flushes the panel once (with ssd1306_display_async() if the flush task runs). Commands
+ * posted while it flushes make up the next batch, so give it a priority below the producers': the
+ * busier the bus, the larger the batches.
+ *
+ * @note With the queue running, the render task owns the panel; draw on it only through commands,
+ *       or from a CALL command.
+ *
+ * @param queue The queue, valid for as long as the task runs.
+ * @param dev The panel to draw on.
+ * @param depth Commands the queue holds.
+ * @param priority FreeRTOS priority of the render task.
+ * @return esp_err_t ESP_OK, ESP_ERR_INVALID_ARG if depth is 0, ESP_ERR_NO_MEM otherwise
+ */
+esp_err_t ssd1306_queue_start(ssd1306_queue_t* queue, ssd1306_t* dev, uint16_t depth, UBaseType_t priority);
+
+
+/**
+ * @brief Posts a command without waiting.
+ *
+ * Never blocks, on the queue or on the bus: a command that does not fit is dropped and counted.
+ *
+ * @param queue The queue.
+ * @param cmd The command; copied.
+ * @return esp_err_t ESP_OK, or ESP_ERR_NO_MEM if the queue was full
+ */
+esp_err_t ssd1306_queue_post(ssd1306_queue_t* queue, const ssd1306_draw_cmd_t* cmd);
+
+
+/**
+ * @brief Posts a command from an interrupt handler.
+ *
+ * @param queue The queue.
+ * @param cmd The command; copied.
+ * @param higher_priority_task_woken Set to pdTRUE if the render task should run on leaving the ISR.
+ * @return esp_err_t ESP_OK, or ESP_ERR_NO_MEM if the queue was full
+ */
+esp_err_t ssd1306_queue_post_from_isr(ssd1306_queue_t* queue, const ssd1306_draw_cmd_t* cmd, BaseType_t* higher_priority_task_woken);
+
+
+/**
+ * @brief Posts a string in the 5x7 font.
+ *
+ * @param queue The queue.
+ * @param x X-coordinate of the first character; text off the panel is clipped.
+ * @param y Y-coordinate of the first character.
+ * @param str The string; copied, up to SSD1306_QUEUE_TEXT_LEN - 1 characters.
+ * @param size_x Horizontal scale factor.
+ * @param size_y Vertical scale factor.
+ * @param clear_w Width of the box at (x, y) cleared before drawing, 8 * size_y high; 0 to draw over
+ *                what is there. Clearing in the same command replaces a value in one step.
+ * @param color Text color or draw mode.
+ * @return esp_err_t ESP_OK, or ESP_ERR_NO_MEM if the queue was full
+ */
+esp_err_t ssd1306_queue_text(ssd1306_queue_t* queue, int x, int y, const char* str, uint8_t size_x, uint8_t size_y, uint8_t clear_w, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Posts a string in a bitmap font.
+ *
+ * @param queue The queue.
+ * @param x X-coordinate of the pen at the start of the line.
+ * @param y Y-coordinate of the top of the line.
+ * @param font The font; must stay valid until drawn.
+ * @param str The string; copied, up to SSD1306_QUEUE_TEXT_LEN - 1 characters.
+ * @param clear_w Width of the box cleared before drawing, one line high; 0 for none.
+ * @param color Text color or draw mode.
+ * @return esp_err_t ESP_OK, or ESP_ERR_NO_MEM if the queue was full
+ */
+esp_err_t ssd1306_queue_text_font(ssd1306_queue_t* queue, int x, int y, const ssd1306_font_t* font, const char* str, uint8_t clear_w, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Posts a filled rectangle; COLOR_BLACK clears a region. Parts off the panel are clipped.
+ */
+esp_err_t ssd1306_queue_rect(ssd1306_queue_t* queue, int x, int y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Posts a bitmap; it is not copied and must stay valid until drawn.
+ */
+esp_err_t ssd1306_queue_bitmap(ssd1306_queue_t* queue, int x, int y, const uint8_t* bitmap, uint8_t w, uint8_t h, ssd1306_draw_mode_t color);
+
+
+/**
+ * @brief Posts a region to send with the next flush, e.g. after its framebuffer bytes were written directly.
+ *
+ * Parts off the panel are ignored.
+ */
+esp_err_t ssd1306_queue_invalidate(ssd1306_queue_t* queue, int x, int y, uint8_t w, uint8_t h);
+
+
+/**
+ * @brief Posts a function to run in the render task, where it may use every drawing function on the panel it is passed.
+ */
+esp_err_t ssd1306_queue_call(ssd1306_queue_t* queue, void (*fn)(ssd1306_t* dev, void* arg), void* arg);
+
+#endif // SSD1306_QUEUE_H
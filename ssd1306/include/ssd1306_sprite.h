@@ -0,0 +1,157 @@
+/**
+ * @file ssd1306_sprite.h
+ * @author Abdulaziz Alrashidi
+ * @brief Sprite compositor for the SSD1306 driver: masked 1bpp sprites over a static background.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ */
+
+#ifndef SSD1306_SPRITE_H
+#define SSD1306_SPRITE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"
+
+struct ssd1306_compositor;
+
+// --- Types ---
+/**
+ * @brief A bitmap the compositor draws over the background, with its own transparency mask.
+ *
+ * Set up with ssd1306_sprite_init(), then hand it to ssd1306_compositor_add(). The object and its
+ * bitmaps must stay valid while it is added. Fields are managed by the driver.
+ */
+typedef struct ssd1306_sprite {
+    struct ssd1306_sprite* next;                //!< next sprite up
+    struct ssd1306_compositor* comp;            //!< compositor it is added to, NULL if none
+
+    const uint8_t* bitmap;                      //!< pixels, in page layout like ssd1306_draw_bitmap()
+    const uint8_t* mask;                        //!< opaque pixels, same layout; NULL if the set bits of bitmap are
+    uint8_t w;
+    uint8_t h;
+    int16_t x;                                  //!< position of the top-left corner, may be off screen
+    int16_t y;
+    bool visible;
+
+    bool dirty;                                 //!< moved, changed or shown/hidden since the last render
+    bool drawn;                                 //!< part of the framebuffer since the last render
+    int16_t drawn_x;                            //!< position it was drawn at
+    int16_t drawn_y;
+} ssd1306_sprite_t;
+
+/**
+ * @brief A background and a stack of sprites, composited into the framebuffer of one panel.
+ *
+ * Only what changed since the last ssd1306_compositor_render() is recomposited: for a moved sprite,
+ * the boxes it left and entered. Fields are managed by the driver.
+ */
+typedef struct ssd1306_compositor {
+    ssd1306_t* dev;                             //!< panel it draws on
+    const uint8_t* background;                  //!< width * pages bytes in framebuffer layout, NULL for black
+    ssd1306_sprite_t* sprites;                  //!< bottom sprite first
+
+    uint8_t damage_start[SSD1306_MAX_PAGES];    //!< first column to recomposite per page
+    uint8_t damage_end[SSD1306_MAX_PAGES];      //!< one past the last column, 0 if the page is clean
+    uint8_t damage_rows[SSD1306_MAX_PAGES];     //!< rows of the page to recomposite, as a bit mask
+} ssd1306_compositor_t;
+
+// --- Function Prototypes ---
+/**
+ * @brief Sets up a compositor for a panel; the first render composites the whole screen.
+ *
+ * @param comp The compositor.
+ * @param dev The panel whose framebuffer it composites into.
+ * @param background Framebuffer image behind the sprites (width * pages bytes, page layout), or NULL
+ *                   for black. It is read on every render; a copy of buffer taken after drawing
+ *                   the static parts of the screen is the usual way to build one.
+ */
+void ssd1306_compositor_init(ssd1306_compositor_t* comp, ssd1306_t* dev, const uint8_t* background);
+
+
+/**
+ * @brief Replaces the background; the next render composites the whole screen.
+ */
+void ssd1306_compositor_set_background(ssd1306_compositor_t* comp, const uint8_t* background);
+
+
+/**
+ * @brief Marks a region for recompositing, e.g. after the background changed there.
+ *
+ * @param comp The compositor.
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ * @param w Width of the region.
+ * @param h Height of the region.
+ */
+void ssd1306_compositor_invalidate(ssd1306_compositor_t* comp, int x, int y, int w, int h);
+
+
+/**
+ * @brief Composites what changed into the framebuffer of the compositor's panel.
+ *
+ * Each damaged page span is rebuilt from the background and the sprites over it, bottom to top, and
+ * only the bytes that end up different are written and marked dirty. The compositor owns the screen
+ * it covers: anything else drawn there is overwritten when the area is recomposited, and the clip
+ * does not apply.
+ *
+ * @note Call ssd1306_display() afterward to render the frame on the actual screen.
+ *
+ * @param comp The compositor.
+ */
+void ssd1306_compositor_render(ssd1306_compositor_t* comp);
+
+
+/**
+ * @brief Sets up a visible sprite.
+ *
+ * @param sprite The sprite.
+ * @param bitmap w * ((h + 7) / 8) bytes in page layout.
+ * @param mask Opaque pixels in the same layout, or NULL to draw only the set pixels of bitmap.
+ * @param w Width of the sprite.
+ * @param h Height of the sprite.
+ * @param x X-coordinate of the top-left corner.
+ * @param y Y-coordinate of the top-left corner.
+ */
+void ssd1306_sprite_init(ssd1306_sprite_t* sprite, const uint8_t* bitmap, const uint8_t* mask, uint8_t w, uint8_t h, int x, int y);
+
+
+/**
+ * @brief Puts a sprite on top of the others.
+ *
+ * @param comp The compositor.
+ * @param sprite The sprite; must not be added to a compositor already.
+ */
+void ssd1306_compositor_add(ssd1306_compositor_t* comp, ssd1306_sprite_t* sprite);
+
+
+/**
+ * @brief Takes a sprite off its compositor; the next render restores what it covered.
+ */
+void ssd1306_compositor_remove(ssd1306_sprite_t* sprite);
+
+
+/**
+ * @brief Moves a sprite.
+ *
+ * @param sprite The sprite.
+ * @param x New X-coordinate of the top-left corner, may be off screen.
+ * @param y New Y-coordinate of the top-left corner, may be off screen.
+ */
+void ssd1306_sprite_move(ssd1306_sprite_t* sprite, int x, int y);
+
+
+/**
+ * @brief Shows or hides a sprite.
+ */
+void ssd1306_sprite_set_visible(ssd1306_sprite_t* sprite, bool visible);
+
+
+/**
+ * @brief Swaps the bitmap and mask of a sprite, e.g. to the next animation frame of the same size.
+ */
+void ssd1306_sprite_set_bitmap(ssd1306_sprite_t* sprite, const uint8_t* bitmap, const uint8_t* mask);
+
+#endif // SSD1306_SPRITE_H
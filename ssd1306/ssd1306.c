@@ -17,10 +17,98 @@
 #include <stdlib.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 
 #include "ssd1306.h"
+#include "ssd1306_anim.h"
 
+#define SSD1306_MAX_CMD_PREFIX  16      // commands that can precede the data in ssd1306_write_cmd_data()
+#define SSD1306_FLUSH_TASK_STACK 2048   // stack depth of the asynchronous flush task
+
+#define SSD1306_ADDR_MODE_HORIZONTAL    0x00
+#define SSD1306_ADDR_MODE_PAGE          0x02
+
+// Bytes on the wire in front of the data of a diff flush transaction: address byte, commands
+// with their control bytes, data control byte
+#define SSD1306_DIFF_WINDOW_COST    (1 + 2 * 6 + 1)     // column and page window (0x21, 0x22)
+#define SSD1306_DIFF_PAGE_COST      (1 + 2 * 3 + 1)     // page start and both column nibbles
+#define SSD1306_DIFF_COLUMN_COST    (1 + 2 * 2 + 1)     // column nibbles, same page as the previous run
+#define SSD1306_DIFF_DATA_COST      (1 + 1)             // data continuing the previous window
+#define SSD1306_DIFF_MODE_COST      (2 * 2)             // addressing mode switch (0x20)
+
+#if SSD1306_ENABLE_STATS
+#include "esp_timer.h"
+
+static ssd1306_stats_t stats;
+
+#define SSD1306_STAT_ADD(field, n)          (stats.field += (n))
+#define SSD1306_STAT_CALL(primitive)        (stats.calls[primitive]++)
+#define SSD1306_STAT_TIMESTAMP(var)         int64_t var = esp_timer_get_time()
+#define SSD1306_STAT_FLUSH(started)         ssd1306_stats_record_flush(esp_timer_get_time() - (started))
+#define SSD1306_STAT_TRANSFER(p, pl, dl, e) ssd1306_stats_record_transfer(p, pl, dl, e)
+#else
+#define SSD1306_STAT_ADD(field, n)          ((void)0)
+#define SSD1306_STAT_CALL(primitive)        ((void)0)
+#define SSD1306_STAT_TIMESTAMP(var)         ((void)0)
+#define SSD1306_STAT_FLUSH(started)         ((void)0)
+#define SSD1306_STAT_TRANSFER(p, pl, dl, e) ((void)0)
+#endif
+
+// With a fixed geometry the panel size is a compile-time constant, so page and column loops have
+// constant bounds and row offsets are shifts
+#ifdef CONFIG_SSD1306_FIXED_GEOMETRY
+#define SSD1306_DEV_WIDTH(dev)  SCREEN_WIDTH
+#define SSD1306_DEV_HEIGHT(dev) SCREEN_HEIGHT
+#define SSD1306_DEV_PAGES(dev)  SCREEN_PAGES
+#else
+#define SSD1306_DEV_WIDTH(dev)  ((dev)->width)
+#define SSD1306_DEV_HEIGHT(dev) ((dev)->height)
+#define SSD1306_DEV_PAGES(dev)  ((dev)->pages)
+#endif
+
+// Framebuffer row of a page; inside ssd1306_render_paged() buffer holds only the band from band_first_page on
+#define SSD1306_DEV_ROW(dev, page)  (&(dev)->buffer[((page) - (dev)->band_first_page) * SSD1306_DEV_WIDTH(dev)])
+
+// COM pin configuration (0xDA) of ssd1306_default
+#ifdef CONFIG_SSD1306_COM_ALTERNATIVE
+#define SSD1306_COM_PINS_ALT    0x10
+#else
+#define SSD1306_COM_PINS_ALT    0x00
+#endif
+#ifdef CONFIG_SSD1306_COM_REMAP
+#define SSD1306_COM_PINS_REMAP  0x20
+#else
+#define SSD1306_COM_PINS_REMAP  0x00
+#endif
+#define SSD1306_COM_PINS        (0x02 | SSD1306_COM_PINS_ALT | SSD1306_COM_PINS_REMAP)
+
+#ifdef CONFIG_SSD1306_FRAMEBUFFER_STATIC
 uint8_t buffer[BUFFER_SIZE];
+#define SSD1306_DEFAULT_BUFFER  buffer
+#else
+#define SSD1306_DEFAULT_BUFFER  NULL    // allocated by ssd1306_init()
+#endif
+
+ssd1306_t ssd1306_default = {
+    .i2c_num = I2C_NUM,
+    .address = SSD1306_ADDR,
+    .width = SCREEN_WIDTH,
+    .height = SCREEN_HEIGHT,
+    .pages = SCREEN_PAGES,
+    .buffer = SSD1306_DEFAULT_BUFFER,
+    .buffer_size = BUFFER_SIZE,
+    .col_offset = CONFIG_SSD1306_COLUMN_OFFSET,
+    .multiplex = CONFIG_SSD1306_MULTIPLEX,
+    .com_pins = SSD1306_COM_PINS,
+    .clip = { 0, 0, SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1, 0, 0 }
+};
+
+#ifndef SSD1306_DEFAULT_TRANSPORT
+#define SSD1306_DEFAULT_TRANSPORT   (&ssd1306_i2c_transport)   // host builds pass NULL and install their own
+#endif
+
+static const ssd1306_transport_t* transport = SSD1306_DEFAULT_TRANSPORT;
+static bool bus_ready;
 
 const char font5x7[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00,// (space)
@@ -121,431 +209,2593 @@ const char font5x7[] = {
 	0x08, 0x1C, 0x2A, 0x08, 0x08 // <-
 };
 
-esp_err_t i2c_init(void)
+#if SSD1306_ENABLE_STATS
+static void ssd1306_stats_record_transfer(const uint8_t* prefix, size_t prefix_len, size_t data_len, esp_err_t err)
 {
-    int i2c_port = I2C_NUM;
+    // The last control byte tells whether the payload is GDDRAM data or more commands
+    if (prefix[prefix_len - 1] == SSD1306_DATA) {
+        stats.data_transactions++;
+        stats.cmd_bytes += prefix_len;
+        stats.data_bytes += data_len;
+    } else {
+        stats.cmd_transactions++;
+        stats.cmd_bytes += prefix_len + data_len;
+    }
 
-    i2c_config_t conf = {
-        .mode = I2C_MODE_MASTER,
-        .scl_io_num = I2C_SCL_IO,
-        .scl_pullup_en = 1,
-        .sda_io_num = I2C_SDA_IO,
-        .sda_pullup_en = 1,
-        .clk_stretch_tick = 300
-    };
+    if (err == ESP_ERR_TIMEOUT) {
+        stats.i2c_timeouts++;
+    } else if (err != ESP_OK) {
+        stats.i2c_errors++;
+    }
+}
+
+static void ssd1306_stats_record_flush(int64_t elapsed)
+{
+    uint32_t us = elapsed;
+    uint8_t bucket = 0;
+
+    while (bucket < SSD1306_STATS_HIST_BUCKETS - 1 && us >= ((uint32_t)SSD1306_STATS_HIST_BASE_US << bucket)) bucket++;
+    stats.flush_hist[bucket]++;
 
-    ESP_ERROR_CHECK(i2c_driver_install(i2c_port, conf.mode));
-    ESP_ERROR_CHECK(i2c_param_config(i2c_port, &conf));
+    if (!stats.flushes || us < stats.flush_min_us) stats.flush_min_us = us;
+    if (us > stats.flush_max_us) stats.flush_max_us = us;
+    stats.flush_total_us += us;
+    stats.flushes++;
+}
+#endif
 
+esp_err_t ssd1306_stats_get(ssd1306_stats_t* out)
+{
+#if SSD1306_ENABLE_STATS
+    *out = stats;
+    out->flush_avg_us = stats.flushes ? stats.flush_total_us / stats.flushes : 0;
     return ESP_OK;
+#else
+    memset(out, 0, sizeof(*out));
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+void ssd1306_stats_reset(void)
+{
+#if SSD1306_ENABLE_STATS
+    memset(&stats, 0, sizeof(stats));
+#endif
+}
+
+void ssd1306_stats_add_pixels(uint32_t pixels)
+{
+    SSD1306_STAT_ADD(pixels, pixels);
+}
+
+void ssd1306_set_transport(const ssd1306_transport_t* t)
+{
+    transport = t;
+}
+
+// One I2C transaction: address, the control/command prefix, then optional display data
+static esp_err_t ssd1306_transfer(i2c_port_t i2c_num, uint8_t address, const uint8_t* prefix, size_t prefix_len, const uint8_t* data, size_t data_len)
+{
+    if (!transport) return ESP_ERR_INVALID_STATE;
+
+    esp_err_t err = transport->write(transport->ctx, i2c_num, address, prefix, prefix_len, data, data_len);
+    SSD1306_STAT_TRANSFER(prefix, prefix_len, data_len, err);
+    return err;
+}
+
+// Brings up the bus behind the transport once, however many panels share it
+static esp_err_t ssd1306_bus_init(void)
+{
+    if (bus_ready) return ESP_OK;
+    if (!transport) return ESP_ERR_INVALID_STATE;
+
+    esp_err_t err = transport->init ? transport->init(transport->ctx) : ESP_OK;
+    if (err == ESP_OK) bus_ready = true;
+    return err;
+}
+
+// One transaction to a register of the panel: a single control byte, then the payload
+static esp_err_t ssd1306_write_reg(const ssd1306_t* dev, uint8_t reg_address, const uint8_t* data, size_t data_len)
+{
+    return ssd1306_transfer(dev->i2c_num, dev->address, &reg_address, 1, data, data_len);
 }
 
 void ssd1306_write(i2c_port_t i2c_num, uint8_t reg_address, uint8_t* data, size_t data_len)
 {
-    i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create();
+    ssd1306_transfer(i2c_num, ssd1306_default.address, &reg_address, 1, data, data_len);
+}
+
+static esp_err_t ssd1306_dev_write_cmd_data(const ssd1306_t* dev, i2c_port_t i2c_num, const uint8_t* cmds, size_t cmd_len, uint8_t* data, size_t data_len)
+{
+    // Co/D-C control byte in front of every command, then one data control byte for the rest
+    uint8_t prefix[2 * SSD1306_MAX_CMD_PREFIX + 1];
+    size_t prefix_len = 0;
+
+    if (cmd_len > SSD1306_MAX_CMD_PREFIX) cmd_len = SSD1306_MAX_CMD_PREFIX;
+    for (size_t i = 0; i < cmd_len; i++) {
+        prefix[prefix_len++] = SSD1306_CMD_CO;
+        prefix[prefix_len++] = cmds[i];
+    }
+    prefix[prefix_len++] = SSD1306_DATA;
 
-    i2c_master_start(cmd_handle);
-    i2c_master_write_byte(cmd_handle, SSD1306_ADDR << 1 | WRITE_BIT, ACK_CHECK_EN);
-    i2c_master_write_byte(cmd_handle, reg_address, ACK_CHECK_EN);
-    i2c_master_write(cmd_handle, data, data_len, ACK_CHECK_EN);
-    i2c_master_stop(cmd_handle);
-    i2c_master_cmd_begin(i2c_num, cmd_handle, 1000 / portTICK_RATE_MS);
-    i2c_cmd_link_delete(cmd_handle);
+    return ssd1306_transfer(i2c_num, dev->address, prefix, prefix_len, data, data_len);
 }
 
-void ssd1306_init(void)
+void ssd1306_write_cmd_data(i2c_port_t i2c_num, const uint8_t* cmds, size_t cmd_len, uint8_t* data, size_t data_len)
 {
+    ssd1306_dev_write_cmd_data(&ssd1306_default, i2c_num, cmds, cmd_len, data, data_len);
+}
+
+// Sends the init sequence for the panel's geometry, leaving the display on and blank
+static void ssd1306_dev_setup(ssd1306_t* dev)
+{
+    uint8_t multiplex = dev->multiplex ? dev->multiplex : SSD1306_DEV_HEIGHT(dev);
+    uint8_t com_pins = dev->com_pins ? dev->com_pins : SSD1306_DEV_HEIGHT(dev) == 32 ? 0x02 : 0x12;
+
+    dev->clock = 0x80;
+    dev->precharge = 0xF1;
+
     uint8_t init_cmds[] = {
         0xAE,                // Display OFF
-        0xD5, 0x80,          // Set display clock divide ratio/oscillator frequency
-        0xA8, 0x3F,          // Set multiplex ratio (0x3F = 64)
+        0xD5, dev->clock,    // Set display clock divide ratio/oscillator frequency
+        0xA8, multiplex - 1, // Set multiplex ratio (0x3F = 64)
         0xD3, 0x00,          // Set display offset to 0
         0x40,                // Set start line to 0
         0x8D, 0x14,          // Enable charge pump
         0x20, 0x00,          // Memory addressing mode: Horizontal
+#ifdef CONFIG_SSD1306_ROTATE_180
+        0xA0,                // Segment re-map off (column address 0 mapped to SEG0)
+        0xC0,                // COM output scan direction: normal (scan top-to-bottom)
+#else
         0xA1,                // Set segment re-map (column address 127 mapped to SEG0)
         0xC8,                // COM output scan direction: remapped mode (scan bottom-to-top)
-        0xDA, 0x12,          // COM pins hardware config
+#endif
+        0xDA, com_pins,      // COM pins hardware config (sequential on 128x32)
+#ifdef CONFIG_SSD1306_INTERNAL_IREF
+        0xAD, 0x30,          // Internal current reference (72x40 modules)
+#endif
         0x81, 0x7F,          // Contrast control
-        0xD9, 0xF1,          // Pre-charge period
+        0xD9, dev->precharge,// Pre-charge period
         0xDB, 0x40,          // VCOMH deselect level
         0xA4,                // Entire display ON (resume to RAM content)
         0xA6,                // Normal display (not inverted)
         0xAF                 // Display ON
     };
 
-    i2c_init();
-    
-    for (int i = 0; i < sizeof(init_cmds); i++) {
-        ssd1306_cmd(init_cmds[i]);
+    ssd1306_dev_cmd_list(dev, init_cmds, sizeof(init_cmds));
+    dev->addr_mode = SSD1306_ADDR_MODE_HORIZONTAL;
+    if (dev->buffer) {
+        ssd1306_dev_clear(dev);
+        ssd1306_dev_display_full(dev);
+    } else {
+        ssd1306_dev_render_paged(dev, NULL, NULL, NULL, 0, NULL);
     }
+}
 
-    ssd1306_clear();
-    ssd1306_display();
+void ssd1306_init(void)
+{
+#ifdef CONFIG_SSD1306_FRAMEBUFFER_HEAP
+    if (!ssd1306_default.buffer) {
+        ssd1306_default.buffer = calloc(1, BUFFER_SIZE);
+        if (!ssd1306_default.buffer) ESP_ERROR_CHECK(ESP_ERR_NO_MEM);
+    }
+#endif
+    ESP_ERROR_CHECK(ssd1306_bus_init());
+    ssd1306_dev_setup(&ssd1306_default);
 }
 
-void ssd1306_cmd(uint8_t cmd)
+esp_err_t ssd1306_dev_init(ssd1306_t* dev, const ssd1306_config_t* config)
 {
-    i2c_port_t i2c_port = I2C_NUM;
-    uint8_t cmd_arr[] = { cmd };
-    ssd1306_write(i2c_port, SSD1306_CMD, cmd_arr, sizeof(cmd_arr));
+    if (!config->width || config->width > SSD1306_MAX_WIDTH) return ESP_ERR_INVALID_ARG;
+    if (!config->height || config->height > SSD1306_MAX_HEIGHT || config->height % 8) return ESP_ERR_INVALID_ARG;
+    if (config->col_offset + config->width > SSD1306_GDDRAM_WIDTH) return ESP_ERR_INVALID_ARG;
+#ifdef CONFIG_SSD1306_FIXED_GEOMETRY
+    if (config->width != SCREEN_WIDTH || config->height != SCREEN_HEIGHT) return ESP_ERR_INVALID_ARG;
+#endif
+
+    memset(dev, 0, sizeof(*dev));
+    dev->i2c_num = config->i2c_num;
+    dev->address = config->address;
+    dev->width = config->width;
+    dev->height = config->height;
+    dev->pages = config->height / 8;
+    dev->col_offset = config->col_offset;
+    dev->multiplex = config->multiplex;
+    dev->com_pins = config->com_pins;
+    dev->buffer_size = SSD1306_DEV_WIDTH(dev) * SSD1306_DEV_PAGES(dev);
+    dev->buffer = config->buffer ? config->buffer : malloc(dev->buffer_size);
+    if (!dev->buffer) return ESP_ERR_NO_MEM;
+    memset(dev->buffer, 0x00, dev->buffer_size);
+    dev->clip = (ssd1306_clip_t){ 0, 0, SSD1306_DEV_WIDTH(dev) - 1, SSD1306_DEV_HEIGHT(dev) - 1, 0, 0 };
+
+    esp_err_t err = ssd1306_bus_init();
+    if (err != ESP_OK) return err;
+
+    ssd1306_dev_setup(dev);
+    return ESP_OK;
 }
 
-void ssd1306_display(void)
+void ssd1306_dev_cmd(ssd1306_t* dev, uint8_t cmd)
 {
-    // Set column address range: 0 to 127
-    ssd1306_cmd(0x21);
-    ssd1306_cmd(0x00);
-    ssd1306_cmd(0x7F);
+    uint8_t cmd_arr[] = { cmd };
+    ssd1306_write_reg(dev, SSD1306_CMD, cmd_arr, sizeof(cmd_arr));
+}
 
-    // Set page address range: 0 to 7
-    ssd1306_cmd(0x22);
-    ssd1306_cmd(0x00);
-    ssd1306_cmd(0x07);
+void ssd1306_dev_cmd_list(ssd1306_t* dev, const uint8_t* cmds, size_t len)
+{
+    ssd1306_write_reg(dev, SSD1306_CMD, cmds, len);
+}
 
-    // Send entire buffer
-    ssd1306_data(buffer, BUFFER_SIZE);
+static inline void ssd1306_mark_dirty_page(ssd1306_t* dev, uint8_t page, uint8_t x_start, uint8_t x_end)
+{
+    if (!dev->dirty_end[page]) {
+        dev->dirty_start[page] = x_start;
+        dev->dirty_end[page] = x_end + 1;
+        return;
+    }
+    if (x_start < dev->dirty_start[page]) dev->dirty_start[page] = x_start;
+    if (x_end >= dev->dirty_end[page]) dev->dirty_end[page] = x_end + 1;
 }
 
-void ssd1306_clear(void)
+void ssd1306_dev_mark_dirty(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h)
 {
-    memset(buffer, 0x00, sizeof(buffer)); // clears buffer
+    if (!w || !h || x >= SSD1306_DEV_WIDTH(dev) || y >= SSD1306_DEV_HEIGHT(dev)) return;
+
+    int x_end = x + w - 1;
+    int y_end = y + h - 1;
+    if (x_end >= SSD1306_DEV_WIDTH(dev)) x_end = SSD1306_DEV_WIDTH(dev) - 1;
+    if (y_end >= SSD1306_DEV_HEIGHT(dev)) y_end = SSD1306_DEV_HEIGHT(dev) - 1;
+
+    for (uint8_t page = y / 8; page <= y_end / 8; page++) {
+        ssd1306_mark_dirty_page(dev, page, x, x_end);
+    }
 }
 
-void ssd1306_data(uint8_t* data, size_t len)
+// Sends columns [x_start, x_end] of pages [first_page, last_page] through a horizontal-mode window.
+// The window wraps from x_end to x_start of the next page, so pages that are not contiguous in the
+// framebuffer follow in data-only transactions. fb points at the row of first_page.
+static void ssd1306_flush_window(ssd1306_t* dev, const uint8_t* fb, uint8_t first_page, uint8_t last_page, uint8_t x_start, uint8_t x_end)
 {
-    int i2c_port = I2C_NUM;
-    ssd1306_write(i2c_port, SSD1306_DATA, data, len);
+    uint8_t cmds[8];
+    size_t cmd_len = 0;
+    uint8_t width = SSD1306_DEV_WIDTH(dev);
+    bool full_width = x_start == 0 && x_end == width - 1;
+
+    if (dev->addr_mode != SSD1306_ADDR_MODE_HORIZONTAL) {
+        cmds[cmd_len++] = 0x20;
+        cmds[cmd_len++] = SSD1306_ADDR_MODE_HORIZONTAL;
+        dev->addr_mode = SSD1306_ADDR_MODE_HORIZONTAL;
+    }
+    cmds[cmd_len++] = 0x21;     // Set column address range
+    cmds[cmd_len++] = dev->col_offset + x_start;
+    cmds[cmd_len++] = dev->col_offset + x_end;
+    cmds[cmd_len++] = 0x22;     // Set page address range
+    cmds[cmd_len++] = first_page;
+    cmds[cmd_len++] = last_page;
+
+    // Address window and the span (or the run of full pages) in one transaction
+    uint8_t data_last = full_width ? last_page : first_page;
+    size_t len = (size_t)(data_last - first_page) * width + (x_end - x_start + 1);
+    ssd1306_dev_write_cmd_data(dev, dev->i2c_num, cmds, cmd_len, (uint8_t*)&fb[x_start], len);
+
+    for (uint8_t page = data_last + 1; page <= last_page; page++) {
+        ssd1306_dev_write_cmd_data(dev, dev->i2c_num, NULL, 0, (uint8_t*)&fb[(page - first_page) * width + x_start], x_end - x_start + 1);
+    }
 }
 
-void ssd1306_draw_pixel(uint8_t x, uint8_t y, bool color)
+// Finds the next run of columns from *x on that differ from the shadow, merging gaps of unchanged
+// bytes that cost less to resend than addressing a new run. A stale page is one run.
+static bool ssd1306_diff_next_run(const uint8_t* fb_row, const uint8_t* shadow_row, bool stale, int* x, int end, int* run_start, int* run_end)
 {
-    if (x >= SCREEN_WIDTH || y >= SCREEN_HEIGHT) return;
-    if (color)
-        buffer[x + (y / 8) * SCREEN_WIDTH] |= (1 << (y % 8));
-    else
-        buffer[x + (y / 8) * SCREEN_WIDTH] &= ~(1 << (y % 8));
+    int i = *x;
+
+    if (!stale) {
+        while (i < end && fb_row[i] == shadow_row[i]) i++;
+    }
+    if (i >= end) return false;
+
+    *run_start = i;
+    *run_end = stale ? end - 1 : i;
+    for (i++; i < end && !stale; i++) {
+        if (fb_row[i] != shadow_row[i]) {
+            *run_end = i;
+        } else if (i - *run_end > SSD1306_DIFF_COLUMN_COST) {
+            break;
+        }
+    }
+    *x = stale ? end : i;
+    return true;
 }
 
-void ssd1306_draw_char(uint8_t x, uint8_t y, char c, uint8_t size_x, uint8_t size_y, bool color)
+// Diffs the dirty spans against the shadow and sends the changes the cheapest way: one window
+// around all of them, or page-mode runs
+static void ssd1306_flush_diff(ssd1306_t* dev, uint8_t* fb, uint8_t* fb_dirty_start, uint8_t* fb_dirty_end)
 {
-    if (c < 32 || c > 126) return; // unsupported char
+    uint8_t width = SSD1306_DEV_WIDTH(dev);
+    int first_page = -1;
+    int last_page = 0;
+    int x_min = width;
+    int x_max = -1;
+    int run_start, run_end;
 
-    uint16_t index = (c - 32) * 5;
+    // Pass 1: what the page-mode runs would cost, and the bounding box of the changes
+    int runs_cost = dev->addr_mode == SSD1306_ADDR_MODE_PAGE ? 0 : SSD1306_DIFF_MODE_COST;
+    for (uint8_t page = 0; page < SSD1306_DEV_PAGES(dev); page++) {
+        if (!fb_dirty_end[page]) continue;
 
-    for (uint8_t i = 0; i < 5; i++) {
-        uint8_t line = font5x7[index + i];
-        for (uint8_t j = 0; j < 8; j++) {
-            if (line & 0x01) {
-                // Scale by size_x and size_y
-                for (uint8_t dx = 0; dx < size_x; dx++) {
-                    for (uint8_t dy = 0; dy < size_y; dy++) {
-                        ssd1306_draw_pixel(x + i * size_x + dx, y + j * size_y + dy, color);
+        const uint8_t* row = &fb[page * width];
+        const uint8_t* shadow_row = &dev->shadow[page * width];
+        bool stale = dev->shadow_stale & (1 << page);
+        int x = fb_dirty_start[page];
+        int run_cost = SSD1306_DIFF_PAGE_COST;
+
+        while (ssd1306_diff_next_run(row, shadow_row, stale, &x, fb_dirty_end[page], &run_start, &run_end)) {
+            runs_cost += run_cost + run_end - run_start + 1;
+            run_cost = SSD1306_DIFF_COLUMN_COST;
+            if (first_page < 0) first_page = page;
+            last_page = page;
+            if (x_min > run_start) x_min = run_start;
+            if (x_max < run_end) x_max = run_end;
+        }
+    }
+
+    if (first_page >= 0) {
+        int pages = last_page - first_page + 1;
+        int window_cost = (dev->addr_mode == SSD1306_ADDR_MODE_HORIZONTAL ? 0 : SSD1306_DIFF_MODE_COST)
+                        + SSD1306_DIFF_WINDOW_COST + pages * (x_max - x_min + 1);
+        if (x_min != 0 || x_max != width - 1) window_cost += (pages - 1) * SSD1306_DIFF_DATA_COST;
+
+        if (window_cost <= runs_cost) {
+            // The window also resends unchanged bytes around the dirty spans. Outside its spans the
+            // back buffer of an asynchronous flush may hold an older frame, so it gets the shadow's.
+            if (fb != dev->buffer) {
+                for (uint8_t page = first_page; page <= last_page; page++) {
+                    uint8_t* row = &fb[page * width];
+                    const uint8_t* shadow_row = &dev->shadow[page * width];
+                    int start = fb_dirty_end[page] ? fb_dirty_start[page] : x_max + 1;
+                    int end = fb_dirty_end[page] ? fb_dirty_end[page] : x_max + 1;
+                    if (start > x_min) memcpy(&row[x_min], &shadow_row[x_min], start - x_min);
+                    if (end <= x_max) memcpy(&row[end], &shadow_row[end], x_max + 1 - end);
+                }
+            }
+            ssd1306_flush_window(dev, &fb[first_page * width], first_page, last_page, x_min, x_max);
+        } else {
+            // Pass 2: one transaction per run; the page is only addressed for its first run
+            for (uint8_t page = first_page; page <= last_page; page++) {
+                if (!fb_dirty_end[page]) continue;
+
+                const uint8_t* row = &fb[page * width];
+                bool stale = dev->shadow_stale & (1 << page);
+                bool addressed = false;
+                int x = fb_dirty_start[page];
+
+                while (ssd1306_diff_next_run(row, &dev->shadow[page * width], stale, &x, fb_dirty_end[page], &run_start, &run_end)) {
+                    uint8_t cmds[5];
+                    size_t cmd_len = 0;
+                    uint8_t column = dev->col_offset + run_start;
+
+                    if (dev->addr_mode != SSD1306_ADDR_MODE_PAGE) {
+                        cmds[cmd_len++] = 0x20;
+                        cmds[cmd_len++] = SSD1306_ADDR_MODE_PAGE;
+                        dev->addr_mode = SSD1306_ADDR_MODE_PAGE;
                     }
+                    if (!addressed) cmds[cmd_len++] = 0xB0 | page;     // Page start address
+                    cmds[cmd_len++] = column & 0x0F;                    // Lower column nibble
+                    cmds[cmd_len++] = 0x10 | column >> 4;               // Higher column nibble
+                    addressed = true;
+
+                    ssd1306_dev_write_cmd_data(dev, dev->i2c_num, cmds, cmd_len, (uint8_t*)&row[run_start], run_end - run_start + 1);
                 }
             }
-            line >>= 1;
         }
     }
 
-    // Add spacing column (blank)
-    for (uint8_t j = 0; j < 8; j++) {
-        for (uint8_t dx = 0; dx < size_x; dx++) {
-            for (uint8_t dy = 0; dy < size_y; dy++) {
-                ssd1306_draw_pixel(x + 5 * size_x + dx, y + j * size_y + dy, COLOR_BLACK);
-            }
-        }
+    // GDDRAM now matches the framebuffer in every dirty span
+    for (uint8_t page = 0; page < SSD1306_DEV_PAGES(dev); page++) {
+        if (!fb_dirty_end[page]) continue;
+        memcpy(&dev->shadow[page * width + fb_dirty_start[page]], &fb[page * width + fb_dirty_start[page]], fb_dirty_end[page] - fb_dirty_start[page]);
+        dev->shadow_stale &= ~(1 << page);
+        fb_dirty_end[page] = 0;
     }
 }
 
-void ssd1306_draw_string(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, bool color)
+static void ssd1306_flush_spans(ssd1306_t* dev, uint8_t* fb, uint8_t* fb_dirty_start, uint8_t* fb_dirty_end)
 {
-    while (*str) {
-        ssd1306_draw_char(x, y, *str++, size_x, size_y, color);
-        x += (6 * size_x); // 5 pixels + 1 space, scaled
+    uint8_t page = 0;
+
+    // GDDRAM must not be written while the controller scrolls; the spans stay dirty until ssd1306_scroll_stop()
+    if (dev->scrolling) return;
+
+    SSD1306_STAT_TIMESTAMP(started);
+
+    if (dev->shadow) {
+        ssd1306_flush_diff(dev, fb, fb_dirty_start, fb_dirty_end);
+        SSD1306_STAT_FLUSH(started);
+        return;
     }
-}
 
-void ssd1306_draw_string_wrapped(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, bool color)
-{
-    uint8_t start_x = x;
-    while (*str) {
-        if (x + (6 * size_x) >= SCREEN_WIDTH) {
-            x = start_x;
-            y += (8 * size_y); // next line
-            if (y >= SCREEN_HEIGHT) break; // stop if bottom reached
+    bool sent = false;
+    while (page < SSD1306_DEV_PAGES(dev)) {
+        if (!fb_dirty_end[page]) {
+            page++;
+            continue;
+        }
+
+        uint8_t x_start = fb_dirty_start[page];
+        uint8_t x_end = fb_dirty_end[page] - 1;
+        uint8_t last_page = page;
+
+        // Full-width pages are contiguous in the buffer, so a run of them goes out as one window
+        if (x_start == 0 && x_end == SSD1306_DEV_WIDTH(dev) - 1) {
+            while (last_page + 1 < SSD1306_DEV_PAGES(dev) && fb_dirty_end[last_page + 1] == SSD1306_DEV_WIDTH(dev)
+                   && fb_dirty_start[last_page + 1] == 0) {
+                last_page++;
+            }
+        }
+
+        ssd1306_flush_window(dev, &fb[page * SSD1306_DEV_WIDTH(dev)], page, last_page, x_start, x_end);
+        sent = true;
+
+        for (; page <= last_page; page++) {
+            fb_dirty_end[page] = 0;
         }
-        ssd1306_draw_char(x, y, *str++, size_x, size_y, color);
-        x += (6 * size_x);
     }
+
+    if (sent) SSD1306_STAT_FLUSH(started);
 }
 
-void ssd1306_draw_string_char_by_char(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, bool color)
+// Lets a pending asynchronous flush land first so older content cannot overwrite newer
+static void ssd1306_wait_idle(ssd1306_t* dev)
 {
-    while (*str) {
-        ssd1306_draw_char(x, y, *str++, size_x, size_y, color);
-        x += (6 * size_x); // 5 pixels + 1 space, scaled
-		vTaskDelay(tick_delay_ms / portTICK_PERIOD_MS);
-		ssd1306_display();
+    if (dev->flush_idle) {
+        xSemaphoreTake(dev->flush_idle, portMAX_DELAY);
+        xSemaphoreGive(dev->flush_idle);
     }
 }
 
-void ssd1306_draw_string_wrapped_char_by_char(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, bool color)
+void ssd1306_dev_display(ssd1306_t* dev)
 {
-    uint8_t start_x = x;
-    while (*str) {
-        if (x + (6 * size_x) >= SCREEN_WIDTH) {
-            x = start_x;
-            y += (8 * size_y); // next line
-            if (y >= SCREEN_HEIGHT) break; // stop if bottom reached
-        }
-        ssd1306_draw_char(x, y, *str++, size_x, size_y, color);
-        x += (6 * size_x);
-		vTaskDelay(tick_delay_ms / portTICK_PERIOD_MS);
-		ssd1306_display();
-    }
+    if (!dev->buffer) return;
+    ssd1306_wait_idle(dev);
+    ssd1306_flush_spans(dev, dev->buffer, dev->dirty_start, dev->dirty_end);
 }
 
-uint8_t ssd1306_get_string_width(const char* str, uint8_t size_x)
+esp_err_t ssd1306_dev_diff_flush_start(ssd1306_t* dev)
 {
-    return strlen(str) * 6 * size_x;
+    if (dev->shadow) return ESP_OK;
+    if (dev->scrolling || !dev->buffer) return ESP_ERR_INVALID_STATE;
+
+    uint8_t* shadow = malloc(dev->buffer_size);
+    if (!shadow) return ESP_ERR_NO_MEM;
+
+    // Once the pending spans are out, GDDRAM holds the framebuffer
+    ssd1306_dev_display(dev);
+    memcpy(shadow, dev->buffer, dev->buffer_size);
+    dev->shadow_stale = 0;
+    dev->shadow = shadow;
+    return ESP_OK;
 }
 
-void ssd1306_draw_string_centered(uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, bool color)
+void ssd1306_dev_diff_flush_stop(ssd1306_t* dev)
 {
-    uint8_t str_w = ssd1306_get_string_width(str, size_x);
-    uint8_t x = (SCREEN_WIDTH - str_w) / 2;
-    ssd1306_draw_string(x, y, str, size_x, size_y, color);
+    ssd1306_wait_idle(dev);
+    free(dev->shadow);
+    dev->shadow = NULL;
 }
 
-void ssd1306_draw_string_centered_char_by_char(uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, bool color)
+static void ssd1306_flush_task(void* arg)
 {
-    uint8_t str_w = ssd1306_get_string_width(str, size_x);
-    uint8_t x = (SCREEN_WIDTH - str_w) / 2;
-    ssd1306_draw_string_char_by_char(x, y, str, size_x, size_y, tick_delay_ms, color);
+    ssd1306_t* dev = arg;
+
+    while (1) {
+        xSemaphoreTake(dev->flush_request, portMAX_DELAY);
+        ssd1306_flush_spans(dev, dev->back_buffer, dev->back_dirty_start, dev->back_dirty_end);
+        if (dev->flush_cb) dev->flush_cb(dev->flush_cb_arg);
+        xSemaphoreGive(dev->flush_idle);
+    }
 }
 
-void ssd1306_draw_full_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color)
+// Undoes a partial ssd1306_flush_task_start(), leaving the panel on synchronous flushes
+static void ssd1306_flush_task_free(ssd1306_t* dev)
 {
-    for (uint8_t i = x; i < x + w && i < SCREEN_WIDTH; i++) {
-        for (uint8_t j = y; j < y + h && j < SCREEN_HEIGHT; j++) {
-            ssd1306_draw_pixel(i, j, color);
-        }
-    }
+    free(dev->back_buffer);
+    if (dev->flush_request) vSemaphoreDelete(dev->flush_request);
+    if (dev->flush_idle) vSemaphoreDelete(dev->flush_idle);
+    dev->back_buffer = NULL;
+    dev->flush_request = NULL;
+    dev->flush_idle = NULL;
 }
 
-void ssd1306_draw_empty_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color)
+esp_err_t ssd1306_dev_flush_task_start(ssd1306_t* dev, UBaseType_t priority)
 {
-    for (uint8_t i = x; i < x + w && i < SCREEN_WIDTH; i++) {
-        ssd1306_draw_pixel(i, y, color);             // Top
-        ssd1306_draw_pixel(i, y + h - 1, color);      // Bottom
+    if (dev->flush_idle || !dev->buffer) return ESP_ERR_INVALID_STATE;
+
+    dev->back_buffer = malloc(dev->buffer_size);
+    dev->flush_request = xSemaphoreCreateBinary();
+    dev->flush_idle = xSemaphoreCreateBinary();
+    if (!dev->back_buffer || !dev->flush_request || !dev->flush_idle) {
+        ssd1306_flush_task_free(dev);
+        return ESP_ERR_NO_MEM;
     }
-    for (uint8_t j = y; j < y + h && j < SCREEN_HEIGHT; j++) {
-        ssd1306_draw_pixel(x, j, color);             // Left
-        ssd1306_draw_pixel(x + w - 1, j, color);     // Right
+
+    // The back buffer mirrors buffer everywhere except the dirty spans, which get copied on swap
+    memcpy(dev->back_buffer, dev->buffer, dev->buffer_size);
+
+    if (xTaskCreate(ssd1306_flush_task, "ssd1306_flush", SSD1306_FLUSH_TASK_STACK, dev, priority, NULL) != pdPASS) {
+        ssd1306_flush_task_free(dev);
+        return ESP_ERR_NO_MEM;
     }
+
+    // Only now is there a task to hand flushes to
+    xSemaphoreGive(dev->flush_idle);
+    return ESP_OK;
 }
 
-void ssd1306_draw_full_circle(uint8_t x0, uint8_t y0, uint8_t radius, bool color)
+esp_err_t ssd1306_dev_display_async(ssd1306_t* dev)
 {
-    int x = 0;
-    int y = radius;
-    int f = 1 - radius;
-    int ddF_x = 1;
-    int ddF_y = -2 * radius;
+    if (!dev->flush_idle) return ESP_ERR_INVALID_STATE;
 
-    // Draw center vertical line
-    for (int i = y0 - radius; i <= y0 + radius; i++) {
-        ssd1306_draw_pixel(x0, i, color);
-    }
+    // Only one flush in flight: wait for the back buffer to be free again
+    xSemaphoreTake(dev->flush_idle, portMAX_DELAY);
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
+    for (uint8_t page = 0; page < SSD1306_DEV_PAGES(dev); page++) {
+        if (!dev->dirty_end[page]) continue;
 
-        for (int i = y0 - y; i <= y0 + y; i++) {
-            ssd1306_draw_pixel(x0 + x, i, color);
-            ssd1306_draw_pixel(x0 - x, i, color);
-        }
-        for (int i = y0 - x; i <= y0 + x; i++) {
-            ssd1306_draw_pixel(x0 + y, i, color);
-            ssd1306_draw_pixel(x0 - y, i, color);
+        uint8_t x_start = dev->dirty_start[page];
+        size_t offset = page * SSD1306_DEV_WIDTH(dev) + x_start;
+        memcpy(&dev->back_buffer[offset], &dev->buffer[offset], dev->dirty_end[page] - x_start);
+
+        // Spans held back by an active scroll are still pending in the back buffer
+        if (dev->back_dirty_end[page]) {
+            if (x_start > dev->back_dirty_start[page]) x_start = dev->back_dirty_start[page];
+            if (dev->dirty_end[page] < dev->back_dirty_end[page]) dev->dirty_end[page] = dev->back_dirty_end[page];
         }
+        dev->back_dirty_start[page] = x_start;
+        dev->back_dirty_end[page] = dev->dirty_end[page];
+        dev->dirty_end[page] = 0;
     }
+
+    xSemaphoreGive(dev->flush_request);
+    return ESP_OK;
 }
 
-void ssd1306_draw_empty_circle(uint8_t x0, uint8_t y0, uint8_t radius, bool color)
+esp_err_t ssd1306_dev_wait_flush(ssd1306_t* dev, uint32_t timeout_ms)
 {
-    int x = 0;
-    int y = radius;
-    int f = 1 - radius;
-    int ddF_x = 1;
-    int ddF_y = -2 * radius;
+    if (!dev->flush_idle) return ESP_OK;
+
+    TickType_t ticks = timeout_ms == SSD1306_WAIT_FOREVER ? portMAX_DELAY : timeout_ms / portTICK_PERIOD_MS;
+    if (xSemaphoreTake(dev->flush_idle, ticks) != pdTRUE) return ESP_ERR_TIMEOUT;
+    xSemaphoreGive(dev->flush_idle);
+    return ESP_OK;
+}
 
-    ssd1306_draw_pixel(x0, y0 + radius, color);
-    ssd1306_draw_pixel(x0, y0 - radius, color);
-    ssd1306_draw_pixel(x0 + radius, y0, color);
-    ssd1306_draw_pixel(x0 - radius, y0, color);
+void ssd1306_dev_set_flush_callback(ssd1306_t* dev, ssd1306_flush_cb_t cb, void* arg)
+{
+    dev->flush_cb_arg = arg;
+    dev->flush_cb = cb;
+}
 
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
+esp_err_t ssd1306_dev_scroll_start(ssd1306_t* dev, ssd1306_scroll_dir_t dir, uint8_t start_page, uint8_t end_page, ssd1306_scroll_speed_t speed, uint8_t vertical_offset)
+{
+    if (start_page > end_page || end_page >= SSD1306_DEV_PAGES(dev)) return ESP_ERR_INVALID_ARG;
+    if (vertical_offset >= SSD1306_DEV_HEIGHT(dev)) return ESP_ERR_INVALID_ARG;
+
+    // Whatever is pending has to be on the panel before RAM access is locked
+    ssd1306_dev_scroll_stop(dev);
+    ssd1306_dev_display(dev);
+    esp_err_t err = ssd1306_dev_wait_flush(dev, SSD1306_WAIT_FOREVER);
+    if (err != ESP_OK) return err;
+
+    uint8_t horizontal[] = {
+        dir == SSD1306_SCROLL_LEFT ? 0x27 : 0x26,
+        0x00,                       // Dummy byte
+        start_page, speed, end_page,
+        0x00, 0xFF,                 // Dummy bytes
+        0x2F                        // Activate scroll
+    };
+    uint8_t diagonal[] = {
+        dir == SSD1306_SCROLL_DIAG_LEFT ? 0x2A : 0x29,
+        0x00,                       // Dummy byte
+        start_page, speed, end_page,
+        vertical_offset,            // Rows moved up per step
+        0x2F                        // Activate scroll
+    };
 
-        ssd1306_draw_pixel(x0 + x, y0 + y, color);
-        ssd1306_draw_pixel(x0 - x, y0 + y, color);
-        ssd1306_draw_pixel(x0 + x, y0 - y, color);
-        ssd1306_draw_pixel(x0 - x, y0 - y, color);
-        ssd1306_draw_pixel(x0 + y, y0 + x, color);
-        ssd1306_draw_pixel(x0 - y, y0 + x, color);
-        ssd1306_draw_pixel(x0 + y, y0 - x, color);
-        ssd1306_draw_pixel(x0 - y, y0 - x, color);
+    bool vertical = dir == SSD1306_SCROLL_DIAG_RIGHT || dir == SSD1306_SCROLL_DIAG_LEFT;
+    if (vertical) {
+        ssd1306_dev_cmd_list(dev, diagonal, sizeof(diagonal));
+    } else {
+        ssd1306_dev_cmd_list(dev, horizontal, sizeof(horizontal));
     }
+
+    // A diagonal scroll moves rows across the whole vertical scroll area, not only the given pages
+    dev->scroll_first_page = vertical ? 0 : start_page;
+    dev->scroll_last_page = vertical ? SSD1306_DEV_PAGES(dev) - 1 : end_page;
+    dev->scrolling = true;
+
+    return ESP_OK;
 }
 
-void ssd1306_draw_line(int x0, int y0, int x1, int y1, bool color)
+esp_err_t ssd1306_dev_scroll_set_vertical_area(ssd1306_t* dev, uint8_t fixed_rows, uint8_t scroll_rows)
 {
-    int dx = abs(x1 - x0);
-    int sx = x0 < x1 ? 1 : -1;
-    int dy = -abs(y1 - y0);
-    int sy = y0 < y1 ? 1 : -1;
-    int err = dx + dy;
+    if (fixed_rows + scroll_rows > dev->height) return ESP_ERR_INVALID_ARG;
 
-    while (1) {
-        ssd1306_draw_pixel(x0, y0, color);
-        if (x0 == x1 && y0 == y1) break;
-        int e2 = 2 * err;
-        if (e2 >= dy) { err += dy; x0 += sx; }
-        if (e2 <= dx) { err += dx; y0 += sy; }
-    }
+    uint8_t area[] = { 0xA3, fixed_rows, scroll_rows };
+    ssd1306_dev_cmd_list(dev, area, sizeof(area));
+    return ESP_OK;
 }
 
-void ssd1306_draw_horizontal_line(int x_start, int x_end, int y, bool color)
+void ssd1306_dev_scroll_stop(ssd1306_t* dev)
 {
-    if (y < 0 || y >= SCREEN_HEIGHT) return;
-    if (x_start > x_end) {
-        int temp = x_start;
-        x_start = x_end;
-        x_end = temp;
-    }
-    if (x_start < 0) x_start = 0;
-    if (x_end >= SCREEN_WIDTH) x_end = SCREEN_WIDTH - 1;
-    for (int x = x_start; x <= x_end; x++) {
-        ssd1306_draw_pixel(x, y, color);
+    if (!dev->scrolling) return;
+
+    ssd1306_dev_cmd(dev, 0x2E);  // Deactivate scroll
+    dev->scrolling = false;
+
+    // The controller shifted GDDRAM while scrolling; the scrolled pages must be rewritten
+    for (uint8_t page = dev->scroll_first_page; page <= dev->scroll_last_page; page++) {
+        dev->shadow_stale |= 1 << page;
     }
+    ssd1306_dev_mark_dirty(dev, 0, dev->scroll_first_page * 8, SSD1306_DEV_WIDTH(dev), (dev->scroll_last_page - dev->scroll_first_page + 1) * 8);
 }
 
-void ssd1306_draw_empty_triangle(int x0, int y0, int x1, int y1, int x2, int y2, bool color)
+bool ssd1306_dev_is_scrolling(ssd1306_t* dev)
 {
-    ssd1306_draw_line(x0, y0, x1, y1, color);
-    ssd1306_draw_line(x1, y1, x2, y2, color);
-    ssd1306_draw_line(x2, y2, x0, y0, color);
+    return dev->scrolling;
 }
 
-void ssd1306_draw_filled_triangle(int x0, int y0, int x1, int y1, int x2, int y2, bool color)
+void ssd1306_dev_display_full(ssd1306_t* dev)
 {
-    // Sort vertices by y-coordinate (ascending)
-    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
-    if (y1 > y2) { int t = y1; y1 = y2; y2 = t; t = x1; x1 = x2; x2 = t; }
-    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+    ssd1306_wait_idle(dev);
 
-    if (y0 == y2) {
-        // Degenerate triangle (all on one line)
-        int min_x = x0 < x1 ? (x0 < x2 ? x0 : x2) : (x1 < x2 ? x1 : x2);
-        int max_x = x0 > x1 ? (x0 > x2 ? x0 : x2) : (x1 > x2 ? x1 : x2);
-        ssd1306_draw_horizontal_line(min_x, max_x, y0, color);
-        return;
+    // Whatever the panel shows, the shadow must not be trusted to skip anything
+    dev->shadow_stale = 0xFF;
+    ssd1306_dev_mark_dirty(dev, 0, 0, SSD1306_DEV_WIDTH(dev), SSD1306_DEV_HEIGHT(dev));
+    ssd1306_dev_display(dev);
+}
+
+// Kept out of ssd1306_render_paged() so callers passing their own band do not pay for the page on the stack
+static esp_err_t ssd1306_render_one_page(ssd1306_t* dev, ssd1306_page_draw_cb_t draw, void* arg, ssd1306_paged_stats_t* stats)
+{
+    uint8_t one_page[SSD1306_MAX_WIDTH];
+    return ssd1306_dev_render_paged(dev, draw, arg, one_page, SSD1306_DEV_WIDTH(dev), stats);
+}
+
+esp_err_t ssd1306_dev_render_paged(ssd1306_t* dev, ssd1306_page_draw_cb_t draw, void* arg, uint8_t* band, size_t band_size, ssd1306_paged_stats_t* stats)
+{
+    uint8_t width = SSD1306_DEV_WIDTH(dev);
+
+    if (!band) return ssd1306_render_one_page(dev, draw, arg, stats);
+    size_t band_pages = band_size / width;
+    if (!band_pages) return ESP_ERR_INVALID_ARG;
+    if (band_pages > SSD1306_DEV_PAGES(dev)) band_pages = SSD1306_DEV_PAGES(dev);
+    if (dev->scrolling) return ESP_ERR_INVALID_STATE;
+    ssd1306_wait_idle(dev);
+
+    // The framebuffer, its dirty spans and the clip are borrowed and given back untouched
+    uint8_t* buffer_saved = dev->buffer;
+    ssd1306_clip_t clip_saved = dev->clip;
+    uint8_t dirty_start_saved[SSD1306_MAX_PAGES];
+    uint8_t dirty_end_saved[SSD1306_MAX_PAGES];
+    memcpy(dirty_start_saved, dev->dirty_start, sizeof(dirty_start_saved));
+    memcpy(dirty_end_saved, dev->dirty_end, sizeof(dirty_end_saved));
+
+    SSD1306_STAT_TIMESTAMP(started);
+    uint8_t passes = 0;
+    for (uint8_t page = 0; page < SSD1306_DEV_PAGES(dev); page += band_pages) {
+        uint8_t last_page = page + band_pages - 1;
+        if (last_page >= SSD1306_DEV_PAGES(dev)) last_page = SSD1306_DEV_PAGES(dev) - 1;
+        uint8_t pages = last_page - page + 1;
+
+        // buffer is the band, addressed from band_first_page on; the clip keeps every write inside it
+        memset(band, 0x00, pages * width);
+        dev->buffer = band;
+        dev->band_first_page = page;
+        dev->band_pages = pages;
+        dev->clip = clip_saved;
+        if (dev->clip.y0 < page * 8) dev->clip.y0 = page * 8;
+        if (dev->clip.y1 > last_page * 8 + 7) dev->clip.y1 = last_page * 8 + 7;
+
+        // Bands outside the caller's clip stay blank
+        if (draw && dev->clip.y0 <= dev->clip.y1) {
+            draw(dev, arg);
+            passes++;
+        }
+        ssd1306_flush_window(dev, band, page, last_page, 0, width - 1);
+        if (dev->shadow) memcpy(&dev->shadow[page * width], band, pages * width);
     }
+    SSD1306_STAT_FLUSH(started);
 
-    int dx01 = x1 - x0, dy01 = y1 - y0;
-    int dx02 = x2 - x0, dy02 = y2 - y0;
-    int dx12 = x2 - x1, dy12 = y2 - y1;
+    dev->buffer = buffer_saved;
+    dev->clip = clip_saved;
+    dev->band_first_page = 0;
+    dev->band_pages = 0;
+    memcpy(dev->dirty_start, dirty_start_saved, sizeof(dirty_start_saved));
+    memcpy(dev->dirty_end, dirty_end_saved, sizeof(dirty_end_saved));
 
-    int sa = 0, sb = 0;
-    int y;
+    if (stats) {
+        stats->ram_bytes = band_pages * width + sizeof(clip_saved) + sizeof(dirty_start_saved) + sizeof(dirty_end_saved);
+        stats->band_pages = band_pages;
+        stats->passes = passes;
+    }
+    return ESP_OK;
+}
 
-    int last = (y1 == y2) ? y1 : y1 - 1;
+void ssd1306_dev_clear(ssd1306_t* dev)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_CLEAR);
 
-    for (y = y0; y <= last; y++) {
-        int a = x0 + sa / (dy01 == 0 ? 1 : dy01);
-        int b = x0 + sb / (dy02 == 0 ? 1 : dy02);
-        sa += dx01;
-        sb += dx02;
-        ssd1306_draw_horizontal_line(a, b, y, color);
+    // Inside ssd1306_render_paged() buffer only holds the band being drawn
+    if (dev->band_pages) {
+        memset(dev->buffer, 0x00, dev->band_pages * SSD1306_DEV_WIDTH(dev));
+        return;
     }
+    if (!dev->buffer) return;
 
-    sa = dx12 * (y - y1);
-    sb = dx02 * (y - y0);
+    // Only lit columns need to reach the display, so clearing a blank page costs nothing
+    for (uint8_t page = 0; page < SSD1306_DEV_PAGES(dev); page++) {
+        uint8_t* row = &dev->buffer[page * SSD1306_DEV_WIDTH(dev)];
+        int x_start = 0;
+        int x_end = SSD1306_DEV_WIDTH(dev) - 1;
 
-    for (; y <= y2; y++) {
-        int a = x1 + sa / (dy12 == 0 ? 1 : dy12);
-        int b = x0 + sb / (dy02 == 0 ? 1 : dy02);
-        sa += dx12;
-        sb += dx02;
-        ssd1306_draw_horizontal_line(a, b, y, color);
+        while (x_start < SSD1306_DEV_WIDTH(dev) && !row[x_start]) x_start++;
+        if (x_start == SSD1306_DEV_WIDTH(dev)) continue;
+        while (!row[x_end]) x_end--;
+
+        ssd1306_mark_dirty_page(dev, page, x_start, x_end);
     }
+
+    memset(dev->buffer, 0x00, dev->buffer_size); // clears buffer
 }
 
-void ssd1306_overwrite_char(uint8_t x, uint8_t y, char old, char new, uint8_t old_size_x, uint8_t old_size_y, uint8_t new_size_x, uint8_t new_size_y)
+void ssd1306_dev_data(ssd1306_t* dev, uint8_t* data, size_t len)
 {
-	ssd1306_draw_char(x, y, old, old_size_x, old_size_y, COLOR_BLACK);
-	ssd1306_draw_char(x, y, new, new_size_x, new_size_y, COLOR_WHITE);
+    ssd1306_write_reg(dev, SSD1306_DATA, data, len);
 }
 
-void ssd1306_overwrite_string_char_by_char(uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms)
+static esp_err_t ssd1306_clip_push(ssd1306_t* dev, int x, int y, int w, int h, bool viewport)
 {
-    while (*old_str || *new_str) {
-		if (*old_str && *new_str) {
-			ssd1306_overwrite_char(x, y, *old_str++, *new_str++, size_x, size_y, size_x, size_y);
-		} else if (!(*old_str) && *new_str) {
-			ssd1306_draw_char(x, y, *new_str++, size_x, size_y, COLOR_WHITE);
-		} else if (*old_str && !(*new_str)) {
-			ssd1306_draw_char(x, y, *old_str++, size_x, size_y, COLOR_BLACK);
-		}
-		x += (6 * size_x); // 5 pixels + 1 space, scaled
-		ssd1306_display();
-		vTaskDelay(tick_delay_ms / portTICK_PERIOD_MS);
+    ssd1306_clip_t* clip = &dev->clip;
+    if (dev->clip_depth == SSD1306_CLIP_DEPTH) return ESP_ERR_NO_MEM;
+    dev->clip_stack[dev->clip_depth++] = *clip;
+
+    int x0 = x + clip->origin_x;
+    int y0 = y + clip->origin_y;
+    int x1 = x0 + w - 1;
+    int y1 = y0 + h - 1;
+    if (x0 < clip->x0) x0 = clip->x0;
+    if (y0 < clip->y0) y0 = clip->y0;
+    if (x1 > clip->x1) x1 = clip->x1;
+    if (y1 > clip->y1) y1 = clip->y1;
+
+    if (viewport) {
+        clip->origin_x += x;
+        clip->origin_y += y;
     }
+    if (x0 > x1 || y0 > y1) {
+        x0 = y0 = 0;
+        x1 = y1 = -1;
+    }
+    clip->x0 = x0;
+    clip->y0 = y0;
+    clip->x1 = x1;
+    clip->y1 = y1;
+    return ESP_OK;
 }
 
-void ssd1306_overwrite_string_wrapped_char_by_char(uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms)
+esp_err_t ssd1306_dev_push_clip(ssd1306_t* dev, int x, int y, int w, int h)
 {
-    uint8_t start_x = x;
-    while (*old_str || *new_str) {
-        // Wrap to next line if needed
-        if (x + (6 * size_x) > SCREEN_WIDTH) {
-            x = start_x;
-            y += (8 * size_y);
-            if (y >= SCREEN_HEIGHT) break;
-        }
+    return ssd1306_clip_push(dev, x, y, w, h, false);
+}
 
-        if (*old_str && *new_str) {
-            ssd1306_overwrite_char(x, y, *old_str++, *new_str++, size_x, size_y, size_x, size_y);
-        } else if (!(*old_str) && *new_str) {
-            ssd1306_draw_char(x, y, *new_str++, size_x, size_y, COLOR_WHITE);
-        } else if (*old_str && !(*new_str)) {
-            ssd1306_draw_char(x, y, *old_str++, size_x, size_y, COLOR_BLACK);
-        }
+esp_err_t ssd1306_dev_push_viewport(ssd1306_t* dev, int x, int y, int w, int h)
+{
+    return ssd1306_clip_push(dev, x, y, w, h, true);
+}
 
-        x += (6 * size_x);
-        ssd1306_display();
-        vTaskDelay(tick_delay_ms / portTICK_PERIOD_MS);
-    }
+esp_err_t ssd1306_dev_pop_clip(ssd1306_t* dev)
+{
+    if (!dev->clip_depth) return ESP_ERR_INVALID_STATE;
+    dev->clip = dev->clip_stack[--dev->clip_depth];
+    return ESP_OK;
+}
+
+void ssd1306_dev_reset_clip(ssd1306_t* dev)
+{
+    if (dev->clip_depth) dev->clip = dev->clip_stack[0];
+    dev->clip_depth = 0;
+}
+
+// True if nothing of the screen area [x_start, x_end] × [y_start, y_end] is inside the clip
+static inline bool ssd1306_clip_rejects(const ssd1306_clip_t* clip, int x_start, int y_start, int x_end, int y_end)
+{
+    return (x_start > clip->x0 ? x_start : clip->x0) > (x_end < clip->x1 ? x_end : clip->x1)
+        || (y_start > clip->y0 ? y_start : clip->y0) > (y_end < clip->y1 ? y_end : clip->y1);
+}
+
+// Rows of a page inside the clip, as a bit mask (0 if none)
+static inline uint8_t ssd1306_clip_page_mask(const ssd1306_clip_t* clip, int page)
+{
+    int top = clip->y0 - 8 * page;
+    int bottom = clip->y1 - 8 * page;
+    if (top < 0) top = 0;
+    if (bottom > 7) bottom = 7;
+    if (top > bottom) return 0;
+    return (uint8_t)(0xFF << top) & (0xFF >> (7 - bottom));
+}
+
+// Combines the shape bits src with a framebuffer byte. box holds the bits of the shape's cell,
+// which SSD1306_DRAW_INVERT lights where src is clear; for solid shapes it equals src.
+static inline uint8_t ssd1306_rop(uint8_t dst, uint8_t src, uint8_t box, ssd1306_draw_mode_t color)
+{
+    switch (color) {
+    case SSD1306_DRAW_CLEAR:
+        return dst & ~src;
+    case SSD1306_DRAW_XOR:
+        return dst ^ src;
+    case SSD1306_DRAW_INVERT:
+        return (dst & ~box) | (box & ~src);
+    default:
+        return dst | src;
+    }
+}
+
+// Writes a pixel at screen coordinates the caller has already clipped
+static inline void ssd1306_put_pixel(ssd1306_t* dev, int x, int y, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_ADD(pixels, 1);
+
+    uint8_t* byte = &SSD1306_DEV_ROW(dev, y / 8)[x];
+    uint8_t bit = 1 << (y % 8);
+    uint8_t old = *byte;
+    *byte = ssd1306_rop(old, bit, bit, color);
+
+    if (*byte != old) ssd1306_mark_dirty_page(dev, y / 8, x, x);
+}
+
+// Writes a pixel at drawing coordinates, if it is inside the clip
+static inline void ssd1306_set_pixel(ssd1306_t* dev, int x, int y, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    x += clip->origin_x;
+    y += clip->origin_y;
+    if (x < clip->x0 || y < clip->y0 || x > clip->x1 || y > clip->y1) return;
+    ssd1306_put_pixel(dev, x, y, color);
+}
+
+void ssd1306_dev_draw_pixel(ssd1306_t* dev, uint8_t x, uint8_t y, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_PIXEL);
+    ssd1306_set_pixel(dev, x, y, color);
+}
+
+// Sets, clears or toggles the bits selected by mask in columns [x_start, x_end] of a page.
+// Bytes that already hold the right bits are skipped so the dirty span stays tight.
+static void ssd1306_fill_page_span(ssd1306_t* dev, uint8_t page, uint8_t x_start, uint8_t x_end, uint8_t mask, ssd1306_draw_mode_t color)
+{
+    uint8_t* row = SSD1306_DEV_ROW(dev, page);
+
+    if (color == SSD1306_DRAW_XOR) {
+        for (int x = x_start; x <= x_end; x++) {
+            row[x] ^= mask;
+        }
+        ssd1306_mark_dirty_page(dev, page, x_start, x_end);
+        return;
+    }
+
+    // A solid shape has no background, so its inverse video is all clear
+    uint8_t set = (color == SSD1306_DRAW_CLEAR || color == SSD1306_DRAW_INVERT) ? 0x00 : mask;
+    int first = x_start;
+    int last = x_end;
+
+    while (first <= last && (row[first] & mask) == set) first++;
+    if (first > last) return;
+    while ((row[last] & mask) == set) last--;
+
+    if (mask == 0xFF) {
+        memset(&row[first], set, last - first + 1);
+    } else {
+        for (int x = first; x <= last; x++) {
+            row[x] = (row[x] & ~mask) | set;
+        }
+    }
+
+    ssd1306_mark_dirty_page(dev, page, first, last);
+}
+
+// Fills the inclusive area [x_start, x_end] × [y_start, y_end] of drawing coordinates, clipped.
+// Whole pages are memset, the partial top and bottom pages use precomputed masks.
+static void ssd1306_fill_area(ssd1306_t* dev, int x_start, int y_start, int x_end, int y_end, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+
+    x_start += clip->origin_x;
+    x_end += clip->origin_x;
+    y_start += clip->origin_y;
+    y_end += clip->origin_y;
+    if (x_start < clip->x0) x_start = clip->x0;
+    if (y_start < clip->y0) y_start = clip->y0;
+    if (x_end > clip->x1) x_end = clip->x1;
+    if (y_end > clip->y1) y_end = clip->y1;
+    if (x_start > x_end || y_start > y_end) return;
+    SSD1306_STAT_ADD(pixels, (x_end - x_start + 1) * (y_end - y_start + 1));
+
+    uint8_t first_page = y_start / 8;
+    uint8_t last_page = y_end / 8;
+    uint8_t top_mask = 0xFF << (y_start % 8);
+    uint8_t bottom_mask = 0xFF >> (7 - y_end % 8);
+
+    if (first_page == last_page) {
+        ssd1306_fill_page_span(dev, first_page, x_start, x_end, top_mask & bottom_mask, color);
+        return;
+    }
+
+    ssd1306_fill_page_span(dev, first_page, x_start, x_end, top_mask, color);
+    for (uint8_t page = first_page + 1; page < last_page; page++) {
+        ssd1306_fill_page_span(dev, page, x_start, x_end, 0xFF, color);
+    }
+    ssd1306_fill_page_span(dev, last_page, x_start, x_end, bottom_mask, color);
+}
+
+// Vertical glyph scaling: every nibble of a font column expands to 4 × size_y bits (size_y = 2, 3, 4)
+static const uint16_t glyph_expand[3][16] = {
+    { 0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F,
+      0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF },
+    { 0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF,
+      0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF },
+    { 0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF,
+      0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF }
+};
+
+// Stretches an 8-row font column to 8 × size_y rows (size_y <= 7 so the result plus a page shift fits 64 bits)
+static uint64_t ssd1306_expand_column(uint8_t line, uint8_t size_y)
+{
+    if (size_y == 1) return line;
+    if (size_y <= 4) {
+        const uint16_t* table = glyph_expand[size_y - 2];
+        return table[line & 0x0F] | (uint64_t)table[line >> 4] << (4 * size_y);
+    }
+
+    uint64_t bits = 0;
+    uint64_t block = (1ULL << size_y) - 1;
+    for (uint8_t j = 0; j < 8; j++, line >>= 1) {
+        if (line & 0x01) bits |= block << (j * size_y);
+    }
+    return bits;
+}
+
+// Fallback for very tall glyphs: every font bit becomes a size_x × size_y block
+static void ssd1306_draw_char_blocks(ssd1306_t* dev, uint8_t x, uint8_t y, uint16_t index, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    bool invert = color == SSD1306_DRAW_INVERT;
+    if (invert) {
+        // Light the cell, then clear the glyph out of it
+        ssd1306_fill_area(dev, x, y, x + 6 * size_x - 1, y + 8 * size_y - 1, COLOR_WHITE);
+        color = COLOR_BLACK;
+    }
+
+    for (uint8_t i = 0; i < 5; i++) {
+        uint8_t line = font5x7[index + i];
+        for (uint8_t j = 0; j < 8; j++, line >>= 1) {
+            if (line & 0x01) {
+                int bx = x + i * size_x;
+                int by = y + j * size_y;
+                ssd1306_fill_area(dev, bx, by, bx + size_x - 1, by + size_y - 1, color);
+            }
+        }
+    }
+
+    // Add spacing column (blank), left alone when toggling
+    if (!invert && color != SSD1306_DRAW_XOR) {
+        ssd1306_fill_area(dev, x + 5 * size_x, y, x + 6 * size_x - 1, y + 8 * size_y - 1, COLOR_BLACK);
+    }
+}
+
+static inline bool ssd1306_char_supported(char c)
+{
+    return c >= 32 && c <= 126;
+}
+
+// Draws a 5x7 character; the bits of the glyph erase (0 for none) are cleared from the cell in the
+// same pass, which ssd1306_overwrite_char() uses when both glyphs have the same size (size_y <= 7)
+static void ssd1306_draw_glyph(ssd1306_t* dev, uint8_t x, uint8_t y, char c, char erase, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+
+    if (!ssd1306_char_supported(c)) return; // unsupported char
+    if (!size_x || !size_y) return;
+
+    // Screen area of the glyph cell, clipped
+    int sx = x + clip->origin_x;
+    int sy = y + clip->origin_y;
+    int x_start = sx > clip->x0 ? sx : clip->x0;
+    int y_start = sy > clip->y0 ? sy : clip->y0;
+    int x_end = sx + 6 * size_x - 1;
+    int y_end = sy + 8 * size_y - 1;
+    if (x_end > clip->x1) x_end = clip->x1;
+    if (y_end > clip->y1) y_end = clip->y1;
+    if (x_start > x_end || y_start > y_end) return;
+
+    uint16_t index = (c - 32) * 5;
+
+    if (size_y > 7) {
+        ssd1306_draw_char_blocks(dev, x, y, index, size_x, size_y, color);
+        return;
+    }
+
+    // Expanded columns, already shifted to their position inside the glyph's first page
+    int top_page = sy >= 0 ? sy / 8 : (sy - 7) / 8;
+    uint8_t shift = sy - 8 * top_page;
+    uint64_t columns[5];
+    uint64_t erased[5] = { 0 };
+    for (uint8_t i = 0; i < 5; i++) {
+        columns[i] = ssd1306_expand_column(font5x7[index + i], size_y) << shift;
+        if (erase) erased[i] = ssd1306_expand_column(font5x7[(erase - 32) * 5 + i], size_y) << shift;
+    }
+    uint64_t footprint = ((1ULL << (8 * size_y)) - 1) << shift;
+    SSD1306_STAT_ADD(pixels, (x_end - x_start + 1) * (y_end - y_start + 1));
+
+    for (int page = y_start / 8; page <= y_end / 8; page++) {
+        uint8_t* row = SSD1306_DEV_ROW(dev, page);
+        uint8_t mask = ssd1306_clip_page_mask(clip, page);
+        int k = 8 * (page - top_page);
+        uint8_t box = (uint8_t)(footprint >> k) & mask;
+        int first = SSD1306_DEV_WIDTH(dev);
+        int last = -1;
+
+        // Start at the first visible column: glyph column i, its dx-th copy
+        int i = (x_start - sx) / size_x;
+        int dx = (x_start - sx) % size_x;
+        for (int cx = x_start; cx <= x_end; i++, dx = 0) {
+            // The spacing column is blank: cleared when setting or clearing, lit in inverse video
+            ssd1306_draw_mode_t op = color;
+            uint8_t bits = 0;
+            uint8_t erase_bits = 0;
+            if (i < 5) {
+                bits = (uint8_t)(columns[i] >> k) & mask;
+                erase_bits = (uint8_t)(erased[i] >> k) & mask;
+            } else if (color != SSD1306_DRAW_XOR && color != SSD1306_DRAW_INVERT) {
+                bits = box;
+                op = SSD1306_DRAW_CLEAR;
+            }
+
+            for (; dx < size_x && cx <= x_end; dx++, cx++) {
+                uint8_t old = row[cx];
+                row[cx] = ssd1306_rop(old & ~erase_bits, bits, box, op);
+                if (row[cx] != old) {
+                    if (first > cx) first = cx;
+                    last = cx;
+                }
+            }
+        }
+
+        if (last >= 0) ssd1306_mark_dirty_page(dev, page, first, last);
+    }
+}
+
+void ssd1306_dev_draw_char(ssd1306_t* dev, uint8_t x, uint8_t y, char c, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_CHAR);
+    ssd1306_draw_glyph(dev, x, y, c, 0, size_x, size_y, color);
+}
+
+void ssd1306_dev_draw_string(ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    while (*str) {
+        ssd1306_dev_draw_char(dev, x, y, *str++, size_x, size_y, color);
+        x += (6 * size_x); // 5 pixels + 1 space, scaled
+    }
+}
+
+void ssd1306_dev_draw_string_wrapped(ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    uint8_t start_x = x;
+    while (*str) {
+        if (x + (6 * size_x) >= SSD1306_DEV_WIDTH(dev)) {
+            x = start_x;
+            y += (8 * size_y); // next line
+            if (y >= SSD1306_DEV_HEIGHT(dev)) break; // stop if bottom reached
+        }
+        ssd1306_dev_draw_char(dev, x, y, *str++, size_x, size_y, color);
+        x += (6 * size_x);
+    }
+}
+
+void ssd1306_dev_draw_string_char_by_char(ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color)
+{
+    ssd1306_anim_t anim;
+    ssd1306_anim_type_init(&anim, dev, x, y, str, size_x, size_y, tick_delay_ms, color);
+    ssd1306_anim_start(&anim);
+    ssd1306_anim_wait(&anim);
+}
+
+void ssd1306_dev_draw_string_wrapped_char_by_char(ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color)
+{
+    ssd1306_anim_t anim;
+    ssd1306_anim_type_init(&anim, dev, x, y, str, size_x, size_y, tick_delay_ms, color);
+    ssd1306_anim_set_wrap(&anim, true);
+    ssd1306_anim_start(&anim);
+    ssd1306_anim_wait(&anim);
+}
+
+uint8_t ssd1306_get_string_width(const char* str, uint8_t size_x)
+{
+    return strlen(str) * 6 * size_x;
+}
+
+void ssd1306_dev_draw_string_centered(ssd1306_t* dev, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    uint8_t str_w = ssd1306_get_string_width(str, size_x);
+    uint8_t x = (SSD1306_DEV_WIDTH(dev) - str_w) / 2;
+    ssd1306_dev_draw_string(dev, x, y, str, size_x, size_y, color);
+}
+
+void ssd1306_dev_draw_string_centered_char_by_char(ssd1306_t* dev, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color)
+{
+    uint8_t str_w = ssd1306_get_string_width(str, size_x);
+    uint8_t x = (SSD1306_DEV_WIDTH(dev) - str_w) / 2;
+    ssd1306_dev_draw_string_char_by_char(dev, x, y, str, size_x, size_y, tick_delay_ms, color);
+}
+
+// Destination of one page row of a bitmap: unless the bitmap is byte aligned, each source byte
+// is split across two framebuffer pages
+typedef struct {
+    ssd1306_t* dev;
+    uint8_t* upper;         // page receiving the low bits, NULL if clipped
+    uint8_t* lower;         // next page receiving the high bits, NULL if aligned or clipped
+    int page;               // index of upper
+    uint8_t shift;          // row of the source byte's bit 0 inside upper
+    uint8_t mask;           // source bits inside the bitmap height
+    uint8_t clip[2];        // rows of upper and lower inside the clip
+    ssd1306_draw_mode_t color;
+    int first[2];           // changed columns in upper and lower
+    int last[2];
+} ssd1306_blit_row_t;
+
+// y is a screen coordinate
+static void ssd1306_blit_row_begin(ssd1306_t* dev, ssd1306_blit_row_t* row, int y, uint8_t h, uint8_t src_page, ssd1306_draw_mode_t color)
+{
+    int top = y + 8 * src_page;
+    int page = top >= 0 ? top / 8 : (top - 7) / 8;
+    int rows_left = h - 8 * src_page;
+
+    row->dev = dev;
+    row->page = page;
+    row->shift = top - 8 * page;
+    row->mask = rows_left >= 8 ? 0xFF : (1 << rows_left) - 1;
+    row->color = color;
+    row->clip[0] = ssd1306_clip_page_mask(&dev->clip, page);
+    row->clip[1] = row->shift ? ssd1306_clip_page_mask(&dev->clip, page + 1) : 0;
+    row->upper = row->clip[0] ? SSD1306_DEV_ROW(dev, page) : NULL;
+    row->lower = row->clip[1] ? SSD1306_DEV_ROW(dev, page + 1) : NULL;
+    row->first[0] = row->first[1] = SSD1306_DEV_WIDTH(dev);
+    row->last[0] = row->last[1] = -1;
+}
+
+static inline void ssd1306_blit_apply(ssd1306_blit_row_t* row, uint8_t half, uint8_t* dst, int cx, uint8_t bits, uint8_t box)
+{
+    uint8_t old = dst[cx];
+    dst[cx] = ssd1306_rop(old, bits & row->clip[half], box & row->clip[half], row->color);
+    if (dst[cx] != old) {
+        if (row->first[half] > cx) row->first[half] = cx;
+        row->last[half] = cx;
+    }
+}
+
+// Draws the set bits of one source byte at screen column cx, which the caller has clipped
+static inline void ssd1306_blit_put(ssd1306_blit_row_t* row, int cx, uint8_t bits)
+{
+    bits &= row->mask;
+    if (!bits && row->color != SSD1306_DRAW_INVERT) return;
+
+    // Byte-aligned rows map one to one onto a framebuffer page
+    if (!row->shift) {
+        if (row->upper) ssd1306_blit_apply(row, 0, row->upper, cx, bits, row->mask);
+        return;
+    }
+
+    uint16_t shifted = bits << row->shift;
+    uint16_t box = row->mask << row->shift;
+    if (row->upper && (uint8_t)box) ssd1306_blit_apply(row, 0, row->upper, cx, shifted, box);
+    if (row->lower && box >> 8) ssd1306_blit_apply(row, 1, row->lower, cx, shifted >> 8, box >> 8);
+}
+
+static void ssd1306_blit_row_end(ssd1306_blit_row_t* row)
+{
+    if (row->last[0] >= 0) ssd1306_mark_dirty_page(row->dev, row->page, row->first[0], row->last[0]);
+    if (row->last[1] >= 0) ssd1306_mark_dirty_page(row->dev, row->page + 1, row->first[1], row->last[1]);
+}
+
+// Moves a bitmap to screen coordinates and clips its columns; false if nothing of it is visible
+static bool ssd1306_blit_clip(ssd1306_t* dev, int* x, int* y, uint8_t w, uint8_t h, int* x_start, int* x_end)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+
+    *x += clip->origin_x;
+    *y += clip->origin_y;
+    int y_start = *y > clip->y0 ? *y : clip->y0;
+    int y_end = *y + h - 1 < clip->y1 ? *y + h - 1 : clip->y1;
+    *x_start = *x > clip->x0 ? *x : clip->x0;
+    *x_end = *x + w - 1 < clip->x1 ? *x + w - 1 : clip->x1;
+    if (!w || !h || *x_start > *x_end || y_start > y_end) return false;
+
+    SSD1306_STAT_ADD(pixels, (*x_end - *x_start + 1) * (y_end - y_start + 1));
+    return true;
+}
+
+static void ssd1306_blit(ssd1306_t* dev, int x, int y, const uint8_t* bitmap, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    int x_start, x_end;
+    if (!ssd1306_blit_clip(dev, &x, &y, w, h, &x_start, &x_end)) return;
+
+    for (uint8_t src_page = 0; src_page < (h + 7) / 8; src_page++) {
+        ssd1306_blit_row_t row;
+        ssd1306_blit_row_begin(dev, &row, y, h, src_page, color);
+        if (!row.upper && !row.lower) continue;
+
+        const uint8_t* src = &bitmap[src_page * w + (x_start - x)];    // first visible column
+        for (int cx = x_start; cx <= x_end; cx++) {
+            ssd1306_blit_put(&row, cx, *src++);
+        }
+        ssd1306_blit_row_end(&row);
+    }
+}
+
+void ssd1306_dev_draw_bitmap(ssd1306_t* dev, int x, int y, const uint8_t* bitmap, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_BITMAP);
+    ssd1306_blit(dev, x, y, bitmap, w, h, color);
+}
+
+void ssd1306_dev_draw_bitmap_rle(ssd1306_t* dev, int x, int y, const uint8_t* data, size_t len, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_BITMAP);
+
+    int x_start, x_end;
+    if (!ssd1306_blit_clip(dev, &x, &y, w, h, &x_start, &x_end)) return;
+
+    const uint8_t* end = data + len;
+    uint8_t src_pages = (h + 7) / 8;
+    uint8_t src_page = 0;
+    int column = 0;
+    ssd1306_blit_row_t row;
+
+    ssd1306_blit_row_begin(dev, &row, y, h, src_page, color);
+
+    // PackBits: n < 128 is followed by n + 1 literal bytes, n > 128 by one byte repeated 257 - n times
+    while (data < end && src_page < src_pages) {
+        uint8_t header = *data++;
+        bool literal = header < 128;
+        size_t count = literal ? header + 1u : 257u - header;
+        uint8_t value = 0;
+
+        if (header == 128) continue;
+        if (literal) {
+            if (count > (size_t)(end - data)) count = end - data;
+        } else {
+            if (data >= end) break;
+            value = *data++;
+        }
+
+        while (count-- && src_page < src_pages) {
+            uint8_t bits = literal ? *data++ : value;
+            int cx = x + column;
+            if (cx >= x_start && cx <= x_end) ssd1306_blit_put(&row, cx, bits);
+
+            if (++column == w) {
+                ssd1306_blit_row_end(&row);
+                column = 0;
+                if (++src_page < src_pages) ssd1306_blit_row_begin(dev, &row, y, h, src_page, color);
+            }
+        }
+    }
+
+    // A truncated stream still shows what it decoded
+    if (column) ssd1306_blit_row_end(&row);
+}
+
+static inline const ssd1306_glyph_t* ssd1306_font_glyph(const ssd1306_font_t* font, char c)
+{
+    uint8_t code = c;
+    if (code < font->first || code > font->last) return NULL;
+    return &font->glyphs[code - font->first];
+}
+
+uint8_t ssd1306_font_char_width(const ssd1306_font_t* font, char c)
+{
+    const ssd1306_glyph_t* glyph = ssd1306_font_glyph(font, c);
+    return glyph ? glyph->advance : 0;
+}
+
+uint16_t ssd1306_font_string_width(const ssd1306_font_t* font, const char* str)
+{
+    uint16_t width = 0;
+    while (*str) {
+        width += ssd1306_font_char_width(font, *str++);
+    }
+    return width;
+}
+
+int ssd1306_dev_draw_char_font(ssd1306_t* dev, int x, int y, const ssd1306_font_t* font, char c, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_CHAR);
+
+    const ssd1306_glyph_t* glyph = ssd1306_font_glyph(font, c);
+    if (!glyph) return 0;
+
+    // Inverse video covers the whole cell, not just the glyph's bitmap
+    if (color == SSD1306_DRAW_INVERT) {
+        if (glyph->advance) ssd1306_fill_area(dev, x, y, x + glyph->advance - 1, y + font->height - 1, COLOR_WHITE);
+        color = COLOR_BLACK;
+    }
+
+    // Glyph bitmaps are stored in page layout, so a glyph is a bitmap blit
+    if (glyph->width) {
+        ssd1306_blit(dev, x + glyph->x_offset, y + glyph->y_offset, &font->bitmaps[glyph->offset], glyph->width, glyph->height, color);
+    }
+    return glyph->advance;
+}
+
+int ssd1306_dev_draw_string_font(ssd1306_t* dev, int x, int y, const ssd1306_font_t* font, const char* str, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    while (*str && x + clip->origin_x <= clip->x1) {
+        x += ssd1306_dev_draw_char_font(dev, x, y, font, *str++, color);
+    }
+    return x;
+}
+
+void ssd1306_dev_draw_string_font_centered(ssd1306_t* dev, int y, const ssd1306_font_t* font, const char* str, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    int x = (clip->x0 + clip->x1 + 1 - ssd1306_font_string_width(font, str)) / 2 - clip->origin_x;
+    ssd1306_dev_draw_string_font(dev, x, y, font, str, color);
+}
+
+void ssd1306_dev_draw_full_rect(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_RECT);
+    if (!w || !h) return;
+    ssd1306_fill_area(dev, x, y, x + w - 1, y + h - 1, color);
+}
+
+void ssd1306_dev_draw_empty_rect(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_RECT);
+    if (!w || !h) return;
+
+    // The sides leave out the corners so that each pixel is drawn once, as toggling needs
+    ssd1306_fill_area(dev, x, y, x + w - 1, y, color);                                       // Top
+    if (h > 1) ssd1306_fill_area(dev, x, y + h - 1, x + w - 1, y + h - 1, color);            // Bottom
+    if (h > 2) {
+        ssd1306_fill_area(dev, x, y + 1, x, y + h - 2, color);                               // Left
+        if (w > 1) ssd1306_fill_area(dev, x + w - 1, y + 1, x + w - 1, y + h - 2, color);    // Right
+    }
+}
+
+void ssd1306_dev_clear_region(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    ssd1306_dev_draw_full_rect(dev, x, y, w, h, COLOR_BLACK);
+}
+
+void ssd1306_dev_invert_region(ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    ssd1306_dev_draw_full_rect(dev, x, y, w, h, SSD1306_DRAW_XOR);
+}
+
+// Scanline rasterizer: filled shapes are emitted as horizontal spans, row by row from the top. The
+// spans of a page are collected as XOR deltas, the row's bit toggled at the first column and one
+// past the last, so a running XOR over the columns yields each column's byte mask and every byte is
+// written once, with one raster op. Spans of a row must not overlap, which makes every pixel drawn
+// exactly once.
+typedef struct {
+    ssd1306_t* dev;
+    ssd1306_draw_mode_t color;
+    int page;                                   // page being collected, -1 if none
+    int x_min;                                  // columns holding deltas
+    int x_max;
+    uint8_t delta[SSD1306_MAX_WIDTH + 1];
+} ssd1306_raster_t;
+
+#define SSD1306_RASTER_FAR  0x3FFF  // beyond any column a shape on the panel can reach
+
+static void ssd1306_raster_begin(ssd1306_t* dev, ssd1306_raster_t* raster, ssd1306_draw_mode_t color)
+{
+    raster->dev = dev;
+    raster->color = color;
+    raster->page = -1;
+    memset(raster->delta, 0, sizeof(raster->delta));
+}
+
+// Writes the collected page into the framebuffer
+static void ssd1306_raster_flush(ssd1306_raster_t* raster)
+{
+    if (raster->page < 0) return;
+
+    ssd1306_t* dev = raster->dev;
+    uint8_t* row = SSD1306_DEV_ROW(dev, raster->page);
+    uint8_t mask = 0;
+    int first = -1;
+    int last = -1;
+
+    for (int x = raster->x_min; x <= raster->x_max; x++) {
+        mask ^= raster->delta[x];
+        raster->delta[x] = 0;
+        if (!mask) continue;
+
+        uint8_t old = row[x];
+        row[x] = ssd1306_rop(old, mask, mask, raster->color);
+        if (row[x] != old) {
+            if (first < 0) first = x;
+            last = x;
+        }
+    }
+    raster->delta[raster->x_max + 1] = 0;
+
+    if (first >= 0) ssd1306_mark_dirty_page(dev, raster->page, first, last);
+    raster->page = -1;
+}
+
+// Adds the span [x_start, x_end] of screen row y, clipped
+static void ssd1306_raster_span(ssd1306_raster_t* raster, int y, int x_start, int x_end)
+{
+    const ssd1306_clip_t* clip = &raster->dev->clip;
+    if (y < clip->y0 || y > clip->y1) return;
+    if (x_start < clip->x0) x_start = clip->x0;
+    if (x_end > clip->x1) x_end = clip->x1;
+    if (x_start > x_end) return;
+    SSD1306_STAT_ADD(pixels, x_end - x_start + 1);
+
+    if (y / 8 != raster->page) {
+        ssd1306_raster_flush(raster);
+        raster->page = y / 8;
+        raster->x_min = x_start;
+        raster->x_max = x_end;
+    } else {
+        if (x_start < raster->x_min) raster->x_min = x_start;
+        if (x_end > raster->x_max) raster->x_max = x_end;
+    }
+
+    uint8_t bit = 1 << (y % 8);
+    raster->delta[x_start] ^= bit;
+    raster->delta[x_end + 1] ^= bit;
+}
+
+static void ssd1306_raster_end(ssd1306_raster_t* raster)
+{
+    ssd1306_raster_flush(raster);
+}
+
+// Rows of [top, bottom] inside the clip, as [*y_first, *y_last]; false if there are none
+static bool ssd1306_raster_rows(ssd1306_t* dev, int top, int bottom, int* y_first, int* y_last)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    *y_first = top > clip->y0 ? top : clip->y0;
+    *y_last = bottom < clip->y1 ? bottom : clip->y1;
+    return *y_first <= *y_last;
+}
+
+// A shape given as one span per row, [left[i], right[i]] on row y_first + i
+static void ssd1306_raster_fill(ssd1306_raster_t* raster, int y_first, int count, const int16_t* left, const int16_t* right)
+{
+    for (int i = 0; i < count; i++) {
+        ssd1306_raster_span(raster, y_first + i, left[i], right[i]);
+    }
+}
+
+// The outline of such a shape: its pixels with a neighbour outside it. The spans are given for
+// one more row above and below (left > right where the shape has no pixels), so that entry i + 1
+// is row y_first + i.
+static void ssd1306_raster_outline(ssd1306_raster_t* raster, int y_first, int count, const int16_t* left, const int16_t* right)
+{
+    for (int i = 1; i <= count; i++) {
+        if (left[i] > right[i]) continue;
+
+        // Interior: all four neighbours are in the shape
+        int lo = left[i] + 1;
+        int hi = right[i] - 1;
+        if (left[i - 1] > lo) lo = left[i - 1];
+        if (left[i + 1] > lo) lo = left[i + 1];
+        if (right[i - 1] < hi) hi = right[i - 1];
+        if (right[i + 1] < hi) hi = right[i + 1];
+
+        int y = y_first + i - 1;
+        if (lo > hi) {
+            ssd1306_raster_span(raster, y, left[i], right[i]);
+        } else {
+            ssd1306_raster_span(raster, y, left[i], lo - 1);
+            ssd1306_raster_span(raster, y, hi + 1, right[i]);
+        }
+    }
+}
+
+// Floor division for a positive divisor
+static inline int ssd1306_div_floor(int a, int b)
+{
+    return a >= 0 ? a / b : -((b - 1 - a) / b);
+}
+
+static uint32_t ssd1306_isqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > value) bit >>= 2;
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static inline void ssd1306_circle_record(int16_t* widths, int d_first, int count, int d, int width)
+{
+    d -= d_first;
+    if (d >= 0 && d < count && widths[d] < width) widths[d] = width;
+}
+
+// Half-widths of a filled midpoint circle on the rows d_first .. d_first + count - 1 away from its
+// centre row, -1 past the radius. A row is as wide as the largest offset the midpoint algorithm
+// pairs with it, so the disc is exactly the area inside the outline ssd1306_draw_empty_circle() draws.
+static void ssd1306_circle_widths(int radius, int d_first, int count, int16_t* widths)
+{
+    int x = 0;
+    int y = radius;
+    int f = 1 - radius;
+    int ddF_x = 1;
+    int ddF_y = -2 * radius;
+
+    for (int i = 0; i < count; i++) widths[i] = -1;
+    ssd1306_circle_record(widths, d_first, count, 0, radius);
+    ssd1306_circle_record(widths, d_first, count, radius, 0);
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        ssd1306_circle_record(widths, d_first, count, y, x);
+        ssd1306_circle_record(widths, d_first, count, x, y);
+    }
+}
+
+// Smallest distance from row c of the rows [y_first, y_last] in *d_first; returns how many distances they cover
+static int ssd1306_row_distances(int c, int y_first, int y_last, int* d_first)
+{
+    int lo = y_first - c;
+    int hi = y_last - c;
+
+    if (lo > 0) {
+        *d_first = lo;
+        return hi - lo + 1;
+    }
+    if (hi < 0) {
+        *d_first = -hi;
+        return hi - lo + 1;
+    }
+    *d_first = 0;
+    return (-lo > hi ? -lo : hi) + 1;
+}
+
+// Spans of an ellipse centred on screen point (cx, cy) for the rows y_first .. y_first + count - 1.
+// Equal radii give the midpoint circle; otherwise a row is the closed-form chord of the ellipse
+// with semi-axes rx + 1/2 and ry + 1/2, which is what the midpoint circle approximates.
+static void ssd1306_ellipse_rows(int cx, int cy, int rx, int ry, int y_first, int count, int16_t* left, int16_t* right)
+{
+    int16_t widths[SSD1306_MAX_HEIGHT + 2];
+    int d_first = 0;
+
+    if (rx == ry) {
+        int distances = ssd1306_row_distances(cy, y_first, y_first + count - 1, &d_first);
+        ssd1306_circle_widths(rx, d_first, distances, widths);
+    }
+
+    uint32_t a = (2 * rx + 1) * (2 * rx + 1);
+    uint32_t b = (2 * ry + 1) * (2 * ry + 1);
+    for (int i = 0; i < count; i++) {
+        int d = abs(y_first + i - cy);
+        int w;
+        if (d > ry) {
+            w = -1;
+        } else if (rx == ry) {
+            w = widths[d - d_first];
+        } else {
+            w = ssd1306_isqrt((uint64_t)a * (b - 4 * d * d) / (4 * b));
+        }
+        left[i] = w < 0 ? SSD1306_RASTER_FAR : cx - w;
+        right[i] = w < 0 ? -SSD1306_RASTER_FAR : cx + w;
+    }
+}
+
+static void ssd1306_fill_ellipse(ssd1306_t* dev, int cx, int cy, int rx, int ry, ssd1306_draw_mode_t color)
+{
+    int16_t left[SSD1306_MAX_HEIGHT];
+    int16_t right[SSD1306_MAX_HEIGHT];
+    int y_first, y_last;
+
+    if (ssd1306_clip_rejects(&dev->clip, cx - rx, cy - ry, cx + rx, cy + ry)) return;
+    if (!ssd1306_raster_rows(dev, cy - ry, cy + ry, &y_first, &y_last)) return;
+
+    ssd1306_raster_t raster;
+    ssd1306_ellipse_rows(cx, cy, rx, ry, y_first, y_last - y_first + 1, left, right);
+    ssd1306_raster_begin(dev, &raster, color);
+    ssd1306_raster_fill(&raster, y_first, y_last - y_first + 1, left, right);
+    ssd1306_raster_end(&raster);
+}
+
+void ssd1306_dev_draw_full_circle(ssd1306_t* dev, uint8_t x0, uint8_t y0, uint8_t radius, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    SSD1306_STAT_CALL(SSD1306_PRIM_CIRCLE);
+    ssd1306_fill_ellipse(dev, x0 + clip->origin_x, y0 + clip->origin_y, radius, radius, color);
+}
+
+void ssd1306_dev_draw_full_ellipse(ssd1306_t* dev, int x0, int y0, uint8_t rx, uint8_t ry, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    SSD1306_STAT_CALL(SSD1306_PRIM_CIRCLE);
+    ssd1306_fill_ellipse(dev, x0 + clip->origin_x, y0 + clip->origin_y, rx, ry, color);
+}
+
+void ssd1306_dev_draw_empty_ellipse(ssd1306_t* dev, int x0, int y0, uint8_t rx, uint8_t ry, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    SSD1306_STAT_CALL(SSD1306_PRIM_CIRCLE);
+
+    int cx = x0 + clip->origin_x;
+    int cy = y0 + clip->origin_y;
+    int16_t left[SSD1306_MAX_HEIGHT + 2];
+    int16_t right[SSD1306_MAX_HEIGHT + 2];
+    int y_first, y_last;
+
+    if (ssd1306_clip_rejects(clip, cx - rx, cy - ry, cx + rx, cy + ry)) return;
+    if (!ssd1306_raster_rows(dev, cy - ry, cy + ry, &y_first, &y_last)) return;
+
+    ssd1306_raster_t raster;
+    ssd1306_ellipse_rows(cx, cy, rx, ry, y_first - 1, y_last - y_first + 3, left, right);
+    ssd1306_raster_begin(dev, &raster, color);
+    ssd1306_raster_outline(&raster, y_first, y_last - y_first + 1, left, right);
+    ssd1306_raster_end(&raster);
+}
+
+// sin(0..90 degrees), 1.0 = 16384
+static const uint16_t sine_q14[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
+
+// Direction of an angle in degrees, clockwise from 3 o'clock, as (c, s) in Q14 screen coordinates
+static void ssd1306_direction(int angle, int* c, int* s)
+{
+    angle %= 360;
+    if (angle < 0) angle += 360;
+
+    if (angle < 90) {
+        *c = sine_q14[90 - angle];
+        *s = sine_q14[angle];
+    } else if (angle < 180) {
+        *c = -sine_q14[angle - 90];
+        *s = sine_q14[180 - angle];
+    } else if (angle < 270) {
+        *c = -sine_q14[270 - angle];
+        *s = -sine_q14[angle - 180];
+    } else {
+        *c = sine_q14[angle - 270];
+        *s = -sine_q14[360 - angle];
+    }
+}
+
+// Offsets dx on row dy with s dx <= c dy, as [*lo, *hi]: a half-line, the whole row or nothing
+static void ssd1306_half_plane(int c, int s, int dy, int* lo, int* hi)
+{
+    int t = c * dy;
+    *lo = -SSD1306_RASTER_FAR;
+    *hi = SSD1306_RASTER_FAR;
+
+    if (s > 0) {
+        *hi = ssd1306_div_floor(t, s);
+    } else if (s < 0) {
+        *lo = -ssd1306_div_floor(t, -s);
+    } else if (t < 0) {
+        *lo = 1;
+        *hi = 0;
+    }
+}
+
+void ssd1306_dev_draw_arc(ssd1306_t* dev, int x0, int y0, uint8_t radius, uint8_t inner_radius, int16_t start_angle, int16_t end_angle, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    SSD1306_STAT_CALL(SSD1306_PRIM_CIRCLE);
+
+    int sweep = end_angle - start_angle;
+    if (!sweep) return;
+    bool full = sweep >= 360 || sweep <= -360;
+    sweep %= 360;
+    if (sweep <= 0) sweep += 360;
+
+    int cx = x0 + clip->origin_x;
+    int cy = y0 + clip->origin_y;
+    int y_first, y_last;
+    if (ssd1306_clip_rejects(clip, cx - radius, cy - radius, cx + radius, cy + radius)) return;
+    if (!ssd1306_raster_rows(dev, cy - radius, cy + radius, &y_first, &y_last)) return;
+
+    // The ring is the disc less the disc one pixel inside inner_radius
+    int16_t outer[SSD1306_MAX_HEIGHT];
+    int16_t inner[SSD1306_MAX_HEIGHT];
+    int d_first;
+    int count = ssd1306_row_distances(cy, y_first, y_last, &d_first);
+    ssd1306_circle_widths(radius, d_first, count, outer);
+    if (inner_radius)
+        ssd1306_circle_widths(inner_radius - 1, d_first, count, inner);
+    else
+        memset(inner, 0xFF, count * sizeof(inner[0]));
+
+    // Inside the sector: clockwise of the start ray and counterclockwise of the end ray, both if
+    // the sweep is up to half a turn, either if it is more
+    int c0, s0, c1, s1;
+    ssd1306_direction(start_angle, &c0, &s0);
+    ssd1306_direction(start_angle + sweep, &c1, &s1);
+
+    ssd1306_raster_t raster;
+    ssd1306_raster_begin(dev, &raster, color);
+
+    for (int y = y_first; y <= y_last; y++) {
+        int dy = y - cy;
+        int w = outer[abs(dy) - d_first];
+        int hole = inner[abs(dy) - d_first];
+        if (w < 0) continue;
+
+        int ring[2][2] = { { -w, w }, { hole + 1, w } };
+        int rings = 1;
+        if (hole >= 0) {
+            ring[0][1] = -hole - 1;
+            rings = hole < w ? 2 : 0;
+        }
+
+        int sector[2][2] = { { -SSD1306_RASTER_FAR, SSD1306_RASTER_FAR } };
+        int sectors = 1;
+        if (!full) {
+            int lo0, hi0, lo1, hi1;
+            ssd1306_half_plane(c0, s0, dy, &lo0, &hi0);
+            ssd1306_half_plane(-c1, -s1, dy, &lo1, &hi1);
+
+            if (sweep <= 180) {
+                sector[0][0] = lo0 > lo1 ? lo0 : lo1;
+                sector[0][1] = hi0 < hi1 ? hi0 : hi1;
+            } else {
+                // Union of two intervals, kept sorted and disjoint
+                if (lo1 < lo0) {
+                    int t = lo0; lo0 = lo1; lo1 = t;
+                    t = hi0; hi0 = hi1; hi1 = t;
+                }
+                sector[0][0] = lo0;
+                sector[0][1] = hi0;
+                if (lo0 > hi0) {
+                    sector[0][0] = lo1;
+                    sector[0][1] = hi1;
+                } else if (lo1 <= hi1) {
+                    if (lo1 <= hi0 + 1) {
+                        if (hi1 > hi0) sector[0][1] = hi1;
+                    } else {
+                        sector[1][0] = lo1;
+                        sector[1][1] = hi1;
+                        sectors = 2;
+                    }
+                }
+            }
+        }
+
+        for (int i = 0; i < rings; i++) {
+            for (int j = 0; j < sectors; j++) {
+                int lo = ring[i][0] > sector[j][0] ? ring[i][0] : sector[j][0];
+                int hi = ring[i][1] < sector[j][1] ? ring[i][1] : sector[j][1];
+                if (lo <= hi) ssd1306_raster_span(&raster, y, cx + lo, cx + hi);
+            }
+        }
+    }
+    ssd1306_raster_end(&raster);
+}
+
+// Spans of a rounded rectangle at screen position (x, y) for the rows y_first .. y_first + count - 1.
+// The corners are quarters of the midpoint circle, centred radius pixels inside the edges.
+static void ssd1306_round_rect_rows(int x, int y, int w, int h, int radius, int y_first, int count, int16_t* left, int16_t* right)
+{
+    int16_t widths[SSD1306_MAX_HEIGHT + 2];
+    int top = y + radius;
+    int bottom = y + h - 1 - radius;
+    int d_min = SSD1306_RASTER_FAR;
+    int d_max = 0;
+
+    for (int i = 0; i < count; i++) {
+        int row = y_first + i;
+        int d = row < top ? top - row : row - bottom;
+        if (row < y || row >= y + h || d <= 0) continue;
+        if (d < d_min) d_min = d;
+        if (d > d_max) d_max = d;
+    }
+    if (d_max) ssd1306_circle_widths(radius, d_min, d_max - d_min + 1, widths);
+
+    for (int i = 0; i < count; i++) {
+        int row = y_first + i;
+        int d = row < top ? top - row : row - bottom;
+        if (row < y || row >= y + h) {
+            left[i] = SSD1306_RASTER_FAR;
+            right[i] = -SSD1306_RASTER_FAR;
+            continue;
+        }
+
+        int inset = d > 0 ? radius - widths[d - d_min] : 0;
+        left[i] = x + inset;
+        right[i] = x + w - 1 - inset;
+    }
+}
+
+// Screen position of a rounded rectangle, its radius limited to what fits; false if it is not visible
+static bool ssd1306_round_rect_setup(ssd1306_t* dev, int* x, int* y, uint8_t w, uint8_t h, uint8_t* radius, int* y_first, int* y_last)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    if (!w || !h) return false;
+
+    uint8_t max_radius = ((w < h ? w : h) - 1) / 2;
+    if (*radius > max_radius) *radius = max_radius;
+
+    *x += clip->origin_x;
+    *y += clip->origin_y;
+    if (ssd1306_clip_rejects(clip, *x, *y, *x + w - 1, *y + h - 1)) return false;
+    return ssd1306_raster_rows(dev, *y, *y + h - 1, y_first, y_last);
+}
+
+void ssd1306_dev_draw_full_round_rect(ssd1306_t* dev, int x, int y, uint8_t w, uint8_t h, uint8_t radius, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_RECT);
+
+    int16_t left[SSD1306_MAX_HEIGHT];
+    int16_t right[SSD1306_MAX_HEIGHT];
+    int y_first, y_last;
+    if (!ssd1306_round_rect_setup(dev, &x, &y, w, h, &radius, &y_first, &y_last)) return;
+
+    ssd1306_raster_t raster;
+    ssd1306_round_rect_rows(x, y, w, h, radius, y_first, y_last - y_first + 1, left, right);
+    ssd1306_raster_begin(dev, &raster, color);
+    ssd1306_raster_fill(&raster, y_first, y_last - y_first + 1, left, right);
+    ssd1306_raster_end(&raster);
+}
+
+void ssd1306_dev_draw_empty_round_rect(ssd1306_t* dev, int x, int y, uint8_t w, uint8_t h, uint8_t radius, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_RECT);
+
+    int16_t left[SSD1306_MAX_HEIGHT + 2];
+    int16_t right[SSD1306_MAX_HEIGHT + 2];
+    int y_first, y_last;
+    if (!ssd1306_round_rect_setup(dev, &x, &y, w, h, &radius, &y_first, &y_last)) return;
+
+    ssd1306_raster_t raster;
+    ssd1306_round_rect_rows(x, y, w, h, radius, y_first - 1, y_last - y_first + 3, left, right);
+    ssd1306_raster_begin(dev, &raster, color);
+    ssd1306_raster_outline(&raster, y_first, y_last - y_first + 1, left, right);
+    ssd1306_raster_end(&raster);
+}
+
+// A polygon edge, top end first. x along the edge is x_top + k * half_slope at k half rows below
+// y_top, in 16.16 fixed point.
+typedef struct {
+    int16_t x_top;
+    int16_t y_top;
+    int16_t x_bottom;
+    int16_t y_bottom;
+    int32_t half_slope;
+} ssd1306_poly_edge_t;
+
+static inline int ssd1306_poly_edge_x(const ssd1306_poly_edge_t* edge, int k)
+{
+    return (int)(((int64_t)edge->x_top * 65536 + (int64_t)k * edge->half_slope + 0x8000) >> 16);
+}
+
+esp_err_t ssd1306_dev_draw_filled_polygon(ssd1306_t* dev, const ssd1306_point_t* points, uint8_t count, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    SSD1306_STAT_CALL(SSD1306_PRIM_POLYGON);
+    if (!points || count < 3 || count > SSD1306_POLYGON_MAX_POINTS) return ESP_ERR_INVALID_ARG;
+
+    // Edge table
+    ssd1306_poly_edge_t edges[SSD1306_POLYGON_MAX_POINTS];
+    int x_min = SSD1306_RASTER_FAR, x_max = -SSD1306_RASTER_FAR;
+    int y_min = SSD1306_RASTER_FAR, y_max = -SSD1306_RASTER_FAR;
+
+    for (uint8_t i = 0; i < count; i++) {
+        const ssd1306_point_t* p = &points[i];
+        const ssd1306_point_t* q = &points[(i + 1) % count];
+        if (p->y > q->y) {
+            const ssd1306_point_t* t = p;
+            p = q;
+            q = t;
+        }
+
+        ssd1306_poly_edge_t* edge = &edges[i];
+        edge->x_top = p->x + clip->origin_x;
+        edge->y_top = p->y + clip->origin_y;
+        edge->x_bottom = q->x + clip->origin_x;
+        edge->y_bottom = q->y + clip->origin_y;
+        edge->half_slope = q->y == p->y ? 0 : (int64_t)(q->x - p->x) * 65536 / (2 * (q->y - p->y));
+
+        if (p->x < x_min) x_min = p->x;
+        if (q->x < x_min) x_min = q->x;
+        if (p->x > x_max) x_max = p->x;
+        if (q->x > x_max) x_max = q->x;
+        if (p->y < y_min) y_min = p->y;
+        if (q->y > y_max) y_max = q->y;
+    }
+    x_min += clip->origin_x;
+    x_max += clip->origin_x;
+    y_min += clip->origin_y;
+    y_max += clip->origin_y;
+
+    int y_first, y_last;
+    if (ssd1306_clip_rejects(clip, x_min, y_min, x_max, y_max)) return ESP_OK;
+    if (!ssd1306_raster_rows(dev, y_min, y_max, &y_first, &y_last)) return ESP_OK;
+
+    ssd1306_raster_t raster;
+    ssd1306_raster_begin(dev, &raster, color);
+
+    for (int y = y_first; y <= y_last; y++) {
+        int16_t spans[SSD1306_POLYGON_MAX_POINTS * 3 / 2][2];
+        int16_t crossings[SSD1306_POLYGON_MAX_POINTS];
+        int n = 0;
+        int n_crossings = 0;
+
+        for (uint8_t i = 0; i < count; i++) {
+            const ssd1306_poly_edge_t* edge = &edges[i];
+            if (y < edge->y_top || y > edge->y_bottom) continue;
+
+            // The edge's own pixels: where it runs from half a row above to half a row below
+            if (edge->y_top == edge->y_bottom) {
+                spans[n][0] = edge->x_top < edge->x_bottom ? edge->x_top : edge->x_bottom;
+                spans[n][1] = edge->x_top < edge->x_bottom ? edge->x_bottom : edge->x_top;
+                n++;
+                continue;
+            }
+            int k = 2 * (y - edge->y_top);
+            int k_end = 2 * (edge->y_bottom - edge->y_top);
+            int xa = ssd1306_poly_edge_x(edge, k > 0 ? k - 1 : 0);
+            int xb = ssd1306_poly_edge_x(edge, k < k_end ? k + 1 : k_end);
+            spans[n][0] = xa < xb ? xa : xb;
+            spans[n][1] = xa < xb ? xb : xa;
+            n++;
+
+            // Crossings of the row centre, counting each edge over [y_top, y_bottom)
+            if (y < edge->y_bottom) {
+                int x = ssd1306_poly_edge_x(edge, k);
+                int j = n_crossings++;
+                while (j > 0 && crossings[j - 1] > x) {
+                    crossings[j] = crossings[j - 1];
+                    j--;
+                }
+                crossings[j] = x;
+            }
+        }
+
+        // Even-odd interior between pairs of crossings
+        for (int i = 0; i + 1 < n_crossings; i += 2) {
+            spans[n][0] = crossings[i];
+            spans[n][1] = crossings[i + 1];
+            n++;
+        }
+
+        // Sort by start, then merge so that no pixel is drawn twice
+        for (int i = 1; i < n; i++) {
+            int16_t lo = spans[i][0];
+            int16_t hi = spans[i][1];
+            int j = i;
+            while (j > 0 && spans[j - 1][0] > lo) {
+                spans[j][0] = spans[j - 1][0];
+                spans[j][1] = spans[j - 1][1];
+                j--;
+            }
+            spans[j][0] = lo;
+            spans[j][1] = hi;
+        }
+        for (int i = 0; i < n;) {
+            int lo = spans[i][0];
+            int hi = spans[i][1];
+            for (i++; i < n && spans[i][0] <= hi + 1; i++) {
+                if (spans[i][1] > hi) hi = spans[i][1];
+            }
+            ssd1306_raster_span(&raster, y, lo, hi);
+        }
+    }
+    ssd1306_raster_end(&raster);
+    return ESP_OK;
+}
+
+// One point of an outline at screen coordinates, checked against the clip only if the outline crosses it
+static inline void ssd1306_plot_point(ssd1306_t* dev, int x, int y, bool check, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    if (check && (x < clip->x0 || y < clip->y0 || x > clip->x1 || y > clip->y1)) return;
+    ssd1306_put_pixel(dev, x, y, color);
+}
+
+void ssd1306_dev_draw_empty_circle(ssd1306_t* dev, uint8_t x0, uint8_t y0, uint8_t radius, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+    SSD1306_STAT_CALL(SSD1306_PRIM_CIRCLE);
+
+    int cx = x0 + clip->origin_x;
+    int cy = y0 + clip->origin_y;
+    if (ssd1306_clip_rejects(clip, cx - radius, cy - radius, cx + radius, cy + radius)) return;
+    bool check = cx - radius < clip->x0 || cy - radius < clip->y0 || cx + radius > clip->x1 || cy + radius > clip->y1;
+
+    int x = 0;
+    int y = radius;
+    int f = 1 - radius;
+    int ddF_x = 1;
+    int ddF_y = -2 * radius;
+
+    if (!radius) {
+        ssd1306_plot_point(dev, cx, cy, check, color);
+        return;
+    }
+    ssd1306_plot_point(dev, cx, cy + radius, check, color);
+    ssd1306_plot_point(dev, cx, cy - radius, check, color);
+    ssd1306_plot_point(dev, cx + radius, cy, check, color);
+    ssd1306_plot_point(dev, cx - radius, cy, check, color);
+
+    // Points where the octants meet are plotted once, so toggling leaves no gaps
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+        if (x > y) break;
+
+        ssd1306_plot_point(dev, cx + x, cy + y, check, color);
+        ssd1306_plot_point(dev, cx - x, cy + y, check, color);
+        ssd1306_plot_point(dev, cx + x, cy - y, check, color);
+        ssd1306_plot_point(dev, cx - x, cy - y, check, color);
+        if (x == y) break;
+        ssd1306_plot_point(dev, cx + y, cy + x, check, color);
+        ssd1306_plot_point(dev, cx - y, cy + x, check, color);
+        ssd1306_plot_point(dev, cx + y, cy - x, check, color);
+        ssd1306_plot_point(dev, cx - y, cy - x, check, color);
+    }
+}
+
+// Sorts the end points and fills the span; shared by the line and triangle primitives
+static void ssd1306_fill_hspan(ssd1306_t* dev, int x_start, int x_end, int y, ssd1306_draw_mode_t color)
+{
+    if (x_start > x_end) {
+        int temp = x_start;
+        x_start = x_end;
+        x_end = temp;
+    }
+    ssd1306_fill_area(dev, x_start, y, x_end, y, color);
+}
+
+// Bresenham's line in closed form: pixel k along the major axis sits floor((2 k minor + major) / (2 major))
+// pixels along the minor axis, the same pixels the incremental algorithm picks. That makes the
+// range of k inside the clip computable up front, and only visible pixels are stepped through.
+// An open line leaves out (x1, y1), where the next edge of an outline starts.
+static void ssd1306_plot_line(ssd1306_t* dev, int x0, int y0, int x1, int y1, bool open, ssd1306_draw_mode_t color)
+{
+    const ssd1306_clip_t* clip = &dev->clip;
+
+    // Axis-aligned lines go through the span fills
+    if (open && (y0 == y1 || x0 == x1)) {
+        if (x0 == x1 && y0 == y1) return;
+        if (y0 == y1) x1 += x0 < x1 ? -1 : 1;
+        else y1 += y0 < y1 ? -1 : 1;
+    }
+    if (y0 == y1) {
+        ssd1306_fill_hspan(dev, x0, x1, y0, color);
+        return;
+    }
+    if (x0 == x1) {
+        ssd1306_fill_area(dev, x0, y0 < y1 ? y0 : y1, x0, y0 < y1 ? y1 : y0, color);
+        return;
+    }
+
+    x0 += clip->origin_x;
+    x1 += clip->origin_x;
+    y0 += clip->origin_y;
+    y1 += clip->origin_y;
+    if (ssd1306_clip_rejects(clip, x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1, x0 < x1 ? x1 : x0, y0 < y1 ? y1 : y0)) return;
+
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int major = steep ? abs(y1 - y0) : abs(x1 - x0);
+    int minor = steep ? abs(x1 - x0) : abs(y1 - y0);
+
+    // Clip ranges as distances from (x0, y0) in the direction of the line
+    int x_lo = sx > 0 ? clip->x0 - x0 : x0 - clip->x1;
+    int x_hi = sx > 0 ? clip->x1 - x0 : x0 - clip->x0;
+    int y_lo = sy > 0 ? clip->y0 - y0 : y0 - clip->y1;
+    int y_hi = sy > 0 ? clip->y1 - y0 : y0 - clip->y0;
+    int m_lo = steep ? x_lo : y_lo;
+    int m_hi = steep ? x_hi : y_hi;
+
+    // The major axis clips k directly, the minor axis through the inverse of the offset formula
+    int k_lo = steep ? y_lo : x_lo;
+    int k_hi = steep ? y_hi : x_hi;
+    int k_min = -ssd1306_div_floor(major - 2 * major * m_lo, 2 * minor);
+    int k_max = ssd1306_div_floor(2 * major * m_hi + major - 1, 2 * minor);
+    if (k_lo < 0) k_lo = 0;
+    if (k_lo < k_min) k_lo = k_min;
+    if (k_hi > major - open) k_hi = major - open;
+    if (k_hi > k_max) k_hi = k_max;
+
+    int num = 2 * k_lo * minor + major;
+    int m = num / (2 * major);
+    int rem = num % (2 * major);
+    for (int k = k_lo; k <= k_hi; k++) {
+        if (steep)
+            ssd1306_put_pixel(dev, x0 + sx * m, y0 + sy * k, color);
+        else
+            ssd1306_put_pixel(dev, x0 + sx * k, y0 + sy * m, color);
+
+        rem += 2 * minor;
+        if (rem >= 2 * major) {
+            rem -= 2 * major;
+            m++;
+        }
+    }
+}
+
+void ssd1306_dev_draw_line(ssd1306_t* dev, int x0, int y0, int x1, int y1, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_LINE);
+    ssd1306_plot_line(dev, x0, y0, x1, y1, false, color);
+}
+
+void ssd1306_dev_draw_horizontal_line(ssd1306_t* dev, int x_start, int x_end, int y, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_LINE);
+    ssd1306_fill_hspan(dev, x_start, x_end, y, color);
+}
+
+void ssd1306_dev_draw_vertical_line(ssd1306_t* dev, int x, int y_start, int y_end, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_LINE);
+    if (y_start > y_end) {
+        int temp = y_start;
+        y_start = y_end;
+        y_end = temp;
+    }
+    ssd1306_fill_area(dev, x, y_start, x, y_end, color);
+}
+
+void ssd1306_dev_draw_empty_triangle(ssd1306_t* dev, int x0, int y0, int x1, int y1, int x2, int y2, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_TRIANGLE);
+    // Each edge leaves out its last vertex, the first of the next edge
+    ssd1306_plot_line(dev, x0, y0, x1, y1, true, color);
+    ssd1306_plot_line(dev, x1, y1, x2, y2, true, color);
+    ssd1306_plot_line(dev, x2, y2, x0, y0, true, color);
+}
+
+// A triangle edge x = x0 + trunc(dx (y - y0) / dy), stepped a row at a time: the quotient and
+// remainder of |dx| (y - y0) / dy are carried along instead of dividing on every row
+typedef struct {
+    int x0;
+    int sign;
+    int dy;
+    int q;
+    int r;
+    int q_step;
+    int r_step;
+} ssd1306_tri_edge_t;
+
+// Sets up an edge rows below its top vertex
+static void ssd1306_tri_edge_init(ssd1306_tri_edge_t* edge, int x0, int dx, int dy, int rows)
+{
+    if (!dy) dy = 1;
+    edge->x0 = x0;
+    edge->sign = dx < 0 ? -1 : 1;
+    edge->dy = dy;
+    edge->q = abs(dx) * rows / dy;
+    edge->r = abs(dx) * rows % dy;
+    edge->q_step = abs(dx) / dy;
+    edge->r_step = abs(dx) % dy;
+}
+
+// x on the current row, then moves to the next
+static inline int ssd1306_tri_edge_step(ssd1306_tri_edge_t* edge)
+{
+    int x = edge->x0 + edge->sign * edge->q;
+    edge->q += edge->q_step;
+    edge->r += edge->r_step;
+    if (edge->r >= edge->dy) {
+        edge->r -= edge->dy;
+        edge->q++;
+    }
+    return x;
+}
+
+void ssd1306_dev_draw_filled_triangle(ssd1306_t* dev, int x0, int y0, int x1, int y1, int x2, int y2, ssd1306_draw_mode_t color)
+{
+    SSD1306_STAT_CALL(SSD1306_PRIM_TRIANGLE);
+
+    // Sort vertices by y-coordinate (ascending)
+    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+    if (y1 > y2) { int t = y1; y1 = y2; y2 = t; t = x1; x1 = x2; x2 = t; }
+    if (y0 > y1) { int t = y0; y0 = y1; y1 = t; t = x0; x0 = x1; x1 = t; }
+
+    if (y0 == y2) {
+        // Degenerate triangle (all on one line)
+        int min_x = x0 < x1 ? (x0 < x2 ? x0 : x2) : (x1 < x2 ? x1 : x2);
+        int max_x = x0 > x1 ? (x0 > x2 ? x0 : x2) : (x1 > x2 ? x1 : x2);
+        ssd1306_fill_hspan(dev, min_x, max_x, y0, color);
+        return;
+    }
+
+    // Rows outside the clip are skipped; the edges start at the first visible one
+    const ssd1306_clip_t* clip = &dev->clip;
+    int y_min = clip->y0 - clip->origin_y;
+    int y_max = clip->y1 - clip->origin_y;
+    int x_min = x0 < x1 ? (x0 < x2 ? x0 : x2) : (x1 < x2 ? x1 : x2);
+    int x_max = x0 > x1 ? (x0 > x2 ? x0 : x2) : (x1 > x2 ? x1 : x2);
+    if (ssd1306_clip_rejects(clip, x_min + clip->origin_x, y0 + clip->origin_y, x_max + clip->origin_x, y2 + clip->origin_y)) return;
+
+    int y = y0 > y_min ? y0 : y_min;
+    int last = (y1 == y2) ? y1 : y1 - 1;
+    if (last > y_max) last = y_max;
+
+    ssd1306_raster_t raster;
+    ssd1306_tri_edge_t a, b;
+    ssd1306_tri_edge_init(&a, x0, x1 - x0, y1 - y0, y - y0);
+    ssd1306_tri_edge_init(&b, x0, x2 - x0, y2 - y0, y - y0);
+    ssd1306_raster_begin(dev, &raster, color);
+
+    for (; y <= last; y++) {
+        int xa = ssd1306_tri_edge_step(&a) + clip->origin_x;
+        int xb = ssd1306_tri_edge_step(&b) + clip->origin_x;
+        ssd1306_raster_span(&raster, y + clip->origin_y, xa < xb ? xa : xb, xa < xb ? xb : xa);
+    }
+
+    ssd1306_tri_edge_init(&a, x1, x2 - x1, y2 - y1, y - y1);
+    for (; y <= y2 && y <= y_max; y++) {
+        int xa = ssd1306_tri_edge_step(&a) + clip->origin_x;
+        int xb = ssd1306_tri_edge_step(&b) + clip->origin_x;
+        ssd1306_raster_span(&raster, y + clip->origin_y, xa < xb ? xa : xb, xa < xb ? xb : xa);
+    }
+    ssd1306_raster_end(&raster);
+}
+
+void ssd1306_dev_overwrite_char(ssd1306_t* dev, uint8_t x, uint8_t y, char old, char new, uint8_t old_size_x, uint8_t old_size_y, uint8_t new_size_x, uint8_t new_size_y)
+{
+	// Same cell: clear the old glyph and set the new one in one pass
+	if (old_size_x == new_size_x && old_size_y == new_size_y && new_size_y <= 7 && ssd1306_char_supported(new)) {
+		SSD1306_STAT_CALL(SSD1306_PRIM_CHAR);
+		ssd1306_draw_glyph(dev, x, y, new, ssd1306_char_supported(old) ? old : 0, new_size_x, new_size_y, COLOR_WHITE);
+		return;
+	}
+
+	ssd1306_dev_draw_char(dev, x, y, old, old_size_x, old_size_y, COLOR_BLACK);
+	ssd1306_dev_draw_char(dev, x, y, new, new_size_x, new_size_y, COLOR_WHITE);
+}
+
+void ssd1306_dev_overwrite_string_char_by_char(ssd1306_t* dev, uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms)
+{
+    ssd1306_anim_t anim;
+    ssd1306_anim_overwrite_init(&anim, dev, x, y, old_str, new_str, size_x, size_y, tick_delay_ms);
+    ssd1306_anim_start(&anim);
+    ssd1306_anim_wait(&anim);
+}
+
+void ssd1306_dev_overwrite_string_wrapped_char_by_char(ssd1306_t* dev, uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms)
+{
+    ssd1306_anim_t anim;
+    ssd1306_anim_overwrite_init(&anim, dev, x, y, old_str, new_str, size_x, size_y, tick_delay_ms);
+    ssd1306_anim_set_wrap(&anim, true);
+    ssd1306_anim_start(&anim);
+    ssd1306_anim_wait(&anim);
+}
+
+void ssd1306_dev_overwrite_string_centered_char_by_char(ssd1306_t* dev, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms)
+{
+    ssd1306_dev_draw_string_centered(dev, y, old_str, size_x, size_y, COLOR_BLACK);
+    ssd1306_dev_draw_string_centered_char_by_char(dev, y, new_str, size_x, size_y, tick_delay_ms, COLOR_WHITE);
+}
+
+void ssd1306_cmd(uint8_t cmd)
+{
+    ssd1306_dev_cmd(&ssd1306_default, cmd);
+}
+
+void ssd1306_cmd_list(const uint8_t* cmds, size_t len)
+{
+    ssd1306_dev_cmd_list(&ssd1306_default, cmds, len);
+}
+
+void ssd1306_mark_dirty(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    ssd1306_dev_mark_dirty(&ssd1306_default, x, y, w, h);
+}
+
+void ssd1306_display(void)
+{
+    ssd1306_dev_display(&ssd1306_default);
+}
+
+esp_err_t ssd1306_diff_flush_start(void)
+{
+    return ssd1306_dev_diff_flush_start(&ssd1306_default);
+}
+
+void ssd1306_diff_flush_stop(void)
+{
+    ssd1306_dev_diff_flush_stop(&ssd1306_default);
+}
+
+esp_err_t ssd1306_flush_task_start(UBaseType_t priority)
+{
+    return ssd1306_dev_flush_task_start(&ssd1306_default, priority);
+}
+
+esp_err_t ssd1306_display_async(void)
+{
+    return ssd1306_dev_display_async(&ssd1306_default);
+}
+
+esp_err_t ssd1306_wait_flush(uint32_t timeout_ms)
+{
+    return ssd1306_dev_wait_flush(&ssd1306_default, timeout_ms);
+}
+
+void ssd1306_set_flush_callback(ssd1306_flush_cb_t cb, void* arg)
+{
+    ssd1306_dev_set_flush_callback(&ssd1306_default, cb, arg);
+}
+
+esp_err_t ssd1306_scroll_start(ssd1306_scroll_dir_t dir, uint8_t start_page, uint8_t end_page, ssd1306_scroll_speed_t speed, uint8_t vertical_offset)
+{
+    return ssd1306_dev_scroll_start(&ssd1306_default, dir, start_page, end_page, speed, vertical_offset);
+}
+
+esp_err_t ssd1306_scroll_set_vertical_area(uint8_t fixed_rows, uint8_t scroll_rows)
+{
+    return ssd1306_dev_scroll_set_vertical_area(&ssd1306_default, fixed_rows, scroll_rows);
+}
+
+void ssd1306_scroll_stop(void)
+{
+    ssd1306_dev_scroll_stop(&ssd1306_default);
+}
+
+bool ssd1306_is_scrolling(void)
+{
+    return ssd1306_dev_is_scrolling(&ssd1306_default);
+}
+
+void ssd1306_display_full(void)
+{
+    ssd1306_dev_display_full(&ssd1306_default);
+}
+
+esp_err_t ssd1306_render_paged(ssd1306_page_draw_cb_t draw, void* arg, uint8_t* band, size_t band_size, ssd1306_paged_stats_t* stats)
+{
+    return ssd1306_dev_render_paged(&ssd1306_default, draw, arg, band, band_size, stats);
+}
+
+void ssd1306_clear(void)
+{
+    ssd1306_dev_clear(&ssd1306_default);
+}
+
+void ssd1306_data(uint8_t* data, size_t len)
+{
+    ssd1306_dev_data(&ssd1306_default, data, len);
+}
+
+esp_err_t ssd1306_push_clip(int x, int y, int w, int h)
+{
+    return ssd1306_dev_push_clip(&ssd1306_default, x, y, w, h);
+}
+
+esp_err_t ssd1306_push_viewport(int x, int y, int w, int h)
+{
+    return ssd1306_dev_push_viewport(&ssd1306_default, x, y, w, h);
+}
+
+esp_err_t ssd1306_pop_clip(void)
+{
+    return ssd1306_dev_pop_clip(&ssd1306_default);
+}
+
+void ssd1306_reset_clip(void)
+{
+    ssd1306_dev_reset_clip(&ssd1306_default);
+}
+
+void ssd1306_draw_pixel(uint8_t x, uint8_t y, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_pixel(&ssd1306_default, x, y, color);
+}
+
+void ssd1306_draw_char(uint8_t x, uint8_t y, char c, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_char(&ssd1306_default, x, y, c, size_x, size_y, color);
+}
+
+void ssd1306_draw_string(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_string(&ssd1306_default, x, y, str, size_x, size_y, color);
+}
+
+void ssd1306_draw_string_wrapped(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_string_wrapped(&ssd1306_default, x, y, str, size_x, size_y, color);
+}
+
+void ssd1306_draw_string_char_by_char(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_string_char_by_char(&ssd1306_default, x, y, str, size_x, size_y, tick_delay_ms, color);
+}
+
+void ssd1306_draw_string_wrapped_char_by_char(uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_string_wrapped_char_by_char(&ssd1306_default, x, y, str, size_x, size_y, tick_delay_ms, color);
+}
+
+void ssd1306_draw_string_centered(uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_string_centered(&ssd1306_default, y, str, size_x, size_y, color);
+}
+
+void ssd1306_draw_string_centered_char_by_char(uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_string_centered_char_by_char(&ssd1306_default, y, str, size_x, size_y, tick_delay_ms, color);
+}
+
+void ssd1306_draw_bitmap(int x, int y, const uint8_t* bitmap, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_bitmap(&ssd1306_default, x, y, bitmap, w, h, color);
+}
+
+void ssd1306_draw_bitmap_rle(int x, int y, const uint8_t* data, size_t len, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_bitmap_rle(&ssd1306_default, x, y, data, len, w, h, color);
+}
+
+int ssd1306_draw_char_font(int x, int y, const ssd1306_font_t* font, char c, ssd1306_draw_mode_t color)
+{
+    return ssd1306_dev_draw_char_font(&ssd1306_default, x, y, font, c, color);
+}
+
+int ssd1306_draw_string_font(int x, int y, const ssd1306_font_t* font, const char* str, ssd1306_draw_mode_t color)
+{
+    return ssd1306_dev_draw_string_font(&ssd1306_default, x, y, font, str, color);
+}
+
+void ssd1306_draw_string_font_centered(int y, const ssd1306_font_t* font, const char* str, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_string_font_centered(&ssd1306_default, y, font, str, color);
+}
+
+void ssd1306_draw_full_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_full_rect(&ssd1306_default, x, y, w, h, color);
+}
+
+void ssd1306_draw_empty_rect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_empty_rect(&ssd1306_default, x, y, w, h, color);
+}
+
+void ssd1306_clear_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    ssd1306_dev_clear_region(&ssd1306_default, x, y, w, h);
+}
+
+void ssd1306_invert_region(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+    ssd1306_dev_invert_region(&ssd1306_default, x, y, w, h);
+}
+
+void ssd1306_draw_full_circle(uint8_t x0, uint8_t y0, uint8_t radius, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_full_circle(&ssd1306_default, x0, y0, radius, color);
+}
+
+void ssd1306_draw_full_ellipse(int x0, int y0, uint8_t rx, uint8_t ry, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_full_ellipse(&ssd1306_default, x0, y0, rx, ry, color);
+}
+
+void ssd1306_draw_empty_ellipse(int x0, int y0, uint8_t rx, uint8_t ry, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_empty_ellipse(&ssd1306_default, x0, y0, rx, ry, color);
+}
+
+void ssd1306_draw_arc(int x0, int y0, uint8_t radius, uint8_t inner_radius, int16_t start_angle, int16_t end_angle, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_arc(&ssd1306_default, x0, y0, radius, inner_radius, start_angle, end_angle, color);
+}
+
+void ssd1306_draw_full_round_rect(int x, int y, uint8_t w, uint8_t h, uint8_t radius, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_full_round_rect(&ssd1306_default, x, y, w, h, radius, color);
+}
+
+void ssd1306_draw_empty_round_rect(int x, int y, uint8_t w, uint8_t h, uint8_t radius, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_empty_round_rect(&ssd1306_default, x, y, w, h, radius, color);
+}
+
+esp_err_t ssd1306_draw_filled_polygon(const ssd1306_point_t* points, uint8_t count, ssd1306_draw_mode_t color)
+{
+    return ssd1306_dev_draw_filled_polygon(&ssd1306_default, points, count, color);
+}
+
+void ssd1306_draw_empty_circle(uint8_t x0, uint8_t y0, uint8_t radius, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_empty_circle(&ssd1306_default, x0, y0, radius, color);
+}
+
+void ssd1306_draw_line(int x0, int y0, int x1, int y1, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_line(&ssd1306_default, x0, y0, x1, y1, color);
+}
+
+void ssd1306_draw_horizontal_line(int x_start, int x_end, int y, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_horizontal_line(&ssd1306_default, x_start, x_end, y, color);
+}
+
+void ssd1306_draw_vertical_line(int x, int y_start, int y_end, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_vertical_line(&ssd1306_default, x, y_start, y_end, color);
+}
+
+void ssd1306_draw_empty_triangle(int x0, int y0, int x1, int y1, int x2, int y2, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_empty_triangle(&ssd1306_default, x0, y0, x1, y1, x2, y2, color);
+}
+
+void ssd1306_draw_filled_triangle(int x0, int y0, int x1, int y1, int x2, int y2, ssd1306_draw_mode_t color)
+{
+    ssd1306_dev_draw_filled_triangle(&ssd1306_default, x0, y0, x1, y1, x2, y2, color);
+}
+
+void ssd1306_overwrite_char(uint8_t x, uint8_t y, char old, char new, uint8_t old_size_x, uint8_t old_size_y, uint8_t new_size_x, uint8_t new_size_y)
+{
+    ssd1306_dev_overwrite_char(&ssd1306_default, x, y, old, new, old_size_x, old_size_y, new_size_x, new_size_y);
+}
+
+void ssd1306_overwrite_string_char_by_char(uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms)
+{
+    ssd1306_dev_overwrite_string_char_by_char(&ssd1306_default, x, y, old_str, new_str, size_x, size_y, tick_delay_ms);
+}
+
+void ssd1306_overwrite_string_wrapped_char_by_char(uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms)
+{
+    ssd1306_dev_overwrite_string_wrapped_char_by_char(&ssd1306_default, x, y, old_str, new_str, size_x, size_y, tick_delay_ms);
 }
 
 void ssd1306_overwrite_string_centered_char_by_char(uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t tick_delay_ms)
 {
-    ssd1306_draw_string_centered(y, old_str, size_x, size_y, COLOR_BLACK);
-    ssd1306_draw_string_centered_char_by_char(y, new_str, size_x, size_y, tick_delay_ms, COLOR_WHITE);
+    ssd1306_dev_overwrite_string_centered_char_by_char(&ssd1306_default, y, old_str, new_str, size_x, size_y, tick_delay_ms);
 }
@@ -0,0 +1,309 @@
+/**
+ * @file ssd1306_anim.c
+ * @author Abdulaziz Alrashidi
+ * @brief Non-blocking text animations for the SSD1306 driver.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ * 
+ * @details
+ * Each effect is an ssd1306_anim_t advanced by ssd1306_anim_tick(). A tick draws every character that
+ * has come due across all running effects into the framebuffers and then flushes each affected panel
+ * once; since drawing only marks the touched columns dirty, that flush carries just the new glyphs.
+ * The blocking *_char_by_char() functions in ssd1306.c run a single effect through ssd1306_anim_wait().
+ * Steps are due on a grid of esp_timer_get_time() microseconds rather than ticks, so intervals are
+ * not rounded to the tick period and sleeping late does not shift the characters after it.
+ */
+
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+#include "ssd1306.h"
+#include "ssd1306_anim.h"
+
+static ssd1306_anim_t* running_head;    // scheduled animations, in start order
+
+static void ssd1306_anim_init(ssd1306_anim_t* anim, ssd1306_t* dev, uint8_t x, uint8_t y, uint8_t size_x, uint8_t size_y, uint32_t interval_ms)
+{
+    anim->next = NULL;
+    anim->dev = dev;
+    anim->start_x = x;
+    anim->x = x;
+    anim->y = y;
+    anim->size_x = size_x;
+    anim->size_y = size_y;
+    anim->wrap = false;
+    anim->str = "";
+    anim->old_str = NULL;
+    anim->layout = NULL;
+    anim->old_layout = NULL;
+    anim->index = 0;
+    anim->interval_us = interval_ms * 1000;
+    anim->next_step_us = 0;
+    anim->running = false;
+    anim->stepped = false;
+}
+
+void ssd1306_anim_type_init(ssd1306_anim_t* anim, ssd1306_t* dev, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint32_t interval_ms, ssd1306_draw_mode_t color)
+{
+    ssd1306_anim_init(anim, dev, x, y, size_x, size_y, interval_ms);
+    anim->str = str;
+    anim->old_str = NULL;
+    anim->color = color;
+}
+
+void ssd1306_anim_overwrite_init(ssd1306_anim_t* anim, ssd1306_t* dev, uint8_t x, uint8_t y, const char* old_str, const char* new_str, uint8_t size_x, uint8_t size_y, uint32_t interval_ms)
+{
+    ssd1306_anim_init(anim, dev, x, y, size_x, size_y, interval_ms);
+    anim->str = new_str;
+    anim->old_str = old_str;
+    anim->color = COLOR_WHITE;
+}
+
+void ssd1306_anim_layout_init(ssd1306_anim_t* anim, ssd1306_t* dev, const ssd1306_layout_t* layout, uint32_t interval_ms, ssd1306_draw_mode_t color)
+{
+    ssd1306_anim_init(anim, dev, 0, 0, 1, 1, interval_ms);
+    anim->layout = layout;
+    anim->color = color;
+}
+
+static void ssd1306_anim_cursor_init(ssd1306_anim_cursor_t* cursor, const ssd1306_layout_t* layout)
+{
+    cursor->index = 0;
+    cursor->line = 0;
+    cursor->x = layout->line_count ? layout->lines[0].x : 0;
+}
+
+static void ssd1306_anim_cursor_next(ssd1306_anim_cursor_t* cursor, const ssd1306_layout_t* layout)
+{
+    if (cursor->line >= layout->line_count) {
+        cursor->index++;
+        return;
+    }
+
+    const ssd1306_layout_line_t* line = &layout->lines[cursor->line];
+    if (cursor->index >= line->start && cursor->index < line->start + line->len) {
+        cursor->x += ssd1306_font_char_width(layout->font, layout->str[cursor->index]);
+    }
+    cursor->index++;
+
+    // Past the line's last glyph, its ellipsis included
+    if (cursor->index >= line->start + line->len + line->ellipsis && ++cursor->line < layout->line_count) {
+        cursor->x = layout->lines[cursor->line].x;
+    }
+}
+
+// Columns [x0, x1) and the line's rows [y0, y1) the glyph at the cursor can touch; false for the
+// spaces lines were broken at, which are not drawn
+static bool ssd1306_anim_cursor_box(const ssd1306_anim_cursor_t* cursor, const ssd1306_layout_t* layout, int* x0, int* y0, int* x1, int* y1)
+{
+    if (cursor->line >= layout->line_count) return false;
+
+    const ssd1306_layout_line_t* line = &layout->lines[cursor->line];
+    const ssd1306_font_t* font = layout->font;
+    if (cursor->index < line->start) return false;
+
+    // The ellipsis is three dots
+    bool dots = cursor->index == line->start + line->len;
+    uint8_t code = dots ? '.' : layout->str[cursor->index];
+    int left = 0;
+    int right = 0;
+
+    if (code >= font->first && code <= font->last) {
+        const ssd1306_glyph_t* glyph = &font->glyphs[code - font->first];
+        int ink_end = glyph->x_offset + glyph->width;
+        left = glyph->x_offset < 0 ? glyph->x_offset : 0;
+        right = (dots ? 2 * glyph->advance : 0) + (ink_end > glyph->advance ? ink_end : glyph->advance);
+    }
+
+    *x0 = cursor->x + left;
+    *x1 = cursor->x + right;
+    *y0 = layout->y + cursor->line * font->height;
+    *y1 = *y0 + font->height;
+    return true;
+}
+
+void ssd1306_anim_layout_overwrite_init(ssd1306_anim_t* anim, ssd1306_t* dev, const ssd1306_layout_t* old_layout, const ssd1306_layout_t* new_layout, uint32_t interval_ms)
+{
+    ssd1306_anim_init(anim, dev, 0, 0, 1, 1, interval_ms);
+    anim->layout = new_layout;
+    anim->old_layout = old_layout;
+    anim->color = COLOR_WHITE;
+    ssd1306_anim_cursor_init(&anim->erase, old_layout);
+    ssd1306_anim_cursor_init(&anim->redraw, new_layout);
+}
+
+void ssd1306_anim_set_wrap(ssd1306_anim_t* anim, bool wrap)
+{
+    anim->wrap = wrap;
+}
+
+static bool ssd1306_anim_finished(const ssd1306_anim_t* anim)
+{
+    if (anim->layout) {
+        return anim->index >= ssd1306_layout_end(anim->layout) &&
+               (!anim->old_layout || anim->index >= ssd1306_layout_end(anim->old_layout));
+    }
+    return !*anim->str && (!anim->old_str || !*anim->old_str);
+}
+
+// Draws (or replaces) the next index of the layouts
+static void ssd1306_anim_layout_step(ssd1306_anim_t* anim)
+{
+    if (anim->old_layout) {
+        int x0, y0, x1, y1;
+        uint16_t first = anim->index;
+
+        // The old glyph may overlap new ones already drawn, so those are drawn again. Both layouts
+        // advance in reading order: a new glyph above this old one, or on its rows and left of it,
+        // is out of reach of every old glyph still to come.
+        if (ssd1306_anim_cursor_box(&anim->erase, anim->old_layout, &x0, &y0, &x1, &y1)) {
+            ssd1306_layout_draw_range(anim->old_layout, anim->dev, anim->index, 1, COLOR_BLACK);
+
+            while (anim->redraw.index < anim->index) {
+                int nx0, ny0, nx1, ny1;
+                bool drawn = ssd1306_anim_cursor_box(&anim->redraw, anim->layout, &nx0, &ny0, &nx1, &ny1);
+                if (drawn && ny1 > y0 && (ny1 > y1 || nx1 > x0)) break;
+                ssd1306_anim_cursor_next(&anim->redraw, anim->layout);
+            }
+            first = anim->redraw.index;
+        }
+        ssd1306_layout_draw_range(anim->layout, anim->dev, first, anim->index + 1 - first, COLOR_WHITE);
+        ssd1306_anim_cursor_next(&anim->erase, anim->old_layout);
+    } else {
+        ssd1306_layout_draw_range(anim->layout, anim->dev, anim->index, 1, anim->color);
+    }
+    anim->index++;
+}
+
+// Draws (or replaces) one character on the animation's panel
+static void ssd1306_anim_step(ssd1306_anim_t* anim)
+{
+    ssd1306_t* dev = anim->dev;
+    int advance = 6 * anim->size_x;     // 5 pixels + 1 space, scaled
+
+    if (ssd1306_anim_finished(anim)) {
+        anim->running = false;
+        return;
+    }
+
+    if (anim->layout) {
+        ssd1306_anim_layout_step(anim);
+        anim->stepped = true;
+        if (ssd1306_anim_finished(anim)) anim->running = false;
+        return;
+    }
+
+    if (anim->wrap && anim->x + advance >= dev->width) {
+        anim->x = anim->start_x;
+        anim->y += 8 * anim->size_y;
+        if (anim->y >= dev->height) {
+            anim->running = false;
+            return;
+        }
+    }
+
+    char old = anim->old_str && *anim->old_str ? *anim->old_str++ : 0;
+    char new = *anim->str ? *anim->str++ : 0;
+
+    if (old && new) {
+        ssd1306_dev_overwrite_char(dev, anim->x, anim->y, old, new, anim->size_x, anim->size_y, anim->size_x, anim->size_y);
+    } else if (new) {
+        ssd1306_dev_draw_char(dev, anim->x, anim->y, new, anim->size_x, anim->size_y, anim->color);
+    } else {
+        ssd1306_dev_draw_char(dev, anim->x, anim->y, old, anim->size_x, anim->size_y, COLOR_BLACK);
+    }
+
+    anim->x += advance;
+    anim->stepped = true;
+    if (ssd1306_anim_finished(anim)) anim->running = false;
+}
+
+void ssd1306_anim_start(ssd1306_anim_t* anim)
+{
+    if (anim->running) return;
+
+    anim->next = NULL;
+    anim->next_step_us = esp_timer_get_time();
+    anim->stepped = false;
+    anim->running = true;
+
+    ssd1306_anim_t** link = &running_head;
+    while (*link) link = &(*link)->next;
+    *link = anim;
+}
+
+void ssd1306_anim_stop(ssd1306_anim_t* anim)
+{
+    for (ssd1306_anim_t** link = &running_head; *link; link = &(*link)->next) {
+        if (*link == anim) {
+            *link = anim->next;
+            break;
+        }
+    }
+    anim->running = false;
+}
+
+bool ssd1306_anim_done(const ssd1306_anim_t* anim)
+{
+    return !anim->running;
+}
+
+uint32_t ssd1306_anim_tick(void)
+{
+    int64_t now = esp_timer_get_time();
+
+    // Draw everything that is due; late animations catch up here
+    for (ssd1306_anim_t* anim = running_head; anim; anim = anim->next) {
+        while (anim->running && now >= anim->next_step_us) {
+            ssd1306_anim_step(anim);
+            anim->next_step_us += anim->interval_us;
+        }
+    }
+
+    // One flush per panel that changed
+    for (ssd1306_anim_t* anim = running_head; anim; anim = anim->next) {
+        if (!anim->stepped) continue;
+
+        bool flushed = false;
+        for (ssd1306_anim_t* other = running_head; other != anim; other = other->next) {
+            if (other->stepped && other->dev == anim->dev) flushed = true;
+        }
+        if (flushed) continue;
+
+        ssd1306_dev_display(anim->dev);
+    }
+
+    // Retire finished animations and find the next deadline
+    int64_t wait = INT64_MAX;
+    bool idle = true;
+    ssd1306_anim_t** link = &running_head;
+
+    while (*link) {
+        ssd1306_anim_t* anim = *link;
+        anim->stepped = false;
+
+        if (!anim->running) {
+            *link = anim->next;
+            continue;
+        }
+
+        int64_t due = anim->next_step_us > now ? anim->next_step_us - now : 0;
+        if (due < wait) wait = due;
+        idle = false;
+        link = &anim->next;
+    }
+
+    return idle ? SSD1306_ANIM_IDLE : (uint32_t)((wait + 999) / 1000);
+}
+
+void ssd1306_anim_wait(const ssd1306_anim_t* anim)
+{
+    while (anim->running) {
+        uint32_t wait_ms = ssd1306_anim_tick();
+        if (anim->running && wait_ms != SSD1306_ANIM_IDLE) vTaskDelay((wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS);
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * @file ssd1306_dither.c
+ * @author Abdulaziz Alrashidi
+ * @brief Streaming dithering for the SSD1306 driver: 8-bit grayscale rows straight into the framebuffer.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ *
+ * @details
+ * A source row is one bit of every framebuffer byte it covers: row y sets or clears bit y % 8 of
+ * page y / 8. The ordered mode compares each pixel with a precomputed threshold from a Bayer row
+ * picked by the screen row, so it is one table lookup and compare per pixel. Floyd–Steinberg keeps
+ * the error pushed down into the next row in one array of the image's width; the error pushed
+ * right and the two partial sums for the row below travel in locals while a row is walked.
+ */
+
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_dither.h"
+
+// 8x8 Bayer matrix scaled to gray levels (4 * index + 2): a pixel is on if its level is above it
+static const uint8_t bayer_threshold[8][8] = {
+    {   2, 130,  34, 162,  10, 138,  42, 170 },
+    { 194,  66, 226,  98, 202,  74, 234, 106 },
+    {  50, 178,  18, 146,  58, 186,  26, 154 },
+    { 242, 114, 210,  82, 250, 122, 218,  90 },
+    {  14, 142,  46, 174,   6, 134,  38, 166 },
+    { 206,  78, 238, 110, 198,  70, 230, 102 },
+    {  62, 190,  30, 158,  54, 182,  22, 150 },
+    { 254, 126, 222,  94, 246, 118, 214,  86 },
+};
+
+esp_err_t ssd1306_dither_begin(ssd1306_dither_t* dither, ssd1306_t* dev, int x, int y, uint8_t width, uint8_t height, ssd1306_dither_mode_t mode)
+{
+    if (!width || !height || width > SSD1306_MAX_WIDTH) return ESP_ERR_INVALID_ARG;
+
+    dither->dev = dev;
+    dither->mode = mode;
+    dither->x = x + dev->clip.origin_x;
+    dither->y = y + dev->clip.origin_y;
+    dither->width = width;
+    dither->height = height;
+    dither->row = 0;
+    memset(dither->error, 0, sizeof(dither->error));
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_dither_row(ssd1306_dither_t* dither, const uint8_t* pixels)
+{
+    if (dither->row >= dither->height) return ESP_ERR_INVALID_STATE;
+
+    ssd1306_t* dev = dither->dev;
+    const ssd1306_clip_t* clip = &dev->clip;
+    int y = dither->y + dither->row++;
+    int x_start = dither->x > clip->x0 ? dither->x : clip->x0;
+    int x_end = dither->x + dither->width - 1;
+    if (x_end > clip->x1) x_end = clip->x1;
+    bool visible = y >= clip->y0 && y <= clip->y1 && x_start <= x_end;
+
+    // Error diffusion has to walk the whole row, visible or not
+    if (!visible && dither->mode != SSD1306_DITHER_FLOYD_STEINBERG) return ESP_OK;
+
+    uint8_t* column = visible ? &dev->buffer[(y / 8 - dev->band_first_page) * dev->width] : NULL;
+    uint8_t bit = 1 << (y & 7);
+
+    switch (dither->mode) {
+    case SSD1306_DITHER_THRESHOLD:
+        for (int x = x_start; x <= x_end; x++) {
+            if (pixels[x - dither->x] >= 128) column[x] |= bit;
+            else column[x] &= ~bit;
+        }
+        break;
+
+    case SSD1306_DITHER_BAYER: {
+        const uint8_t* threshold = bayer_threshold[y & 7];
+        for (int x = x_start; x <= x_end; x++) {
+            if (pixels[x - dither->x] > threshold[x & 7]) column[x] |= bit;
+            else column[x] &= ~bit;
+        }
+        break;
+    }
+
+    case SSD1306_DITHER_FLOYD_STEINBERG: {
+        int16_t* error = dither->error;
+        int right = 0;          // 7/16 of the last error, for this pixel
+        int below_left = 0;     // next row, one column left: complete once this pixel adds its 3/16
+        int below = 0;          // next row, this column: the 1/16 from the pixel to the left
+
+        for (int i = 0; i < dither->width; i++) {
+            int level = pixels[i] + error[i] + right;
+            bool on = level >= 128;
+            int e = level - (on ? 255 : 0);
+            int e7 = e * 7 / 16, e3 = e * 3 / 16, e5 = e * 5 / 16;
+
+            // error[i - 1] was read by the previous pixel, so it can take its next-row value
+            if (i) error[i - 1] = below_left + e3;
+            below_left = below + e5;
+            below = e - e7 - e3 - e5;
+            right = e7;
+
+            int x = dither->x + i;
+            if (!visible || x < x_start || x > x_end) continue;
+            if (on) column[x] |= bit;
+            else column[x] &= ~bit;
+        }
+        error[dither->width - 1] = below_left;
+        if (!visible) return ESP_OK;
+        break;
+    }
+    }
+
+    ssd1306_dev_mark_dirty(dev, x_start, y, x_end - x_start + 1, 1);
+    ssd1306_stats_add_pixels(x_end - x_start + 1);
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_dev_draw_gray_image(ssd1306_t* dev, int x, int y, const uint8_t* pixels, uint8_t width, uint8_t height, ssd1306_dither_mode_t mode)
+{
+    ssd1306_dither_t dither;
+    esp_err_t err = ssd1306_dither_begin(&dither, dev, x, y, width, height, mode);
+    if (err != ESP_OK) return err;
+
+    for (uint8_t row = 0; row < height; row++) {
+        ssd1306_dither_row(&dither, &pixels[(size_t)row * width]);
+    }
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_draw_gray_image(int x, int y, const uint8_t* pixels, uint8_t width, uint8_t height, ssd1306_dither_mode_t mode)
+{
+    return ssd1306_dev_draw_gray_image(&ssd1306_default, x, y, pixels, width, height, mode);
+}
@@ -0,0 +1,200 @@
+/**
+ * @file ssd1306_font_sans16.c
+ * @brief ssd1306_font_sans16: DejaVuSans.ttf at 16 px, characters 32-126, 19 px line.
+ * 
+ * Generated by host/font2c.py; 1288 bytes of glyph bitmaps.
+ * DejaVu fonts: Bitstream Vera license, see https://dejavu-fonts.github.io/License.html
+ */
+
+#include "ssd1306.h"
+
+static const uint8_t ssd1306_font_sans16_bitmaps[] = {
+    0xFF, 0x7E, 0x0C, 0x0C, 0x1F, 0x00, 0x00, 0x1F, 0x80, 0x90, 0x90, 0xF0, 0xBE, 0x92, 0x90, 0xF8,
+    0x9F, 0x90, 0x10, 0x01, 0x01, 0x0F, 0x03, 0x01, 0x09, 0x0F, 0x01, 0x01, 0x01, 0x00, 0x38, 0x6C,
+    0x44, 0xFF, 0xC4, 0x84, 0x84, 0x0C, 0x08, 0x08, 0x3F, 0x08, 0x0C, 0x07, 0x3E, 0x23, 0x61, 0x23,
+    0x3E, 0x80, 0x60, 0x30, 0x8C, 0xC3, 0x41, 0x40, 0x80, 0x00, 0x00, 0x00, 0x0C, 0x06, 0x01, 0x00,
+    0x00, 0x07, 0x0C, 0x08, 0x08, 0x07, 0x80, 0xEC, 0x3E, 0x33, 0x61, 0xC3, 0x83, 0x00, 0x00, 0xC0,
+    0x03, 0x07, 0x0C, 0x08, 0x08, 0x08, 0x0D, 0x07, 0x07, 0x0D, 0x1F, 0xF8, 0xFE, 0x03, 0x07, 0x1F,
+    0x30, 0x03, 0xFE, 0xF8, 0x30, 0x1F, 0x07, 0x24, 0x14, 0x18, 0xFF, 0x18, 0x14, 0x24, 0x30, 0x30,
+    0x30, 0x30, 0xFF, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0F, 0x03, 0x01, 0x01, 0x01, 0x01, 0x03, 0x03, 0x00, 0x00, 0xE0, 0x3C, 0x07, 0x30,
+    0x1E, 0x03, 0x00, 0x00, 0xF8, 0xFE, 0x03, 0x03, 0x03, 0x03, 0xFE, 0xFC, 0x01, 0x07, 0x0C, 0x08,
+    0x08, 0x0C, 0x07, 0x03, 0x02, 0x03, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x08, 0x08, 0x0F, 0x0F, 0x08,
+    0x08, 0x08, 0x02, 0x03, 0x03, 0x83, 0xC3, 0x76, 0x3E, 0x0C, 0x0E, 0x0B, 0x09, 0x08, 0x08, 0x08,
+    0x02, 0x03, 0x63, 0x63, 0x63, 0x73, 0xDE, 0x00, 0x0C, 0x08, 0x08, 0x08, 0x08, 0x0C, 0x07, 0x03,
+    0x80, 0xC0, 0x70, 0x18, 0x06, 0xFF, 0xFF, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x0F, 0x0F,
+    0x01, 0x01, 0x3F, 0x3F, 0x33, 0x33, 0x23, 0xE3, 0xC0, 0x08, 0x08, 0x08, 0x08, 0x0C, 0x07, 0x03,
+    0xF8, 0xFE, 0x22, 0x33, 0x33, 0x23, 0xE3, 0xC0, 0x03, 0x07, 0x0C, 0x08, 0x08, 0x0C, 0x07, 0x03,
+    0x03, 0x03, 0x03, 0x83, 0xE3, 0x3F, 0x0F, 0x00, 0x00, 0x0C, 0x0F, 0x01, 0x00, 0x00, 0x8C, 0xDE,
+    0x63, 0x63, 0x63, 0x63, 0xFE, 0x9C, 0x07, 0x0F, 0x0C, 0x08, 0x08, 0x08, 0x0F, 0x07, 0x3C, 0x7E,
+    0xC3, 0x83, 0x83, 0xC3, 0xFE, 0xF8, 0x00, 0x08, 0x08, 0x08, 0x08, 0x0C, 0x07, 0x01, 0xC3, 0xC3,
+    0xC3, 0xC3, 0x03, 0x00, 0x18, 0x18, 0x3C, 0x24, 0x24, 0x66, 0x42, 0x42, 0xC3, 0x81, 0x09, 0x09,
+    0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x81, 0xC3, 0x42, 0x42, 0x66, 0x24, 0x24, 0x3C,
+    0x18, 0x18, 0x02, 0x03, 0xC3, 0xE3, 0x33, 0x1E, 0x00, 0x00, 0x0D, 0x0C, 0x00, 0x00, 0xF0, 0x0C,
+    0x06, 0xC2, 0xF1, 0x19, 0x19, 0x19, 0x31, 0xF9, 0x02, 0x06, 0xFC, 0x60, 0x03, 0x06, 0x08, 0x10,
+    0x13, 0x32, 0x22, 0x22, 0x33, 0x13, 0x12, 0x02, 0x01, 0x00, 0x00, 0x00, 0xE0, 0x7C, 0x0F, 0x07,
+    0x1E, 0xF0, 0x80, 0x00, 0x0C, 0x0F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x07, 0x0E, 0xFF, 0xFF,
+    0x63, 0x63, 0x63, 0x63, 0xFE, 0x9C, 0x0F, 0x0F, 0x08, 0x08, 0x08, 0x0C, 0x0E, 0x07, 0xF8, 0xFC,
+    0x06, 0x03, 0x03, 0x03, 0x03, 0x03, 0x02, 0x01, 0x07, 0x0E, 0x0C, 0x08, 0x08, 0x08, 0x08, 0x0C,
+    0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, 0x02, 0x06, 0xFC, 0xF0, 0x0F, 0x0F, 0x08, 0x08, 0x08, 0x0C,
+    0x0C, 0x06, 0x03, 0x01, 0xFF, 0xFF, 0x63, 0x63, 0x63, 0x63, 0x63, 0x00, 0x0F, 0x0F, 0x08, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0xFF, 0xFF, 0x63, 0x63, 0x63, 0x63, 0x03, 0x0F, 0x0F, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF8, 0xFC, 0x06, 0x03, 0x03, 0x03, 0x43, 0x43, 0xC2, 0xC2, 0x01, 0x07, 0x04, 0x0C,
+    0x08, 0x08, 0x08, 0x08, 0x0F, 0x07, 0xFF, 0xFF, 0x60, 0x60, 0x60, 0x60, 0x60, 0xFE, 0xFF, 0x0F,
+    0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0xFF, 0xFF, 0x0F, 0x0F, 0x00, 0x00, 0xFF, 0xFF,
+    0x40, 0x40, 0x7F, 0x3F, 0xFF, 0xFF, 0x70, 0xD0, 0x88, 0x0C, 0x06, 0x03, 0x00, 0x0F, 0x0F, 0x00,
+    0x00, 0x01, 0x03, 0x06, 0x0C, 0x08, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x08,
+    0x08, 0x08, 0x08, 0x08, 0xFF, 0xFF, 0x0E, 0x78, 0xC0, 0x00, 0xE0, 0x38, 0x0F, 0xFF, 0xFF, 0x0F,
+    0x0F, 0x00, 0x00, 0x01, 0x03, 0x01, 0x00, 0x00, 0x0F, 0x0F, 0xFF, 0xFF, 0x0E, 0x38, 0xE0, 0xC0,
+    0x00, 0xFF, 0xFF, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x03, 0x0F, 0x0F, 0x0F, 0xF8, 0xFC, 0x06, 0x03,
+    0x03, 0x03, 0x03, 0x02, 0x0E, 0xFC, 0xF0, 0x01, 0x07, 0x0E, 0x0C, 0x08, 0x08, 0x08, 0x0C, 0x06,
+    0x03, 0x00, 0xFF, 0xFF, 0x43, 0x43, 0x43, 0x62, 0x7E, 0x18, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF8, 0xFC, 0x06, 0x03, 0x03, 0x03, 0x03, 0x02, 0x0E, 0xFC, 0xF0, 0x01, 0x07, 0x0E,
+    0x0C, 0x08, 0x08, 0x18, 0x3C, 0x26, 0x03, 0x00, 0xFF, 0xFF, 0x43, 0x43, 0x43, 0xE2, 0xBE, 0x18,
+    0x00, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x03, 0x0E, 0x08, 0x1C, 0x3E, 0x23, 0x63, 0x63, 0x63,
+    0xC3, 0x82, 0x0C, 0x0C, 0x08, 0x08, 0x08, 0x08, 0x0F, 0x07, 0x03, 0x03, 0x03, 0x03, 0xFF, 0xFF,
+    0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xFE, 0xFF, 0x03, 0x07, 0x0C, 0x08, 0x08, 0x08, 0x0C, 0x07, 0x03,
+    0x07, 0x1E, 0xF0, 0xC0, 0x00, 0x00, 0xC0, 0xF8, 0x1E, 0x07, 0x00, 0x00, 0x00, 0x07, 0x0E, 0x0E,
+    0x03, 0x00, 0x00, 0x00, 0x0F, 0xFC, 0xC0, 0x00, 0xC0, 0xFC, 0x0F, 0x0F, 0xF8, 0x80, 0x00, 0xE0,
+    0xFE, 0x0F, 0x00, 0x00, 0x0F, 0x0E, 0x0F, 0x00, 0x00, 0x00, 0x01, 0x0F, 0x0E, 0x0F, 0x00, 0x00,
+    0x00, 0x03, 0x06, 0x9C, 0xF0, 0xF0, 0x98, 0x0E, 0x03, 0x00, 0x08, 0x0C, 0x07, 0x01, 0x00, 0x00,
+    0x01, 0x07, 0x0C, 0x08, 0x01, 0x07, 0x0C, 0x38, 0xF0, 0xF0, 0x18, 0x0E, 0x03, 0x00, 0x00, 0x00,
+    0x00, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x03, 0x03, 0x83, 0xC3, 0x63, 0x33, 0x1F, 0x0F, 0x03, 0x0C,
+    0x0E, 0x0B, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0xFF, 0xFF, 0x01, 0x01, 0x3F, 0x3F, 0x20, 0x20,
+    0x01, 0x0F, 0xF8, 0x80, 0x00, 0x00, 0x00, 0x00, 0x07, 0x1C, 0x01, 0x01, 0xFF, 0x20, 0x20, 0x3F,
+    0x10, 0x18, 0x0C, 0x06, 0x03, 0x03, 0x06, 0x0C, 0x18, 0x10, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x03, 0x06, 0xF2, 0x93, 0x11, 0x19, 0x1B, 0xDF, 0xFE, 0x00, 0x01, 0x01, 0x01, 0x01,
+    0x00, 0x01, 0xFF, 0xFF, 0x18, 0x08, 0x08, 0x18, 0xF0, 0xC0, 0x0F, 0x0F, 0x08, 0x08, 0x08, 0x0C,
+    0x07, 0x03, 0x38, 0xFE, 0x82, 0x03, 0x01, 0x01, 0x03, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0xE0, 0xF0, 0x18, 0x08, 0x08, 0x18, 0xFF, 0xFF, 0x03, 0x07, 0x0C, 0x08, 0x08, 0x0C, 0x0F, 0x0F,
+    0x7C, 0xFE, 0x93, 0x11, 0x11, 0x13, 0x1E, 0x9C, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x08, 0xFC, 0xFF, 0x09, 0x09, 0x01, 0x00, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x7C, 0xFE, 0x83, 0x01,
+    0x01, 0x83, 0xFE, 0xFF, 0x00, 0x08, 0x09, 0x09, 0x09, 0x09, 0x0F, 0x03, 0xFF, 0xFF, 0x18, 0x08,
+    0x08, 0x18, 0xF0, 0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF1, 0xFB, 0x0F, 0x0F, 0x00, 0x00,
+    0xFB, 0xF1, 0x40, 0x40, 0x7F, 0x1F, 0xFF, 0xFF, 0xC0, 0x60, 0x30, 0x18, 0x08, 0x0F, 0x0F, 0x01,
+    0x03, 0x06, 0x0C, 0x08, 0xFF, 0xFF, 0x0F, 0x0F, 0xFF, 0xFE, 0x03, 0x01, 0x01, 0xFF, 0xFE, 0x02,
+    0x03, 0x01, 0x03, 0xFE, 0xFC, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x01, 0xFF, 0xFE, 0x03, 0x01, 0x01, 0x03, 0xFE, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x7C, 0xFE, 0x03, 0x01, 0x01, 0x83, 0xFE, 0x7C, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00,
+    0xFF, 0xFE, 0x03, 0x01, 0x01, 0x83, 0xFE, 0x78, 0x0F, 0x0F, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00,
+    0x7C, 0xFE, 0x83, 0x01, 0x01, 0x83, 0xFE, 0xFF, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x0F, 0x0F,
+    0xFF, 0xFE, 0x03, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x8E, 0x1B, 0x11, 0x11, 0x31, 0xE3,
+    0x40, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0xFF, 0xFF, 0x04, 0x04, 0x04, 0x01, 0x07, 0x04,
+    0x04, 0x04, 0x3E, 0xFF, 0x80, 0x00, 0x00, 0x80, 0xFE, 0xFF, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x0F, 0x3C, 0xE0, 0x80, 0xE0, 0x3C, 0x0F, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01,
+    0x00, 0x00, 0x0F, 0xF8, 0xC0, 0xF0, 0x1F, 0x07, 0x7C, 0xE0, 0xE0, 0x7E, 0x07, 0x00, 0x00, 0x01,
+    0x01, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x83, 0xEE, 0x38, 0x38, 0xEE, 0x83, 0x01,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x07, 0x3C, 0xE0, 0xC0, 0xF0, 0x3C, 0x07, 0x08,
+    0x08, 0x0E, 0x07, 0x00, 0x00, 0x00, 0x81, 0xC3, 0x63, 0x33, 0x0F, 0x07, 0x03, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x80, 0xC0, 0xFE, 0x03, 0x01, 0x01, 0x00, 0x00, 0x3F, 0x30, 0x60, 0x00,
+    0xFF, 0xFF, 0x01, 0x01, 0x7F, 0xFC, 0xC0, 0x80, 0x60, 0x60, 0x3F, 0x1F, 0x00, 0x00, 0x02, 0x01,
+    0x01, 0x01, 0x03, 0x03, 0x02, 0x02, 0x02, 0x01,
+};
+
+static const ssd1306_glyph_t ssd1306_font_sans16_glyphs[] = {
+    {     0,  0,  0,   0,   0,  5 },   // space
+    {     0,  2, 12,   3,   3,  6 },   // !
+    {     4,  4,  5,   2,   3,  7 },   // "
+    {     8, 11, 12,   2,   3, 13 },   // #
+    {    30,  7, 14,   2,   3, 10 },   // $
+    {    44, 13, 12,   1,   3, 15 },   // %
+    {    70, 10, 12,   1,   3, 12 },   // &
+    {    90,  1,  5,   2,   3,  4 },   // '
+    {    91,  3, 14,   2,   3,  6 },   // (
+    {    97,  3, 14,   2,   3,  6 },   // )
+    {   103,  7,  8,   1,   3,  8 },   // *
+    {   110, 10, 10,   2,   5, 13 },   // +
+    {   130,  2,  4,   2,  13,  5 },   // ,
+    {   132,  4,  1,   1,  10,  6 },   // -
+    {   136,  2,  2,   2,  13,  5 },   // .
+    {   138,  5, 14,   0,   3,  5 },   // /
+    {   148,  8, 12,   1,   3, 10 },   // 0
+    {   164,  7, 12,   2,   3, 10 },   // 1
+    {   178,  7, 12,   2,   3, 10 },   // 2
+    {   192,  8, 12,   2,   3, 10 },   // 3
+    {   208,  9, 12,   1,   3, 10 },   // 4
+    {   226,  7, 12,   2,   3, 10 },   // 5
+    {   240,  8, 12,   2,   3, 10 },   // 6
+    {   256,  7, 12,   2,   3, 10 },   // 7
+    {   270,  8, 12,   1,   3, 10 },   // 8
+    {   286,  8, 12,   1,   3, 10 },   // 9
+    {   302,  2,  8,   2,   7,  5 },   // :
+    {   304,  2, 10,   2,   7,  5 },   // ;
+    {   308, 10,  8,   2,   6, 13 },   // <
+    {   318, 10,  4,   2,   8, 13 },   // =
+    {   328, 10,  8,   2,   6, 13 },   // >
+    {   338,  6, 12,   1,   3,  8 },   // ?
+    {   350, 14, 14,   2,   4, 16 },   // @
+    {   378, 10, 12,   1,   3, 11 },   // A
+    {   398,  8, 12,   2,   3, 11 },   // B
+    {   414,  9, 12,   1,   3, 11 },   // C
+    {   432, 10, 12,   2,   3, 12 },   // D
+    {   452,  8, 12,   2,   3, 10 },   // E
+    {   468,  7, 12,   2,   3,  9 },   // F
+    {   482, 10, 12,   1,   3, 12 },   // G
+    {   502,  9, 12,   2,   3, 12 },   // H
+    {   520,  2, 12,   2,   3,  5 },   // I
+    {   524,  4, 15,   0,   3,  5 },   // J
+    {   532,  9, 12,   2,   3, 10 },   // K
+    {   550,  7, 12,   2,   3,  9 },   // L
+    {   564, 11, 12,   2,   3, 14 },   // M
+    {   586,  9, 12,   2,   3, 12 },   // N
+    {   604, 11, 12,   1,   3, 13 },   // O
+    {   626,  8, 12,   2,   3, 10 },   // P
+    {   642, 11, 14,   1,   3, 13 },   // Q
+    {   664,  9, 12,   2,   3, 11 },   // R
+    {   682,  8, 12,   1,   3, 10 },   // S
+    {   698, 10, 12,   0,   3, 10 },   // T
+    {   718,  9, 12,   2,   3, 12 },   // U
+    {   736, 10, 12,   1,   3, 11 },   // V
+    {   756, 14, 12,   1,   3, 16 },   // W
+    {   784, 10, 12,   1,   3, 11 },   // X
+    {   804,  9, 12,   0,   3, 10 },   // Y
+    {   822,  9, 12,   1,   3, 11 },   // Z
+    {   840,  4, 14,   1,   3,  6 },   // [
+    {   848,  5, 13,   0,   3,  5 },   // 0x5C
+    {   858,  3, 14,   2,   3,  6 },   // ]
+    {   864, 10,  5,   2,   3, 13 },   // ^
+    {   874,  8,  1,   0,  18,  8 },   // _
+    {   882,  2,  3,   3,   2,  8 },   // `
+    {   884,  7,  9,   2,   6, 10 },   // a
+    {   898,  8, 12,   2,   3, 10 },   // b
+    {   914,  7,  9,   1,   6,  9 },   // c
+    {   928,  8, 12,   1,   3, 10 },   // d
+    {   944,  8,  9,   1,   6, 10 },   // e
+    {   960,  6, 12,   1,   3,  6 },   // f
+    {   972,  8, 12,   1,   6, 10 },   // g
+    {   988,  7, 12,   2,   3, 10 },   // h
+    {  1002,  2, 12,   1,   3,  4 },   // i
+    {  1006,  4, 15,   0,   3,  4 },   // j
+    {  1014,  7, 12,   2,   3,  9 },   // k
+    {  1028,  2, 12,   1,   3,  4 },   // l
+    {  1032, 13,  9,   2,   6, 16 },   // m
+    {  1058,  7,  9,   2,   6, 10 },   // n
+    {  1072,  8,  9,   1,   6, 10 },   // o
+    {  1088,  8, 12,   2,   6, 10 },   // p
+    {  1104,  8, 12,   1,   6, 10 },   // q
+    {  1120,  5,  9,   2,   6,  7 },   // r
+    {  1130,  7,  9,   1,   6,  8 },   // s
+    {  1144,  5, 11,   1,   4,  6 },   // t
+    {  1154,  8,  9,   1,   6, 10 },   // u
+    {  1170,  8,  9,   1,   6,  9 },   // v
+    {  1186, 11,  9,   2,   6, 13 },   // w
+    {  1208,  8,  9,   1,   6,  9 },   // x
+    {  1224,  7, 12,   2,   6,  9 },   // y
+    {  1238,  7,  9,   1,   6,  8 },   // z
+    {  1252,  6, 15,   3,   3, 10 },   // {
+    {  1264,  1, 16,   2,   3,  5 },   // |
+    {  1266,  6, 15,   3,   3, 10 },   // }
+    {  1278, 10,  2,   2,   9, 13 },   // ~
+};
+
+const ssd1306_font_t ssd1306_font_sans16 = {
+    .bitmaps = ssd1306_font_sans16_bitmaps,
+    .glyphs = ssd1306_font_sans16_glyphs,
+    .first = 32,
+    .last = 126,
+    .height = 19,
+    .baseline = 15,
+};
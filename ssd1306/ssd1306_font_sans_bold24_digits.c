@@ -0,0 +1,101 @@
+/**
+ * @file ssd1306_font_sans_bold24_digits.c
+ * @brief ssd1306_font_sans_bold24_digits: DejaVuSans-Bold.ttf at 24 px, characters 32-58, 28 px line.
+ * 
+ * Generated by host/font2c.py; 797 bytes of glyph bitmaps.
+ * DejaVu fonts: Bitstream Vera license, see https://dejavu-fonts.github.io/License.html
+ */
+
+#include "ssd1306.h"
+
+static const uint8_t ssd1306_font_sans_bold24_digits_bitmaps[] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xCF, 0xCF, 0xCF, 0xCF, 0x03, 0x03, 0x03, 0x03, 0x7F, 0x7F, 0x7E, 0x00,
+    0x00, 0x7E, 0x7F, 0x7F, 0x00, 0x70, 0x70, 0x70, 0xF0, 0xF8, 0xFF, 0x7F, 0x73, 0x70, 0xF0, 0xFC,
+    0xFF, 0x7F, 0x70, 0x70, 0x70, 0x1C, 0x1C, 0x9C, 0xFC, 0xFF, 0x3F, 0x1D, 0x1C, 0xDC, 0xFC, 0xFF,
+    0x1F, 0x1C, 0x1C, 0x1C, 0x0C, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0xF8, 0xF8, 0xB8, 0x1C, 0xFF, 0xFF, 0x1C, 0x18,
+    0x38, 0x38, 0x38, 0x00, 0xC3, 0x87, 0x87, 0x87, 0x8F, 0xFF, 0xFF, 0x8F, 0x8E, 0xFE, 0xFE, 0xFC,
+    0x78, 0x01, 0x03, 0x03, 0x03, 0x03, 0x1F, 0x3F, 0x03, 0x03, 0x03, 0x01, 0x01, 0x00, 0xFC, 0xFE,
+    0xFE, 0x87, 0x03, 0x87, 0xFE, 0xFE, 0xFC, 0x00, 0x00, 0xC0, 0xE0, 0x78, 0x3E, 0x0F, 0x03, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x03, 0x03, 0x03, 0x81, 0xE1, 0xF8, 0x3C, 0x0F, 0x07,
+    0x01, 0xF8, 0xFC, 0xFE, 0x06, 0x06, 0x06, 0xFE, 0xFC, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+    0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01,
+    0x00, 0x00, 0x00, 0xFC, 0xFE, 0xFE, 0xFF, 0xC7, 0x87, 0x07, 0x07, 0x0F, 0x0E, 0x00, 0x00, 0x80,
+    0x80, 0x00, 0x38, 0xFE, 0xFF, 0xFF, 0xE7, 0x83, 0x83, 0x87, 0x8F, 0x9F, 0xFE, 0xFC, 0xF8, 0xF8,
+    0xFF, 0xBF, 0x1F, 0x03, 0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01,
+    0x01, 0x03, 0x03, 0x03, 0x03, 0x02, 0x7E, 0x7F, 0x7F, 0xC0, 0xF8, 0xFE, 0xFF, 0x3F, 0x07, 0x00,
+    0x7F, 0xFF, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0x00, 0x03, 0x0F, 0x1F, 0x1F, 0x1C, 0x10, 0x01, 0x07,
+    0x3F, 0xFF, 0xFE, 0xF8, 0xC0, 0x00, 0x00, 0x80, 0xFF, 0xFF, 0xFF, 0x7F, 0x10, 0x1C, 0x1F, 0x1F,
+    0x0F, 0x03, 0x00, 0x08, 0x8C, 0x98, 0xD8, 0xF0, 0xFF, 0xFF, 0xF0, 0xF8, 0x98, 0x8C, 0x08, 0x00,
+    0x01, 0x01, 0x00, 0x00, 0x07, 0x07, 0x00, 0x00, 0x01, 0x01, 0x01, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+    0xC0, 0xFF, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x7F, 0x7F, 0x7F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xC0, 0xFF, 0xFF, 0x7F, 0x1F, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x06, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x1F, 0x1F, 0x1F, 0x1F, 0x00,
+    0x00, 0x00, 0x00, 0x80, 0xF8, 0xFE, 0x1F, 0x03, 0x00, 0x00, 0xE0, 0xFC, 0x7F, 0x0F, 0x01, 0x00,
+    0x00, 0x08, 0x0F, 0x0F, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xF0, 0xFC, 0xFE, 0xFE, 0x1F,
+    0x0F, 0x07, 0x0F, 0x0F, 0xFE, 0xFE, 0xFC, 0xF8, 0xC0, 0x0F, 0x7F, 0xFF, 0xFF, 0xFF, 0xC0, 0x80,
+    0x80, 0x80, 0xC0, 0xFF, 0xFF, 0xFF, 0x7F, 0x1F, 0x00, 0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x01, 0x00, 0x00, 0x00, 0x0E, 0x0E, 0x0E, 0x0E, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+    0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xFF, 0xFF, 0xFF, 0x80, 0x80, 0x80, 0x80, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x1E, 0x0E, 0x0F, 0x0F, 0x07,
+    0x07, 0x0F, 0x1F, 0xFF, 0xFE, 0xFE, 0xFC, 0x20, 0xC0, 0xE0, 0xF0, 0xF8, 0xF8, 0xBC, 0x9E, 0x8F,
+    0x8F, 0x87, 0x83, 0x81, 0x80, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x00, 0x0E, 0x0F, 0x87, 0x87, 0x87, 0x87, 0x8F, 0xFF, 0xFE, 0xFE, 0xFC, 0x78, 0xC0,
+    0x80, 0x80, 0x87, 0x87, 0x87, 0x87, 0x87, 0xCF, 0xFF, 0xFE, 0xFE, 0xFC, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x80, 0xC0, 0xF0, 0xF8, 0x3E,
+    0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x7C, 0x7E, 0x7F, 0x7F, 0x79, 0x78, 0x78, 0x78,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x78, 0x78, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+    0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xCF, 0xCF, 0xCF, 0xCF, 0x8F,
+    0x8F, 0x0F, 0x00, 0x00, 0xC0, 0xC3, 0x83, 0x83, 0x81, 0x81, 0x81, 0x83, 0xC7, 0xFF, 0xFF, 0xFF,
+    0xFE, 0x18, 0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x01, 0x00, 0x00,
+    0x80, 0xF0, 0xF8, 0xFC, 0xFE, 0x9E, 0x8F, 0xC7, 0xC7, 0x87, 0x87, 0x8E, 0x0E, 0x00, 0x1F, 0x7F,
+    0xFF, 0xFF, 0xFF, 0xC7, 0x83, 0x81, 0x83, 0xC7, 0xFF, 0xFF, 0xFF, 0x7E, 0x00, 0x00, 0x00, 0x01,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x00, 0x00, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F,
+    0x0F, 0xCF, 0xFF, 0xFF, 0xFF, 0x7F, 0x1F, 0x00, 0x00, 0x00, 0x80, 0xE0, 0xFC, 0xFF, 0xFF, 0x3F,
+    0x07, 0x01, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x03, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x78, 0xFC, 0xFE, 0xFE, 0xDF, 0x87, 0x87, 0x87, 0xCF, 0xFF, 0xFE, 0xFE, 0x7C, 0x00, 0xFC,
+    0xFE, 0xFE, 0xFF, 0x87, 0x83, 0x83, 0x83, 0x87, 0xFF, 0xFF, 0xFE, 0xFC, 0x30, 0x00, 0x01, 0x03,
+    0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x00, 0x00, 0xF0, 0xFC, 0xFE, 0xFE, 0x9F,
+    0x07, 0x07, 0x07, 0x0F, 0xFE, 0xFE, 0xFC, 0xF8, 0xE0, 0x01, 0x83, 0x87, 0x8F, 0x8F, 0x8E, 0x8E,
+    0x8E, 0xCF, 0xFF, 0xFF, 0xFF, 0x7F, 0x1F, 0x00, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+    0x03, 0x01, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+};
+
+static const ssd1306_glyph_t ssd1306_font_sans_bold24_digits_glyphs[] = {
+    {     0,  0,  0,   0,   0,  8 },   // space
+    {     0,  4, 18,   4,   4, 11 },   // !
+    {    12,  8,  7,   3,   4, 13 },   // "
+    {    20, 17, 17,   2,   5, 20 },   // #
+    {    71, 13, 22,   3,   4, 17 },   // $
+    {   110, 22, 18,   1,   4, 24 },   // %
+    {   176, 18, 18,   2,   4, 21 },   // &
+    {   230,  3,  7,   2,   4,  7 },   // '
+    {   233,  7, 21,   3,   4, 11 },   // (
+    {   254,  7, 21,   2,   4, 11 },   // )
+    {   275, 12, 11,   1,   4, 13 },   // *
+    {   299, 15, 15,   3,   7, 20 },   // +
+    {   329,  5,  9,   2,  17,  9 },   // ,
+    {   339,  8,  4,   1,  13, 10 },   // -
+    {   347,  4,  5,   3,  17,  9 },   // .
+    {   351,  9, 20,   0,   4,  9 },   // /
+    {   378, 15, 18,   1,   4, 17 },   // 0
+    {   423, 12, 18,   3,   4, 17 },   // 1
+    {   459, 13, 18,   2,   4, 17 },   // 2
+    {   498, 13, 18,   2,   4, 17 },   // 3
+    {   537, 15, 18,   1,   4, 17 },   // 4
+    {   582, 14, 18,   2,   4, 17 },   // 5
+    {   624, 14, 18,   2,   4, 17 },   // 6
+    {   666, 13, 18,   2,   4, 17 },   // 7
+    {   705, 14, 18,   2,   4, 17 },   // 8
+    {   747, 14, 18,   2,   4, 17 },   // 9
+    {   789,  4, 13,   3,   9, 10 },   // :
+};
+
+const ssd1306_font_t ssd1306_font_sans_bold24_digits = {
+    .bitmaps = ssd1306_font_sans_bold24_digits_bitmaps,
+    .glyphs = ssd1306_font_sans_bold24_digits_glyphs,
+    .first = 32,
+    .last = 58,
+    .height = 28,
+    .baseline = 22,
+};
@@ -0,0 +1,122 @@
+/**
+ * @file ssd1306_fonts.c
+ * @author Abdulaziz Alrashidi
+ * @brief Font descriptor for the built-in font5x7 table.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ * 
+ * @details
+ * The 5-byte glyphs of font5x7 already are in page layout, so describing the table as an
+ * ssd1306_font_t costs only the glyph table. Generated fonts live in their own ssd1306_font_*.c files.
+ */
+
+#include "ssd1306.h"
+
+static const ssd1306_glyph_t font5x7_glyphs[] = {
+    {   0, 5, 8, 0, 0, 6 },   // space
+    {   5, 5, 8, 0, 0, 6 },   // !
+    {  10, 5, 8, 0, 0, 6 },   // "
+    {  15, 5, 8, 0, 0, 6 },   // #
+    {  20, 5, 8, 0, 0, 6 },   // $
+    {  25, 5, 8, 0, 0, 6 },   // %
+    {  30, 5, 8, 0, 0, 6 },   // &
+    {  35, 5, 8, 0, 0, 6 },   // '
+    {  40, 5, 8, 0, 0, 6 },   // (
+    {  45, 5, 8, 0, 0, 6 },   // )
+    {  50, 5, 8, 0, 0, 6 },   // *
+    {  55, 5, 8, 0, 0, 6 },   // +
+    {  60, 5, 8, 0, 0, 6 },   // ,
+    {  65, 5, 8, 0, 0, 6 },   // -
+    {  70, 5, 8, 0, 0, 6 },   // .
+    {  75, 5, 8, 0, 0, 6 },   // /
+    {  80, 5, 8, 0, 0, 6 },   // 0
+    {  85, 5, 8, 0, 0, 6 },   // 1
+    {  90, 5, 8, 0, 0, 6 },   // 2
+    {  95, 5, 8, 0, 0, 6 },   // 3
+    { 100, 5, 8, 0, 0, 6 },   // 4
+    { 105, 5, 8, 0, 0, 6 },   // 5
+    { 110, 5, 8, 0, 0, 6 },   // 6
+    { 115, 5, 8, 0, 0, 6 },   // 7
+    { 120, 5, 8, 0, 0, 6 },   // 8
+    { 125, 5, 8, 0, 0, 6 },   // 9
+    { 130, 5, 8, 0, 0, 6 },   // :
+    { 135, 5, 8, 0, 0, 6 },   // ;
+    { 140, 5, 8, 0, 0, 6 },   // <
+    { 145, 5, 8, 0, 0, 6 },   // =
+    { 150, 5, 8, 0, 0, 6 },   // >
+    { 155, 5, 8, 0, 0, 6 },   // ?
+    { 160, 5, 8, 0, 0, 6 },   // @
+    { 165, 5, 8, 0, 0, 6 },   // A
+    { 170, 5, 8, 0, 0, 6 },   // B
+    { 175, 5, 8, 0, 0, 6 },   // C
+    { 180, 5, 8, 0, 0, 6 },   // D
+    { 185, 5, 8, 0, 0, 6 },   // E
+    { 190, 5, 8, 0, 0, 6 },   // F
+    { 195, 5, 8, 0, 0, 6 },   // G
+    { 200, 5, 8, 0, 0, 6 },   // H
+    { 205, 5, 8, 0, 0, 6 },   // I
+    { 210, 5, 8, 0, 0, 6 },   // J
+    { 215, 5, 8, 0, 0, 6 },   // K
+    { 220, 5, 8, 0, 0, 6 },   // L
+    { 225, 5, 8, 0, 0, 6 },   // M
+    { 230, 5, 8, 0, 0, 6 },   // N
+    { 235, 5, 8, 0, 0, 6 },   // O
+    { 240, 5, 8, 0, 0, 6 },   // P
+    { 245, 5, 8, 0, 0, 6 },   // Q
+    { 250, 5, 8, 0, 0, 6 },   // R
+    { 255, 5, 8, 0, 0, 6 },   // S
+    { 260, 5, 8, 0, 0, 6 },   // T
+    { 265, 5, 8, 0, 0, 6 },   // U
+    { 270, 5, 8, 0, 0, 6 },   // V
+    { 275, 5, 8, 0, 0, 6 },   // W
+    { 280, 5, 8, 0, 0, 6 },   // X
+    { 285, 5, 8, 0, 0, 6 },   // Y
+    { 290, 5, 8, 0, 0, 6 },   // Z
+    { 295, 5, 8, 0, 0, 6 },   // [
+    { 300, 5, 8, 0, 0, 6 },   // 0x5C
+    { 305, 5, 8, 0, 0, 6 },   // ]
+    { 310, 5, 8, 0, 0, 6 },   // ^
+    { 315, 5, 8, 0, 0, 6 },   // _
+    { 320, 5, 8, 0, 0, 6 },   // `
+    { 325, 5, 8, 0, 0, 6 },   // a
+    { 330, 5, 8, 0, 0, 6 },   // b
+    { 335, 5, 8, 0, 0, 6 },   // c
+    { 340, 5, 8, 0, 0, 6 },   // d
+    { 345, 5, 8, 0, 0, 6 },   // e
+    { 350, 5, 8, 0, 0, 6 },   // f
+    { 355, 5, 8, 0, 0, 6 },   // g
+    { 360, 5, 8, 0, 0, 6 },   // h
+    { 365, 5, 8, 0, 0, 6 },   // i
+    { 370, 5, 8, 0, 0, 6 },   // j
+    { 375, 5, 8, 0, 0, 6 },   // k
+    { 380, 5, 8, 0, 0, 6 },   // l
+    { 385, 5, 8, 0, 0, 6 },   // m
+    { 390, 5, 8, 0, 0, 6 },   // n
+    { 395, 5, 8, 0, 0, 6 },   // o
+    { 400, 5, 8, 0, 0, 6 },   // p
+    { 405, 5, 8, 0, 0, 6 },   // q
+    { 410, 5, 8, 0, 0, 6 },   // r
+    { 415, 5, 8, 0, 0, 6 },   // s
+    { 420, 5, 8, 0, 0, 6 },   // t
+    { 425, 5, 8, 0, 0, 6 },   // u
+    { 430, 5, 8, 0, 0, 6 },   // v
+    { 435, 5, 8, 0, 0, 6 },   // w
+    { 440, 5, 8, 0, 0, 6 },   // x
+    { 445, 5, 8, 0, 0, 6 },   // y
+    { 450, 5, 8, 0, 0, 6 },   // z
+    { 455, 5, 8, 0, 0, 6 },   // {
+    { 460, 5, 8, 0, 0, 6 },   // |
+    { 465, 5, 8, 0, 0, 6 },   // }
+    { 470, 5, 8, 0, 0, 6 },   // ~
+};
+
+const ssd1306_font_t ssd1306_font_5x7 = {
+    .bitmaps = (const uint8_t*)font5x7,
+    .glyphs = font5x7_glyphs,
+    .first = 32,
+    .last = 126,
+    .height = 8,
+    .baseline = 7,
+};
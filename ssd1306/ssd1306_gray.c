@@ -0,0 +1,234 @@
+/**
+ * @file ssd1306_gray.c
+ * @author Abdulaziz Alrashidi
+ * @brief 4-level grayscale for the SSD1306 driver: two bit planes shown in turn at a steady field rate.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ *
+ * @details
+ * The high plane is the panel's framebuffer and the low plane a second buffer of the same size;
+ * showing a plane means pointing the framebuffer at it, marking the panel dirty and flushing. With
+ * the diff shadow holding what GDDRAM shows, a flush sends only the bytes the two planes disagree on,
+ * addressed the cheapest way, and nothing at all when the same plane is shown twice in a row.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+
+#include "ssd1306.h"
+#include "ssd1306_gray.h"
+
+#define SSD1306_GRAY_TASK_STACK     2048
+
+// Plane shown in each field of a frame: the high plane carries twice the weight of the low one
+static const uint8_t gray_sequence[SSD1306_GRAY_FIELDS] = { 1, 1, 0 };
+
+static void ssd1306_gray_show(ssd1306_gray_t* gray, uint8_t plane)
+{
+    ssd1306_t* dev = gray->dev;
+
+    dev->buffer = gray->planes[plane];
+    ssd1306_dev_mark_dirty(dev, 0, 0, dev->width, dev->height);
+    ssd1306_dev_display(dev);
+}
+
+// Sends the display clock and pre-charge period, keeping the panel's record of them current
+static void ssd1306_gray_set_timing(ssd1306_t* dev, uint8_t clock, uint8_t precharge)
+{
+    const uint8_t cmds[] = {
+        0xD5, clock,        // Set display clock divide ratio/oscillator frequency
+        0xD9, precharge     // Pre-charge period
+    };
+
+    ssd1306_dev_cmd_list(dev, cmds, sizeof(cmds));
+    dev->clock = clock;
+    dev->precharge = precharge;
+}
+
+static void ssd1306_gray_task(void* arg)
+{
+    ssd1306_gray_t* gray = arg;
+    ssd1306_gray_stats_t* stats = &gray->stats;
+    TickType_t slot = xTaskGetTickCount();
+
+    while (gray->running) {
+        vTaskDelayUntil(&slot, gray->period);
+
+        // A late field drops the slots that passed; the sequence follows the slots, not the fields sent
+        uint32_t behind = (TickType_t)(xTaskGetTickCount() - slot) / gray->period;
+        slot += behind * gray->period;
+        gray->field = (gray->field + behind) % SSD1306_GRAY_FIELDS;
+
+        xSemaphoreTake(gray->lock, portMAX_DELAY);
+        int64_t flush_start = esp_timer_get_time();
+        ssd1306_gray_show(gray, gray_sequence[gray->field]);
+        int64_t end = esp_timer_get_time();
+
+        uint32_t us = end - flush_start;
+        stats->fields++;
+        stats->missed_fields += behind;
+        stats->flush_us_last = us;
+        if (us > stats->flush_us_max) stats->flush_us_max = us;
+        stats->flush_us_total += us;
+
+        gray->window_fields++;
+        if (end - gray->window_start_us >= 1000000) {
+            stats->field_rate = (uint64_t)gray->window_fields * 1000000 / (end - gray->window_start_us);
+            gray->window_start_us = end;
+            gray->window_fields = 0;
+        }
+        xSemaphoreGive(gray->lock);
+
+        gray->field = (gray->field + 1) % SSD1306_GRAY_FIELDS;
+    }
+
+    xSemaphoreGive(gray->stopped);
+    vTaskDelete(NULL);
+}
+
+static void ssd1306_gray_free(ssd1306_gray_t* gray)
+{
+    free(gray->planes[0]);
+    if (gray->lock) vSemaphoreDelete(gray->lock);
+    if (gray->stopped) vSemaphoreDelete(gray->stopped);
+    gray->planes[0] = NULL;
+}
+
+esp_err_t ssd1306_gray_start(ssd1306_gray_t* gray, ssd1306_t* dev, const ssd1306_gray_config_t* config)
+{
+    if (!config->field_rate) return ESP_ERR_INVALID_ARG;
+    if (ssd1306_dev_is_scrolling(dev)) return ESP_ERR_INVALID_STATE;
+
+    memset(gray, 0, sizeof(*gray));
+    gray->dev = dev;
+    gray->period = configTICK_RATE_HZ / config->field_rate;
+    if (!gray->period) gray->period = 1;
+    gray->planes[0] = malloc(dev->buffer_size);
+    gray->lock = xSemaphoreCreateMutex();
+    gray->stopped = xSemaphoreCreateBinary();
+    if (!gray->planes[0] || !gray->lock || !gray->stopped) {
+        ssd1306_gray_free(gray);
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Both planes start as the framebuffer: what it shows becomes level 3
+    gray->planes[1] = dev->buffer;
+    memcpy(gray->planes[0], dev->buffer, dev->buffer_size);
+
+    gray->own_shadow = !dev->shadow;
+    if (ssd1306_dev_diff_flush_start(dev) != ESP_OK) {
+        ssd1306_gray_free(gray);
+        return ESP_ERR_NO_MEM;
+    }
+
+    gray->saved_clock = dev->clock;
+    gray->saved_precharge = dev->precharge;
+    gray->window_start_us = esp_timer_get_time();
+    gray->running = true;
+
+    // The lock keeps the first field back until the new timing is on the panel
+    xSemaphoreTake(gray->lock, portMAX_DELAY);
+    if (xTaskCreate(ssd1306_gray_task, "ssd1306_gray", SSD1306_GRAY_TASK_STACK, gray, config->priority, NULL) != pdPASS) {
+        xSemaphoreGive(gray->lock);
+        gray->running = false;
+        if (gray->own_shadow) ssd1306_dev_diff_flush_stop(dev);
+        ssd1306_gray_free(gray);
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (config->clock || config->precharge) {
+        ssd1306_gray_set_timing(dev, config->clock ? config->clock : dev->clock,
+                                config->precharge ? config->precharge : dev->precharge);
+    }
+    xSemaphoreGive(gray->lock);
+    return ESP_OK;
+}
+
+void ssd1306_gray_stop(ssd1306_gray_t* gray)
+{
+    ssd1306_t* dev = gray->dev;
+
+    gray->running = false;
+    xSemaphoreTake(gray->stopped, portMAX_DELAY);
+
+    // Back to 1bpp with the high plane, and the panel timing from before the mode
+    if (dev->clock != gray->saved_clock || dev->precharge != gray->saved_precharge) {
+        ssd1306_gray_set_timing(dev, gray->saved_clock, gray->saved_precharge);
+    }
+    ssd1306_gray_show(gray, 1);
+    if (gray->own_shadow) ssd1306_dev_diff_flush_stop(dev);
+
+    ssd1306_gray_free(gray);
+}
+
+void ssd1306_gray_draw(ssd1306_gray_t* gray, uint8_t level, ssd1306_gray_draw_cb_t draw, void* arg)
+{
+    ssd1306_t* dev = gray->dev;
+
+    xSemaphoreTake(gray->lock, portMAX_DELAY);
+    uint8_t* shown = dev->buffer;
+
+    for (uint8_t plane = 0; plane < 2; plane++) {
+        dev->buffer = gray->planes[plane];
+        draw(dev, arg, (level >> plane) & 1 ? COLOR_WHITE : COLOR_BLACK);
+    }
+
+    // The loop marks the whole panel dirty per field; spans marked here carry nothing
+    dev->buffer = shown;
+    xSemaphoreGive(gray->lock);
+}
+
+typedef struct {
+    uint8_t x, y, w, h;
+    uint8_t size_x, size_y;
+    const char* str;
+} ssd1306_gray_shape_t;
+
+static void ssd1306_gray_string_cb(ssd1306_t* dev, void* arg, ssd1306_draw_mode_t color)
+{
+    const ssd1306_gray_shape_t* shape = arg;
+    ssd1306_dev_draw_string(dev, shape->x, shape->y, shape->str, shape->size_x, shape->size_y, color);
+}
+
+static void ssd1306_gray_rect_cb(ssd1306_t* dev, void* arg, ssd1306_draw_mode_t color)
+{
+    const ssd1306_gray_shape_t* shape = arg;
+    ssd1306_dev_draw_full_rect(dev, shape->x, shape->y, shape->w, shape->h, color);
+}
+
+void ssd1306_gray_draw_string(ssd1306_gray_t* gray, uint8_t x, uint8_t y, const char* str, uint8_t size_x, uint8_t size_y, uint8_t level)
+{
+    ssd1306_gray_shape_t shape = { .x = x, .y = y, .size_x = size_x, .size_y = size_y, .str = str };
+    ssd1306_gray_draw(gray, level, ssd1306_gray_string_cb, &shape);
+}
+
+void ssd1306_gray_fill_rect(ssd1306_gray_t* gray, uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t level)
+{
+    ssd1306_gray_shape_t shape = { .x = x, .y = y, .w = w, .h = h };
+    ssd1306_gray_draw(gray, level, ssd1306_gray_rect_cb, &shape);
+}
+
+void ssd1306_gray_stats_get(ssd1306_gray_t* gray, ssd1306_gray_stats_t* out)
+{
+    xSemaphoreTake(gray->lock, portMAX_DELAY);
+    *out = gray->stats;
+    xSemaphoreGive(gray->lock);
+
+    out->frame_rate = out->field_rate / SSD1306_GRAY_FIELDS;
+    if (out->fields) out->flush_us_avg = out->flush_us_total / out->fields;
+}
+
+void ssd1306_gray_stats_reset(ssd1306_gray_t* gray)
+{
+    xSemaphoreTake(gray->lock, portMAX_DELAY);
+    memset(&gray->stats, 0, sizeof(gray->stats));
+    gray->window_start_us = esp_timer_get_time();
+    gray->window_fields = 0;
+    xSemaphoreGive(gray->lock);
+}
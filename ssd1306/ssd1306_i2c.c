@@ -0,0 +1,151 @@
+/**
+ * @file ssd1306_i2c.c
+ * @author Abdulaziz Alrashidi
+ * @brief ESP8266 I2C transport for the SSD1306 driver.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ * 
+ * @details
+ * Everything that talks to the ESP8266 i2c_master_* API lives here, so that ssd1306.c itself
+ * only sees the ssd1306_transport_t interface and also builds on a host (see host/).
+ * 
+ * Building an i2c command link costs one heap allocation per appended command, and the SDK has no
+ * static variant. i2c_master_write() records a pointer to the bytes rather than a copy, and
+ * i2c_master_cmd_begin() reads them when it runs, so a link built once can be run again with new
+ * bytes behind that pointer as long as the transaction keeps its length. Transactions are therefore
+ * served from a small pool of links, keyed by (address, length), that all write from one static
+ * staging buffer: the prefix and payload are copied there before the link runs, and every write
+ * stays a single transaction. The shapes a display loop produces repeat from frame to frame, so
+ * once it has run a few frames no transaction touches the heap.
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "ssd1306.h"
+
+#define SSD1306_I2C_LINK_POOL   CONFIG_SSD1306_I2C_LINK_POOL    // cached command links, one per transaction shape
+#define SSD1306_I2C_PREFIX_MAX  33      // control and command bytes, as built by ssd1306_write_cmd_data()
+#define SSD1306_I2C_STAGING     (SSD1306_I2C_PREFIX_MAX + SSD1306_MAX_PAGES * SSD1306_MAX_WIDTH)   // largest pooled write: a full frame behind its prefix
+#define SSD1306_I2C_TIMEOUT     (CONFIG_SSD1306_I2C_TIMEOUT_MS / portTICK_RATE_MS)
+
+#ifdef CONFIG_SSD1306_I2C_PULLUPS
+#define SSD1306_I2C_PULLUP      1
+#else
+#define SSD1306_I2C_PULLUP      0       // external pull-ups
+#endif
+
+typedef struct {
+    i2c_cmd_handle_t link;              // NULL while the slot is unused
+    uint32_t last_use;                  // for least-recently-used eviction
+    uint16_t len;                       // prefix and payload bytes the link writes from staging
+    uint8_t address;
+} ssd1306_i2c_link_t;
+
+static ssd1306_i2c_link_t link_pool[SSD1306_I2C_LINK_POOL];
+static uint8_t staging[SSD1306_I2C_STAGING];
+static uint32_t link_clock;
+static uint32_t link_allocs;
+static SemaphoreHandle_t link_lock;
+
+esp_err_t i2c_init(void)
+{
+    int i2c_port = I2C_NUM;
+
+    i2c_config_t conf = {
+        .mode = I2C_MODE_MASTER,
+        .scl_io_num = I2C_SCL_IO,
+        .scl_pullup_en = SSD1306_I2C_PULLUP,
+        .sda_io_num = I2C_SDA_IO,
+        .sda_pullup_en = SSD1306_I2C_PULLUP,
+        .clk_stretch_tick = CONFIG_SSD1306_I2C_CLK_STRETCH_TICK
+    };
+
+    ESP_ERROR_CHECK(i2c_driver_install(i2c_port, conf.mode));
+    ESP_ERROR_CHECK(i2c_param_config(i2c_port, &conf));
+
+    return ESP_OK;
+}
+
+static esp_err_t ssd1306_i2c_bus_init(void* ctx)
+{
+    (void)ctx;
+    link_lock = xSemaphoreCreateMutex();
+    if (!link_lock) return ESP_ERR_NO_MEM;
+    return i2c_init();
+}
+
+// Finds the link built for this transaction shape, or rebuilds the least recently used one
+static ssd1306_i2c_link_t* ssd1306_i2c_get_link(uint8_t address, size_t len)
+{
+    ssd1306_i2c_link_t* victim = &link_pool[0];
+
+    for (int i = 0; i < SSD1306_I2C_LINK_POOL; i++) {
+        ssd1306_i2c_link_t* slot = &link_pool[i];
+        if (slot->link && slot->address == address && slot->len == len) return slot;
+        if (!slot->link || (victim->link && slot->last_use < victim->last_use)) victim = slot;
+    }
+
+    if (victim->link) i2c_cmd_link_delete(victim->link);
+
+    victim->address = address;
+    victim->len = len;
+    victim->link = i2c_cmd_link_create();
+    link_allocs++;
+    if (!victim->link) return NULL;
+
+    i2c_master_start(victim->link);
+    i2c_master_write_byte(victim->link, address << 1 | WRITE_BIT, ACK_CHECK_EN);
+    i2c_master_write(victim->link, staging, len, ACK_CHECK_EN);
+    i2c_master_stop(victim->link);
+
+    return victim;
+}
+
+static esp_err_t ssd1306_i2c_write(void* ctx, i2c_port_t i2c_num, uint8_t address, const uint8_t* prefix, size_t prefix_len, const uint8_t* data, size_t data_len)
+{
+    (void)ctx;
+    // Too long for the staging buffer: build a one-off link like before
+    if (prefix_len + data_len > SSD1306_I2C_STAGING || !prefix_len || !link_lock) {
+        i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create();
+        link_allocs++;
+
+        i2c_master_start(cmd_handle);
+        i2c_master_write_byte(cmd_handle, address << 1 | WRITE_BIT, ACK_CHECK_EN);
+        i2c_master_write(cmd_handle, (uint8_t*)prefix, prefix_len, ACK_CHECK_EN);
+        if (data_len) i2c_master_write(cmd_handle, (uint8_t*)data, data_len, ACK_CHECK_EN);
+        i2c_master_stop(cmd_handle);
+        esp_err_t err = i2c_master_cmd_begin(i2c_num, cmd_handle, SSD1306_I2C_TIMEOUT);
+        i2c_cmd_link_delete(cmd_handle);
+
+        return err;
+    }
+
+    xSemaphoreTake(link_lock, portMAX_DELAY);
+
+    esp_err_t err = ESP_ERR_NO_MEM;
+    ssd1306_i2c_link_t* slot = ssd1306_i2c_get_link(address, prefix_len + data_len);
+    if (slot) {
+        memcpy(staging, prefix, prefix_len);
+        if (data_len) memcpy(staging + prefix_len, data, data_len);
+        slot->last_use = ++link_clock;
+        err = i2c_master_cmd_begin(i2c_num, slot->link, SSD1306_I2C_TIMEOUT);
+    }
+
+    xSemaphoreGive(link_lock);
+    return err;
+}
+
+uint32_t ssd1306_i2c_get_alloc_count(void)
+{
+    return link_allocs;
+}
+
+const ssd1306_transport_t ssd1306_i2c_transport = {
+    .init = ssd1306_i2c_bus_init,
+    .write = ssd1306_i2c_write,
+    .ctx = NULL
+};
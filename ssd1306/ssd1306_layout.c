@@ -0,0 +1,178 @@
+/**
+ * @file ssd1306_layout.c
+ * @author Abdulaziz Alrashidi
+ * @brief Measured text layouts for the SSD1306 driver: word wrap, alignment and ellipsis.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ *
+ * @details
+ * ssd1306_layout_init() does all the measuring: it breaks the string into lines, trims the spaces
+ * at the breaks, fits the ellipsis and aligns each line. What remains for drawing is one advance
+ * lookup per character, so a layout kept across frames costs no more than drawing the glyphs.
+ */
+
+#include "ssd1306.h"
+#include "ssd1306_layout.h"
+
+#define SSD1306_ELLIPSIS_DOTS   3
+
+static uint16_t ssd1306_layout_measure(const ssd1306_font_t* font, const char* str, uint16_t len)
+{
+    uint16_t width = 0;
+    while (len--) {
+        width += ssd1306_font_char_width(font, *str++);
+    }
+    return width;
+}
+
+// Shortens a line until "..." fits behind it; a box narrower than "..." keeps the line cut without one
+static void ssd1306_layout_add_ellipsis(ssd1306_layout_t* layout, ssd1306_layout_line_t* line)
+{
+    const char* str = layout->str + line->start;
+    uint16_t dots = SSD1306_ELLIPSIS_DOTS * ssd1306_font_char_width(layout->font, '.');
+
+    if (dots > layout->width) return;
+    while (line->len && (line->width + dots > layout->width || str[line->len - 1] == ' ')) {
+        line->width -= ssd1306_font_char_width(layout->font, str[--line->len]);
+    }
+    line->ellipsis = true;
+    line->width += dots;
+}
+
+void ssd1306_layout_init(ssd1306_layout_t* layout, const char* str, const ssd1306_font_t* font, int x, int y, uint8_t w, uint8_t h, ssd1306_align_t align, uint8_t flags)
+{
+    uint8_t max_lines = font->height ? h / font->height : 0;
+    if (max_lines > SSD1306_LAYOUT_MAX_LINES) max_lines = SSD1306_LAYOUT_MAX_LINES;
+
+    layout->str = str;
+    layout->font = font;
+    layout->x = x;
+    layout->y = y;
+    layout->width = w;
+    layout->line_count = 0;
+    layout->truncated = false;
+
+    uint16_t pos = 0;
+    while (str[pos]) {
+        if (layout->line_count == max_lines) {
+            layout->truncated = true;
+            break;
+        }
+
+        uint16_t start = pos;
+        uint16_t end;
+        uint16_t width = 0;
+        int32_t space = -1;         // last space on the line, where it can be broken
+        bool cut = false;
+
+        while (str[pos] && str[pos] != '\n') {
+            uint8_t advance = ssd1306_font_char_width(font, str[pos]);
+            if (str[pos] == ' ' && pos > start) space = pos;
+            if (width + advance > w) break;
+            width += advance;
+            pos++;
+        }
+        end = pos;
+
+        if (str[pos] && str[pos] != '\n') {
+            if (!(flags & SSD1306_LAYOUT_WRAP)) {
+                // The rest of the line does not fit
+                cut = true;
+                while (str[pos] && str[pos] != '\n') pos++;
+            } else if (space >= 0) {
+                end = space;
+                pos = space + 1;
+            } else if (pos == start) {
+                // A glyph wider than the box still gets a line of its own
+                end = ++pos;
+            }
+            if (flags & SSD1306_LAYOUT_WRAP) {
+                while (str[pos] == ' ') pos++;
+            }
+        }
+        if (str[pos] == '\n') pos++;
+
+        while (end > start && str[end - 1] == ' ') end--;
+        if (end - start > UINT8_MAX) end = start + UINT8_MAX;
+
+        ssd1306_layout_line_t* line = &layout->lines[layout->line_count++];
+        line->start = start;
+        line->len = end - start;
+        line->ellipsis = false;
+        line->width = ssd1306_layout_measure(font, str + start, line->len);
+
+        if (cut) {
+            layout->truncated = true;
+            if (flags & SSD1306_LAYOUT_ELLIPSIS) ssd1306_layout_add_ellipsis(layout, line);
+        }
+    }
+
+    if (layout->truncated && layout->line_count && (flags & SSD1306_LAYOUT_ELLIPSIS)) {
+        ssd1306_layout_line_t* last = &layout->lines[layout->line_count - 1];
+        if (!last->ellipsis) ssd1306_layout_add_ellipsis(layout, last);
+    }
+
+    for (uint8_t i = 0; i < layout->line_count; i++) {
+        ssd1306_layout_line_t* line = &layout->lines[i];
+        int slack = w - line->width;
+
+        line->x = x;
+        if (align == SSD1306_ALIGN_CENTER) line->x += slack / 2;
+        if (align == SSD1306_ALIGN_RIGHT) line->x += slack;
+    }
+}
+
+void ssd1306_layout_draw_range(const ssd1306_layout_t* layout, ssd1306_t* dev, uint16_t first, uint16_t count, ssd1306_draw_mode_t color)
+{
+    const ssd1306_font_t* font = layout->font;
+    uint32_t last = (uint32_t)first + count;
+
+    for (uint8_t i = 0; i < layout->line_count; i++) {
+        const ssd1306_layout_line_t* line = &layout->lines[i];
+        uint16_t end = line->start + line->len;
+
+        if (line->start >= last) break;
+        if (end + line->ellipsis <= first) continue;
+
+        int pen = line->x;
+        int top = layout->y + i * font->height;
+        for (uint16_t index = line->start; index < end && index < last; index++) {
+            char c = layout->str[index];
+            pen += index >= first ? ssd1306_dev_draw_char_font(dev, pen, top, font, c, color) : ssd1306_font_char_width(font, c);
+        }
+
+        if (line->ellipsis && end >= first && end < last) {
+            for (uint8_t dot = 0; dot < SSD1306_ELLIPSIS_DOTS; dot++) {
+                pen += ssd1306_dev_draw_char_font(dev, pen, top, font, '.', color);
+            }
+        }
+    }
+}
+
+void ssd1306_layout_draw(const ssd1306_layout_t* layout, ssd1306_t* dev, ssd1306_draw_mode_t color)
+{
+    ssd1306_layout_draw_range(layout, dev, 0, ssd1306_layout_end(layout), color);
+}
+
+uint16_t ssd1306_layout_end(const ssd1306_layout_t* layout)
+{
+    if (!layout->line_count) return 0;
+
+    const ssd1306_layout_line_t* line = &layout->lines[layout->line_count - 1];
+    return line->start + line->len + line->ellipsis;
+}
+
+bool ssd1306_layout_char_pos(const ssd1306_layout_t* layout, uint16_t index, int* x, int* y)
+{
+    for (uint8_t i = 0; i < layout->line_count; i++) {
+        const ssd1306_layout_line_t* line = &layout->lines[i];
+        if (index < line->start || index >= line->start + line->len) continue;
+
+        *x = line->x + ssd1306_layout_measure(layout->font, layout->str + line->start, index - line->start);
+        *y = layout->y + i * layout->font->height;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file ssd1306_pacer.c
+ * @author Abdulaziz Alrashidi
+ * @brief Frame pacing for the SSD1306 driver: a fixed frame rate, one flush per frame, frame statistics.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ *
+ * @details
+ * Frame slots are kept on a grid of esp_timer_get_time() microseconds, next_frame_us advancing by
+ * exactly one period per slot. Sleeping in whole ticks only delays a frame within its slot; the
+ * slot after it is still computed from the grid, so the rate does not drift as it would with a
+ * vTaskDelay() of the period after every frame.
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+#include "ssd1306.h"
+#include "ssd1306_pacer.h"
+
+#define SSD1306_US_PER_TICK     (portTICK_PERIOD_MS * 1000)
+
+static bool ssd1306_pacer_dirty(const ssd1306_t* dev)
+{
+    for (uint8_t page = 0; page < dev->pages; page++) {
+        if (dev->dirty_end[page]) return true;
+    }
+    return false;
+}
+
+static void ssd1306_pacer_record(uint32_t us, uint32_t* last, uint32_t* max, uint64_t* total)
+{
+    *last = us;
+    if (us > *max) *max = us;
+    *total += us;
+}
+
+void ssd1306_pacer_init(ssd1306_pacer_t* pacer, ssd1306_t* dev, uint16_t fps, ssd1306_render_cb_t render, void* arg)
+{
+    pacer->dev = dev;
+    pacer->render = render;
+    pacer->arg = arg;
+    pacer->period_us = 1000000 / (fps ? fps : 1);
+    pacer->next_frame_us = esp_timer_get_time();
+    pacer->invalid = true;
+    ssd1306_pacer_stats_reset(pacer);
+}
+
+void ssd1306_pacer_set_fps(ssd1306_pacer_t* pacer, uint16_t fps)
+{
+    uint32_t period_us = 1000000 / (fps ? fps : 1);
+    pacer->next_frame_us += (int64_t)period_us - pacer->period_us;
+    pacer->period_us = period_us;
+}
+
+void ssd1306_pacer_invalidate(ssd1306_pacer_t* pacer)
+{
+    pacer->invalid = true;
+}
+
+uint32_t ssd1306_pacer_tick(ssd1306_pacer_t* pacer)
+{
+    ssd1306_pacer_stats_t* stats = &pacer->stats;
+    int64_t now = esp_timer_get_time();
+    if (now < pacer->next_frame_us) return pacer->next_frame_us - now;
+
+    // Slots that passed entirely are dropped, not caught up on
+    int64_t behind = (now - pacer->next_frame_us) / pacer->period_us;
+    stats->missed_frames += behind;
+    pacer->next_frame_us += (behind + 1) * pacer->period_us;
+
+    if (pacer->invalid && pacer->render) {
+        pacer->invalid = false;
+        pacer->render(pacer->dev, pacer->arg);
+    }
+
+    if (ssd1306_pacer_dirty(pacer->dev)) {
+        int64_t flush_start = esp_timer_get_time();
+        if (pacer->dev->back_buffer)
+            ssd1306_dev_display_async(pacer->dev);
+        else
+            ssd1306_dev_display(pacer->dev);
+
+        int64_t end = esp_timer_get_time();
+        stats->frames++;
+        ssd1306_pacer_record(end - flush_start, &stats->flush_us_last, &stats->flush_us_max, &stats->flush_us_total);
+        ssd1306_pacer_record(end - now, &stats->frame_us_last, &stats->frame_us_max, &stats->frame_us_total);
+    } else {
+        stats->idle_frames++;
+    }
+
+    now = esp_timer_get_time();
+    return pacer->next_frame_us > now ? pacer->next_frame_us - now : 0;
+}
+
+void ssd1306_pacer_run(ssd1306_pacer_t* pacer, uint32_t frames)
+{
+    uint32_t first = pacer->stats.frames;
+
+    for (;;) {
+        uint32_t wait_us = ssd1306_pacer_tick(pacer);
+        if (frames && pacer->stats.frames - first >= frames) return;
+
+        // Rounded up: waking early would only spin until the slot starts
+        TickType_t ticks = (wait_us + SSD1306_US_PER_TICK - 1) / SSD1306_US_PER_TICK;
+        if (ticks) vTaskDelay(ticks);
+    }
+}
+
+void ssd1306_pacer_stats_get(const ssd1306_pacer_t* pacer, ssd1306_pacer_stats_t* out)
+{
+    *out = pacer->stats;
+    if (out->frames) {
+        out->frame_us_avg = out->frame_us_total / out->frames;
+        out->flush_us_avg = out->flush_us_total / out->frames;
+    }
+}
+
+void ssd1306_pacer_stats_reset(ssd1306_pacer_t* pacer)
+{
+    memset(&pacer->stats, 0, sizeof(pacer->stats));
+}
@@ -0,0 +1,211 @@
+/**
+ * @file ssd1306_queue.c
+ * @author Abdulaziz Alrashidi
+ * @brief Draw command queue for the SSD1306 driver: any task posts, one render task draws and flushes.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ *
+ * @details
+ * Producers only copy a fixed-size command into a FreeRTOS queue with a zero timeout, which takes a
+ * bounded time and never waits for the render task or the bus. The framebuffer and the bus belong
+ * to the render task alone, so drawing needs no lock: it takes a batch of commands, draws them and
+ * flushes once, and the commands that arrive during that flush form the next batch.
+ */
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#include "ssd1306.h"
+#include "ssd1306_queue.h"
+
+#define SSD1306_QUEUE_TASK_STACK    3072    // stack depth of the render task
+
+// Marks the part of the region that is on the panel dirty
+static void ssd1306_queue_invalidate_region(ssd1306_t* dev, int x, int y, uint8_t w, uint8_t h)
+{
+    int x_end = x + w;
+    int y_end = y + h;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x >= x_end || y >= y_end || x >= dev->width || y >= dev->height) return;
+
+    ssd1306_dev_mark_dirty(dev, x, y, x_end - x, y_end - y);
+}
+
+static void ssd1306_queue_exec(ssd1306_t* dev, const ssd1306_draw_cmd_t* cmd)
+{
+    ssd1306_draw_mode_t color = cmd->color;
+
+    // Text and rectangles are drawn at the origin of a viewport at (x, y), so that the uint8_t
+    // primitives clip what lies left of or above the panel instead of wrapping around
+    if (cmd->op == SSD1306_OP_TEXT || cmd->op == SSD1306_OP_RECT) {
+        if (ssd1306_dev_push_viewport(dev, cmd->x, cmd->y, dev->width - cmd->x, dev->height - cmd->y) != ESP_OK) return;
+    }
+
+    switch (cmd->op) {
+    case SSD1306_OP_TEXT: {
+        const ssd1306_font_t* font = cmd->data.text.font;
+        if (cmd->w) {
+            uint8_t h = cmd->h ? cmd->h : (font ? font->height : 8 * cmd->size_y);
+            ssd1306_dev_draw_full_rect(dev, 0, 0, cmd->w, h, COLOR_BLACK);
+        }
+        if (font)
+            ssd1306_dev_draw_string_font(dev, 0, 0, font, cmd->data.text.str, color);
+        else
+            ssd1306_dev_draw_string(dev, 0, 0, cmd->data.text.str, cmd->size_x, cmd->size_y, color);
+        ssd1306_dev_pop_clip(dev);
+        break;
+    }
+    case SSD1306_OP_RECT:
+        ssd1306_dev_draw_full_rect(dev, 0, 0, cmd->w, cmd->h, color);
+        ssd1306_dev_pop_clip(dev);
+        break;
+    case SSD1306_OP_BITMAP:
+        ssd1306_dev_draw_bitmap(dev, cmd->x, cmd->y, cmd->data.bitmap, cmd->w, cmd->h, color);
+        break;
+    case SSD1306_OP_INVALIDATE:
+        ssd1306_queue_invalidate_region(dev, cmd->x, cmd->y, cmd->w, cmd->h);
+        break;
+    case SSD1306_OP_CALL:
+        cmd->data.call.fn(dev, cmd->data.call.arg);
+        break;
+    }
+}
+
+static void ssd1306_queue_task(void* arg)
+{
+    ssd1306_queue_t* queue = arg;
+    ssd1306_draw_cmd_t cmd;
+
+    for (;;) {
+        xQueueReceive(queue->commands, &cmd, portMAX_DELAY);
+
+        // Draw what is queued, at most one queue's worth so the flush is never put off for long
+        uint16_t count = 0;
+        do {
+            ssd1306_queue_exec(queue->dev, &cmd);
+            count++;
+        } while (count < queue->depth && xQueueReceive(queue->commands, &cmd, 0) == pdTRUE);
+
+        if (queue->dev->back_buffer)
+            ssd1306_dev_display_async(queue->dev);
+        else
+            ssd1306_dev_display(queue->dev);
+
+        queue->drawn += count;
+        queue->batches++;
+    }
+}
+
+esp_err_t ssd1306_queue_start(ssd1306_queue_t* queue, ssd1306_t* dev, uint16_t depth, UBaseType_t priority)
+{
+    if (!depth) return ESP_ERR_INVALID_ARG;
+
+    queue->dev = dev;
+    queue->depth = depth;
+    queue->dropped = 0;
+    queue->batches = 0;
+    queue->drawn = 0;
+    queue->commands = xQueueCreate(depth, sizeof(ssd1306_draw_cmd_t));
+    if (!queue->commands) return ESP_ERR_NO_MEM;
+
+    if (xTaskCreate(ssd1306_queue_task, "ssd1306_render", SSD1306_QUEUE_TASK_STACK, queue, priority, NULL) != pdPASS) {
+        vQueueDelete(queue->commands);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_queue_post(ssd1306_queue_t* queue, const ssd1306_draw_cmd_t* cmd)
+{
+    if (xQueueSend(queue->commands, cmd, 0) != pdTRUE) {
+        portENTER_CRITICAL();
+        queue->dropped++;
+        portEXIT_CRITICAL();
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t ssd1306_queue_post_from_isr(ssd1306_queue_t* queue, const ssd1306_draw_cmd_t* cmd, BaseType_t* higher_priority_task_woken)
+{
+    if (xQueueSendFromISR(queue->commands, cmd, higher_priority_task_woken) != pdTRUE) {
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        queue->dropped++;
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+static void ssd1306_queue_cmd_init(ssd1306_draw_cmd_t* cmd, ssd1306_op_t op, int x, int y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    cmd->op = op;
+    cmd->color = color;
+    cmd->size_x = 1;
+    cmd->size_y = 1;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->w = w;
+    cmd->h = h;
+}
+
+static void ssd1306_queue_copy_text(ssd1306_draw_cmd_t* cmd, const ssd1306_font_t* font, const char* str)
+{
+    cmd->data.text.font = font;
+    strncpy(cmd->data.text.str, str, SSD1306_QUEUE_TEXT_LEN - 1);
+    cmd->data.text.str[SSD1306_QUEUE_TEXT_LEN - 1] = '\0';
+}
+
+esp_err_t ssd1306_queue_text(ssd1306_queue_t* queue, int x, int y, const char* str, uint8_t size_x, uint8_t size_y, uint8_t clear_w, ssd1306_draw_mode_t color)
+{
+    ssd1306_draw_cmd_t cmd;
+    ssd1306_queue_cmd_init(&cmd, SSD1306_OP_TEXT, x, y, clear_w, 0, color);
+    cmd.size_x = size_x;
+    cmd.size_y = size_y;
+    ssd1306_queue_copy_text(&cmd, NULL, str);
+    return ssd1306_queue_post(queue, &cmd);
+}
+
+esp_err_t ssd1306_queue_text_font(ssd1306_queue_t* queue, int x, int y, const ssd1306_font_t* font, const char* str, uint8_t clear_w, ssd1306_draw_mode_t color)
+{
+    ssd1306_draw_cmd_t cmd;
+    ssd1306_queue_cmd_init(&cmd, SSD1306_OP_TEXT, x, y, clear_w, 0, color);
+    ssd1306_queue_copy_text(&cmd, font, str);
+    return ssd1306_queue_post(queue, &cmd);
+}
+
+esp_err_t ssd1306_queue_rect(ssd1306_queue_t* queue, int x, int y, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    ssd1306_draw_cmd_t cmd;
+    ssd1306_queue_cmd_init(&cmd, SSD1306_OP_RECT, x, y, w, h, color);
+    return ssd1306_queue_post(queue, &cmd);
+}
+
+esp_err_t ssd1306_queue_bitmap(ssd1306_queue_t* queue, int x, int y, const uint8_t* bitmap, uint8_t w, uint8_t h, ssd1306_draw_mode_t color)
+{
+    ssd1306_draw_cmd_t cmd;
+    ssd1306_queue_cmd_init(&cmd, SSD1306_OP_BITMAP, x, y, w, h, color);
+    cmd.data.bitmap = bitmap;
+    return ssd1306_queue_post(queue, &cmd);
+}
+
+esp_err_t ssd1306_queue_invalidate(ssd1306_queue_t* queue, int x, int y, uint8_t w, uint8_t h)
+{
+    ssd1306_draw_cmd_t cmd;
+    ssd1306_queue_cmd_init(&cmd, SSD1306_OP_INVALIDATE, x, y, w, h, COLOR_WHITE);
+    return ssd1306_queue_post(queue, &cmd);
+}
+
+esp_err_t ssd1306_queue_call(ssd1306_queue_t* queue, void (*fn)(ssd1306_t* dev, void* arg), void* arg)
+{
+    ssd1306_draw_cmd_t cmd;
+    ssd1306_queue_cmd_init(&cmd, SSD1306_OP_CALL, 0, 0, 0, 0, COLOR_WHITE);
+    cmd.data.call.fn = fn;
+    cmd.data.call.arg = arg;
+    return ssd1306_queue_post(queue, &cmd);
+}
@@ -0,0 +1,241 @@
+/**
+ * @file ssd1306_sprite.c
+ * @author Abdulaziz Alrashidi
+ * @brief Sprite compositor for the SSD1306 driver: masked 1bpp sprites over a static background.
+ * @version 0.1
+ * @date 2025-08-02
+ * @copyright Copyright (c) 2025
+ * @license MIT
+ *
+ * @details
+ * The compositor keeps a damage span per page, like the framebuffer's dirty spans. Changing a sprite
+ * only flags it; ssd1306_compositor_render() turns each flagged sprite into damage (the box it was
+ * drawn in and the box it is in now), then rebuilds every damaged span in a row buffer: the
+ * background bytes, then each sprite as a shifted byte mask and OR. Bytes are written back only if
+ * they differ, so a sprite moving over unchanged pixels flushes only the columns that really changed.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "ssd1306_sprite.h"
+
+// Adds the screen area [x, x + w) × [y, y + h), cut to the panel, to the damage
+static void ssd1306_compositor_damage(ssd1306_compositor_t* comp, int x, int y, int w, int h)
+{
+    ssd1306_t* dev = comp->dev;
+    int x_end = x + w - 1;
+    int y_end = y + h - 1;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x_end >= dev->width) x_end = dev->width - 1;
+    if (y_end >= dev->height) y_end = dev->height - 1;
+    if (x > x_end || y > y_end) return;
+
+    for (int page = y / 8; page <= y_end / 8; page++) {
+        int top = page == y / 8 ? y % 8 : 0;
+        int bottom = page == y_end / 8 ? y_end % 8 : 7;
+        comp->damage_rows[page] |= (uint8_t)(0xFF << top) & (0xFF >> (7 - bottom));
+
+        if (!comp->damage_end[page]) {
+            comp->damage_start[page] = x;
+            comp->damage_end[page] = x_end + 1;
+        } else {
+            if (x < comp->damage_start[page]) comp->damage_start[page] = x;
+            if (x_end + 1 > comp->damage_end[page]) comp->damage_end[page] = x_end + 1;
+        }
+    }
+}
+
+// Rows of source page k inside a sprite of height h
+static inline uint8_t ssd1306_sprite_rows(uint8_t h, int k)
+{
+    int rows_left = h - 8 * k;
+    return rows_left >= 8 ? 0xFF : (1 << rows_left) - 1;
+}
+
+// Draws the part of a sprite that falls on a page into row, columns [x_start, x_end]. Unless the
+// sprite is byte aligned, a page holds the bottom of source page k - 1 and the top of source page k:
+// both are read as one 16-bit word and shifted into place.
+static void ssd1306_sprite_compose(const ssd1306_sprite_t* sprite, int page, uint8_t* row, int x_start, int x_end)
+{
+    int top_page = sprite->y >= 0 ? sprite->y / 8 : (sprite->y - 7) / 8;
+    int shift = sprite->y - 8 * top_page;
+    int src_pages = (sprite->h + 7) / 8;
+    int k = page - top_page;
+    if (k < 0 || k > src_pages || (k == src_pages && !shift)) return;
+
+    if (x_start < sprite->x) x_start = sprite->x;
+    if (x_end > sprite->x + sprite->w - 1) x_end = sprite->x + sprite->w - 1;
+    if (x_start > x_end) return;
+
+    uint8_t cur_rows = k < src_pages ? ssd1306_sprite_rows(sprite->h, k) : 0;
+    uint8_t prev_rows = shift && k > 0 ? ssd1306_sprite_rows(sprite->h, k - 1) : 0;
+    const uint8_t* mask = sprite->mask ? sprite->mask : sprite->bitmap;
+
+    for (int cx = x_start; cx <= x_end; cx++) {
+        int i = cx - sprite->x;
+        uint16_t bits = 0;
+        uint16_t opaque = 0;
+        if (cur_rows) {
+            bits = sprite->bitmap[k * sprite->w + i] << 8;
+            opaque = (mask[k * sprite->w + i] & cur_rows) << 8;
+        }
+        if (prev_rows) {
+            bits |= sprite->bitmap[(k - 1) * sprite->w + i];
+            opaque |= mask[(k - 1) * sprite->w + i] & prev_rows;
+        }
+
+        uint8_t m = opaque >> (8 - shift);
+        row[cx] = (row[cx] & ~m) | ((bits >> (8 - shift)) & m);
+    }
+}
+
+// Rebuilds the damaged span of a page and writes back the bytes that changed
+static void ssd1306_compositor_page(ssd1306_compositor_t* comp, int page)
+{
+    ssd1306_t* dev = comp->dev;
+    uint8_t row[SSD1306_MAX_WIDTH];
+    uint8_t* fb = &dev->buffer[page * dev->width];
+    uint8_t rows = comp->damage_rows[page];
+    int x_start = comp->damage_start[page];
+    int x_end = comp->damage_end[page] - 1;
+
+    if (comp->background)
+        memcpy(&row[x_start], &comp->background[page * dev->width + x_start], x_end - x_start + 1);
+    else
+        memset(&row[x_start], 0x00, x_end - x_start + 1);
+
+    for (const ssd1306_sprite_t* sprite = comp->sprites; sprite; sprite = sprite->next) {
+        if (sprite->visible) ssd1306_sprite_compose(sprite, page, row, x_start, x_end);
+    }
+
+    int first = -1;
+    int last = -1;
+    for (int x = x_start; x <= x_end; x++) {
+        uint8_t value = (fb[x] & ~rows) | (row[x] & rows);
+        if (value == fb[x]) continue;
+        fb[x] = value;
+        if (first < 0) first = x;
+        last = x;
+    }
+    if (first >= 0) ssd1306_dev_mark_dirty(dev, first, 8 * page, last - first + 1, 8);
+
+    uint8_t row_count = 0;
+    for (uint8_t bits = rows; bits; bits &= bits - 1) row_count++;
+    ssd1306_stats_add_pixels((uint32_t)row_count * (x_end - x_start + 1));
+
+    comp->damage_end[page] = 0;
+    comp->damage_rows[page] = 0;
+}
+
+void ssd1306_compositor_init(ssd1306_compositor_t* comp, ssd1306_t* dev, const uint8_t* background)
+{
+    comp->dev = dev;
+    comp->sprites = NULL;
+    memset(comp->damage_end, 0, sizeof(comp->damage_end));
+    memset(comp->damage_rows, 0, sizeof(comp->damage_rows));
+    ssd1306_compositor_set_background(comp, background);
+}
+
+void ssd1306_compositor_set_background(ssd1306_compositor_t* comp, const uint8_t* background)
+{
+    comp->background = background;
+    ssd1306_compositor_damage(comp, 0, 0, comp->dev->width, comp->dev->height);
+}
+
+void ssd1306_compositor_invalidate(ssd1306_compositor_t* comp, int x, int y, int w, int h)
+{
+    ssd1306_compositor_damage(comp, x, y, w, h);
+}
+
+void ssd1306_compositor_render(ssd1306_compositor_t* comp)
+{
+    ssd1306_t* dev = comp->dev;
+
+    // A changed sprite damages the box it was drawn in and the one it is in now
+    for (ssd1306_sprite_t* sprite = comp->sprites; sprite; sprite = sprite->next) {
+        if (!sprite->dirty) continue;
+        if (sprite->drawn) ssd1306_compositor_damage(comp, sprite->drawn_x, sprite->drawn_y, sprite->w, sprite->h);
+        if (sprite->visible) ssd1306_compositor_damage(comp, sprite->x, sprite->y, sprite->w, sprite->h);
+    }
+
+    for (uint8_t page = 0; page < dev->pages; page++) {
+        if (comp->damage_end[page]) ssd1306_compositor_page(comp, page);
+    }
+
+    for (ssd1306_sprite_t* sprite = comp->sprites; sprite; sprite = sprite->next) {
+        sprite->drawn = sprite->visible;
+        sprite->drawn_x = sprite->x;
+        sprite->drawn_y = sprite->y;
+        sprite->dirty = false;
+    }
+}
+
+void ssd1306_sprite_init(ssd1306_sprite_t* sprite, const uint8_t* bitmap, const uint8_t* mask, uint8_t w, uint8_t h, int x, int y)
+{
+    sprite->next = NULL;
+    sprite->comp = NULL;
+    sprite->bitmap = bitmap;
+    sprite->mask = mask;
+    sprite->w = w;
+    sprite->h = h;
+    sprite->x = x;
+    sprite->y = y;
+    sprite->visible = true;
+    sprite->dirty = true;
+    sprite->drawn = false;
+}
+
+void ssd1306_compositor_add(ssd1306_compositor_t* comp, ssd1306_sprite_t* sprite)
+{
+    ssd1306_sprite_t** link = &comp->sprites;
+    while (*link) link = &(*link)->next;
+
+    *link = sprite;
+    sprite->next = NULL;
+    sprite->comp = comp;
+    sprite->dirty = true;
+    sprite->drawn = false;
+}
+
+void ssd1306_compositor_remove(ssd1306_sprite_t* sprite)
+{
+    ssd1306_compositor_t* comp = sprite->comp;
+    if (!comp) return;
+
+    for (ssd1306_sprite_t** link = &comp->sprites; *link; link = &(*link)->next) {
+        if (*link == sprite) {
+            *link = sprite->next;
+            break;
+        }
+    }
+    if (sprite->drawn) ssd1306_compositor_damage(comp, sprite->drawn_x, sprite->drawn_y, sprite->w, sprite->h);
+
+    sprite->next = NULL;
+    sprite->comp = NULL;
+    sprite->drawn = false;
+}
+
+void ssd1306_sprite_move(ssd1306_sprite_t* sprite, int x, int y)
+{
+    if (sprite->x == x && sprite->y == y) return;
+    sprite->x = x;
+    sprite->y = y;
+    sprite->dirty = true;
+}
+
+void ssd1306_sprite_set_visible(ssd1306_sprite_t* sprite, bool visible)
+{
+    if (sprite->visible == visible) return;
+    sprite->visible = visible;
+    sprite->dirty = true;
+}
+
+void ssd1306_sprite_set_bitmap(ssd1306_sprite_t* sprite, const uint8_t* bitmap, const uint8_t* mask)
+{
+    sprite->bitmap = bitmap;
+    sprite->mask = mask;
+    sprite->dirty = true;
+}